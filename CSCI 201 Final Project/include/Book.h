@@ -1,6 +1,6 @@
 /* Program name: Book.h
 * Author: Joshua Yin
-* Date last updated: 7/24/2024
+* Date last updated: 10/17/2026
 * Purpose: Define the book class
 */
 
@@ -11,6 +11,10 @@
 #include <map>
 #include <string>
 
+#include "EpochDay.h"
+#include "Isbn.h"
+#include "TextPool.h"
+
 using namespace std;
 
 // Enums for genres
@@ -29,39 +33,49 @@ enum genreType {
 // Declare map for enum values and their string representations
 extern map<genreType, string> genreNames; // Use extern because it's a global map
 
+// Text fields point into a TextPool (the library's own): authors are interned (many books share
+// them) and the rest live in its arena. A book must not outlive the pool its text is in. Copying a book copies pointers, not strings. The due date is an epoch day.
 class Book {
 private:
-    string title;
-    string author;
-    string ISBN;
+    const char* title;
+    const char* author;
+    Isbn ISBN;
     int pubDate;
-    string callNum;
+    const char* callNum;
     genreType genre;
     bool isBorrowed;
-    string dueDate;
+    int32_t dueDay;
+
+    Book(const char* title, const char* author, const Isbn &ISBN, int pubDate, const char* callNum,
+         genreType genre, bool isBorrowed, int32_t dueDay);
 
 public:
-    Book(string title, string author, string ISBN, int pubDate, string callNum, genreType genre);
+    Book(TextPool &text, string title, string author, const Isbn &ISBN, int pubDate, string callNum, genreType genre);
+
+    // Build a book around text that already lives in a pool (no copies, used by the loaders)
+    static Book fromPooledText(const char* title, const char* author, const Isbn &ISBN, int pubDate,
+                               const char* callNum, genreType genre, bool isBorrowed, int32_t dueDay);
 
     // Getters
-    string getTitle() const;
-    string getAuthor() const;
-    string getISBN() const;
+    const char* getTitle() const;
+    const char* getAuthor() const;
+    const Isbn& getISBN() const;
     int getPubDate() const;
-    string getCallNum() const;
+    const char* getCallNum() const;
     genreType getGenre() const;
     bool getIsBorrowed() const;
-    string getDueDate() const;
+    int32_t getDueDay() const;   // NO_DUE_DATE when there is none
+    string getDueDate() const;   // YYYY-MM-DD, or "None"
 
     // Setters
-    void setTitle(const string &title);
-    void setAuthor(const string &author);
-    void setISBN(const string &ISBN);
+    void setTitle(TextPool &text, const string &title);
+    void setAuthor(TextPool &text, const string &author);
+    void setISBN(const Isbn &ISBN);
     void setPubDate(const int &pubDate);
-    void setCallNum(const string &callNum);
+    void setCallNum(TextPool &text, const string &callNum);
     void setGenre(genreType genre);
     void setIsBorrowed(bool isBorrowed);
-    void setDueDate(const string &dueDate);
+    void setDueDay(int32_t dueDay);
 
     // Display book details
     void display() const;
@@ -0,0 +1,135 @@
+/* Program name: BookStore.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the book store class (slot map of books addressed by stable handles)
+*/
+
+#ifndef BOOKSTORE_H
+#define BOOKSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Book.h"
+
+using namespace std;
+
+// Handle to a book in a BookStore. The generation changes every time a slot is
+// freed, so a handle to a deleted book never resolves to the book that reuses its slot.
+struct BookHandle {
+    uint32_t index;
+    uint32_t generation;
+
+    BookHandle() : index(UINT32_MAX), generation(0) {} // Null handle
+    BookHandle(uint32_t index, uint32_t generation) : index(index), generation(generation) {}
+
+    bool isNull() const { return index == UINT32_MAX; }
+    bool operator==(const BookHandle &other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const BookHandle &other) const { return !(*this == other); }
+};
+
+// Books are stored as records (the text fields) plus dense per-slot columns of the
+// fields that scans filter on, so filters and counts never touch the strings.
+// All writes go through the store so the two stay in sync.
+class BookStore {
+private:
+    vector<Book> slots;           // Text and full records; freed slots keep an empty book until they are reused
+    vector<uint32_t> generations;
+    vector<uint32_t> freeSlots;
+    size_t count;
+
+    // Columns (indexed by slot)
+    vector<uint8_t> genres;       // genreType of each slot
+    vector<int32_t> pubDates;     // Publication date of each slot
+    vector<uint64_t> occupied;    // Bit set: slot holds a book
+    vector<uint64_t> available;   // Bit set: slot holds a book that is not borrowed
+
+    // Due date index: borrowed books are linked through the slots into one list per due day, and the
+    // days are kept in order, so finding what is due in a range visits only those books (a timer
+    // wheel with one bucket per day). Linking and unlinking never allocate beyond the day's entry.
+    struct DueList {
+        uint32_t first;
+        uint32_t last;
+    };
+    vector<int32_t> dueDays;      // Day each slot is listed under (NO_DUE_DATE if it is not listed)
+    vector<uint32_t> dueNext;     // Next and previous slot due the same day
+    vector<uint32_t> duePrev;
+    map<int32_t, DueList> dueLists;
+
+    static bool testBit(const vector<uint64_t> &bits, uint32_t slot) { return (bits[slot / 64] >> (slot % 64)) & 1; }
+    static void setBit(vector<uint64_t> &bits, uint32_t slot, bool value);
+    void writeColumns(uint32_t slot, const Book &book);
+    void linkDue(uint32_t slot, int32_t dueDay);
+    void unlinkDue(uint32_t slot);
+    uint64_t genreMask(size_t word, genreType genre) const;
+
+public:
+    // Iterator over occupied slots, in slot order (books can only be changed through the store)
+    class const_iterator {
+    private:
+        const BookStore* store;
+        uint32_t slot;
+
+        void skipFree() {
+            while (slot < store->slots.size() && !testBit(store->occupied, slot)) {
+                ++slot;
+            }
+        }
+
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef Book value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const Book* pointer;
+        typedef const Book& reference;
+
+        const_iterator(const BookStore* store, uint32_t slot) : store(store), slot(slot) { skipFree(); }
+
+        const Book& operator*() const { return store->slots[slot]; }
+        const Book* operator->() const { return &store->slots[slot]; }
+        BookHandle handle() const { return BookHandle(slot, store->generations[slot]); }
+
+        const_iterator& operator++() { ++slot; skipFree(); return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+        bool operator==(const const_iterator &other) const { return slot == other.slot; }
+        bool operator!=(const const_iterator &other) const { return slot != other.slot; }
+    };
+    typedef const_iterator iterator;
+
+    BookStore();
+
+    // Insert and erase (both O(1); erasing never moves other books)
+    BookHandle insert(const Book &book);
+    bool erase(BookHandle handle);
+    void clear();
+    void reserve(size_t capacity);
+
+    // Updates
+    bool replace(BookHandle handle, const Book &book);
+    bool setBorrowed(BookHandle handle, bool isBorrowed, int32_t dueDay);
+
+    // Access (get returns nullptr for stale or null handles)
+    bool contains(BookHandle handle) const;
+    const Book* get(BookHandle handle) const;
+    size_t size() const;
+    bool empty() const;
+
+    // Column scans
+    size_t countAvailable() const;
+    size_t countGenre(genreType genre) const;
+    size_t countAvailable(genreType genre) const;
+    vector<BookHandle> findAvailable(genreType genre) const;
+
+    // Borrowed books due from one day through another, earliest first (books due the same day in the
+    // order they were borrowed). Takes time in proportion to the books found, not the store.
+    vector<BookHandle> findDue(int32_t fromDay, int32_t toDay) const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+};
+
+#endif
@@ -0,0 +1,114 @@
+/* Program name: CatalogView.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the catalog view class (a read-only catalog searched in place in a mapped snapshot)
+*/
+
+#ifndef CATALOGVIEW_H
+#define CATALOGVIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "Book.h"
+#include "BookStore.h"
+#include "FilterIndex.h"
+#include "Isbn.h"
+#include "SearchIndex.h"
+#include "Snapshot.h"
+
+using namespace std;
+
+// Read-only catalog for search-only terminals. The books and the catalog index saved with them
+// are read straight from the mapped snapshot, so opening one parses nothing and every process
+// showing the same file shares one copy of it in the page cache. Only books changed by delta
+// segments saved after the last full save are copied into memory (with their own small
+// indexes). Members, loans and the history are never read.
+class CatalogView {
+private:
+    // A book found by a search: a catalog book by number, or a changed book (number is its slot)
+    struct Hit {
+        uint32_t number;
+        const Book* changed;
+        int score;
+    };
+
+    // A word of the catalog index matched by a query word, and how well it matched
+    struct WordMatch {
+        size_t word;
+        int weight;
+    };
+
+    typedef unordered_map<uint32_t, int> CandidateMap; // Book number -> running score
+
+    struct stat opened; // The file as it was when it was opened (see isStale)
+    MappedSnapshot snapshot;
+    string filename;
+
+    // Catalog sections of the full segment
+    const BookRecord* records;
+    size_t recordCount;
+    const CatalogWordRecord* words;
+    size_t wordCount;
+    const uint32_t* postings;
+    size_t postingCount;
+    const CatalogTrigramRecord* trigrams;
+    size_t trigramCount;
+    const uint32_t* trigramWords;
+    size_t trigramWordCount;
+    const uint32_t* isbnOrder;
+    const uint32_t* dateOrder;
+    size_t bookCount; // Catalog books still current, plus the changed books
+
+    // Books changed by later delta segments
+    unordered_set<Isbn> replaced; // ISBNs of catalog books changed or deleted since the full save
+    BookStore changedBooks;
+    unordered_map<Isbn, BookHandle> changedIndex;
+    SearchIndex changedText;
+    FilterIndex changedFilter;
+
+    static struct stat statFile(const string &filename);
+    static bool hitBefore(const Hit &a, const Hit &b);
+
+    void applyDelta(size_t segment);
+    void removeChanged(const Isbn &isbn);
+
+    Book bookAt(uint32_t number) const; // Throws runtime_error if the index points outside the catalog
+    bool isCurrent(uint32_t number) const;
+    const char* wordAt(size_t word) const;
+    pair<size_t, size_t> prefixRange(const string &prefix) const; // Words starting with prefix
+    vector<WordMatch> similarWords(const string &word, int maxDistance, size_t limit) const;
+    void mergeWord(CandidateMap &candidates, const vector<WordMatch> &matches, unsigned char fields, bool firstWord) const;
+    vector<Hit> rank(const CandidateMap &candidates, const vector<SearchResult> &changed, size_t limit) const;
+    vector<Hit> search(const string &query, unsigned char fields, size_t limit) const;
+    vector<Hit> fuzzySearch(const string &query, unsigned char fields, size_t limit) const;
+    vector<string> complete(const string &prefix, size_t limit) const;
+    vector<Hit> findByDate(int fromYear, int toYear, const genreType* genre) const; // Oldest first
+    bool findNumber(const Isbn &isbn, uint32_t &number) const; // Catalog books only
+    bool findBook(const Isbn &isbn, Hit &hit) const;
+    void display(const Hit &hit) const;
+
+public:
+    explicit CatalogView(const string &filename); // Throws runtime_error if the file is not a snapshot with a catalog index
+    CatalogView(const CatalogView&) = delete;
+    CatalogView& operator=(const CatalogView&) = delete;
+
+    // The same displays and searches as the library's (books changed since the full save come last on ties)
+    void displayBooks() const;
+    void displayInventory() const;
+    void displayAvailableBooks(genreType genre) const;
+    void searchBook(const string &query, const string &searchType) const;
+    void searchBookByGenreAndDate(genreType genre, int fromYear, int toYear) const;
+
+    size_t size() const;
+    bool isStale() const; // The file was saved again since it was opened (open it again to see the changes)
+};
+
+#endif
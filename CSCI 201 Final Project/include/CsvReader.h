@@ -0,0 +1,50 @@
+/* Program name: CsvReader.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the CSV reader class (a delimited text file read one record at a time)
+*/
+
+#ifndef CSVREADER_H
+#define CSVREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Reads a delimited file (comma separated by default) through a fixed-size buffer, so any
+// size of file is read in the same small amount of memory. Fields may be quoted ("Smith, J.")
+// with "" standing for a quote; quoted fields may also hold the delimiter or line breaks.
+class CsvReader {
+private:
+    static const size_t BUFFER_SIZE = 1 << 20;
+
+    int fd;
+    char delimiter;
+    vector<char> buffer;
+    size_t pos;           // Next unread byte in buffer
+    size_t end;           // End of the bytes read into buffer
+    size_t line;          // Lines read so far
+    size_t recordLine;    // Line the last record started on
+    uint64_t bytesRead;
+    uint64_t fileSize;
+
+    bool fill(); // Read the next chunk; false at end of file
+
+public:
+    CsvReader(const string &filename, char delimiter = ','); // Throws runtime_error if the file cannot be opened
+    CsvReader(const CsvReader&) = delete;
+    CsvReader& operator=(const CsvReader&) = delete;
+    ~CsvReader();
+
+    // Read the next record's fields; false at the end of the file. Throws runtime_error on a read error.
+    bool next(vector<string> &fields);
+
+    size_t getLineNumber() const; // Line the last record started on (from 1)
+    uint64_t getBytesRead() const; // Bytes of the file used up by the records read so far
+    uint64_t getFileSize() const;
+};
+
+#endif
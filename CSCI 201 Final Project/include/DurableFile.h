@@ -0,0 +1,24 @@
+/* Program name: DurableFile.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Declare the helpers used to write files so a crash never leaves one half written
+*/
+
+#ifndef DURABLEFILE_H
+#define DURABLEFILE_H
+
+#include <string>
+
+using namespace std;
+
+// Saves write the whole file under a temporary name, then replaceFile moves it into place.
+// After a crash the target is either the old file or the new one, never part of either.
+// Each helper throws runtime_error if the system call fails.
+
+string temporaryName(const string &filename);                     // Where a new version is written first
+void syncFile(const string &filename);                            // Wait for a file's data to reach the disk
+void syncDirectory(const string &filename);                       // Same for the directory holding it (renames, deletes)
+void replaceFile(const string &tempName, const string &filename); // Sync, rename over the target, sync the directory
+void removeFile(const string &filename);                          // Delete (if it exists) and sync the directory
+
+#endif
@@ -0,0 +1,36 @@
+/* Program name: EpochDay.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the epoch day functions (calendar dates as day numbers)
+*/
+
+#ifndef EPOCHDAY_H
+#define EPOCHDAY_H
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+
+using namespace std;
+
+// Due dates are kept as the number of days since 1970-01-01, so comparing or subtracting them is
+// plain integer math. Text (YYYY-MM-DD) is only made when a date is shown or saved.
+const int32_t NO_DUE_DATE = INT32_MIN; // Saved and shown as "None"
+
+// Convert between a calendar date and its day number (no time zones involved)
+int32_t epochDayFromDate(int year, int month, int day);
+void dateFromEpochDay(int32_t epochDay, int &year, int &month, int &day);
+
+// Day number of a time, by the local calendar
+int32_t localEpochDay(time_t time);
+int32_t currentEpochDay();
+
+// YYYY-MM-DD text (parseEpochDay is false unless the text is exactly that and a real date)
+bool parseEpochDay(const char* text, int32_t &epochDay);
+string formatEpochDay(int32_t epochDay);
+
+// A book's due date: YYYY-MM-DD, or "None" for NO_DUE_DATE
+bool parseDueDate(const char* text, int32_t &epochDay);
+string formatDueDate(int32_t epochDay);
+
+#endif
@@ -0,0 +1,75 @@
+/* Program name: ExportWriter.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the export writer class (records written out as CSV or JSON Lines)
+*/
+
+#ifndef EXPORTWRITER_H
+#define EXPORTWRITER_H
+
+#include <cstddef>
+#include <ctime>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+enum ExportFormat {
+    EXPORT_CSV,        // A header row, then one row per record
+    EXPORT_JSON_LINES  // One JSON object per line, keyed by column name
+};
+
+// Filter for exports that keep every record
+struct ExportAll {
+    template <typename Record> bool operator()(const Record&) const { return true; }
+};
+
+// Writes records through a fixed-size buffer, so an export of any size uses the same small
+// amount of memory and the file is written in large blocks. Like saves, the file is written
+// under a temporary name and only replaces the target once finish() succeeds ("-" writes
+// straight to standard output instead).
+class ExportWriter {
+private:
+    static const size_t BUFFER_SIZE = 1 << 20;
+
+    string filename;
+    string tempName; // Empty when writing to standard output
+    int fd;
+    ExportFormat format;
+    vector<string> columns;
+    vector<char> buffer;
+    size_t used;
+    size_t column;   // Next column of the current record
+    size_t records;
+
+    void put(const char* text, size_t length);
+    void put(const string &text);
+    void put(char c);
+    void flush();
+    void startField();
+    void putEscaped(const char* text); // Quoted for CSV if needed, always for JSON
+
+public:
+    ExportWriter(const string &filename, ExportFormat format); // Throws runtime_error if the file cannot be created
+    ExportWriter(const ExportWriter&) = delete;
+    ExportWriter& operator=(const ExportWriter&) = delete;
+    ~ExportWriter(); // Deletes the temporary file if finish() was never reached
+
+    static ExportFormat formatFor(const string &filename); // ".jsonl", ".ndjson" and ".json" are JSON Lines
+
+    // Start the export (CSV writes the header row). Each record is then one value per column, in order.
+    void begin(const vector<string> &columns);
+    void addText(const char* value);
+    void addText(const string &value);
+    void addNumber(long long value);
+    void addBool(bool value);
+    void addTime(time_t value); // Local time as YYYY-MM-DD HH:MM:SS
+    void endRecord();
+
+    // Write out what is left and move the file into place (throws runtime_error on a write error)
+    void finish();
+
+    size_t getRecordCount() const;
+};
+
+#endif
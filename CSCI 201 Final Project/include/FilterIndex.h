@@ -0,0 +1,45 @@
+/* Program name: FilterIndex.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the filter index class (ordered publication date and genre indexes)
+*/
+
+#ifndef FILTERINDEX_H
+#define FILTERINDEX_H
+
+#include <climits>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "Book.h"
+#include "BookStore.h"
+
+using namespace std;
+
+class FilterIndex {
+private:
+    typedef pair<int, uint32_t> DateKey;    // (publication date, slot), so equal years stay distinct
+    typedef map<DateKey, BookHandle> DateMap;
+
+    DateMap byPubDate;                        // Every book, ordered by publication date
+    DateMap byGenre[SCIENCE_FICTION + 1];     // One date-ordered bucket per genre
+
+    static void collect(const DateMap &dates, int fromYear, int toYear, vector<BookHandle> &out);
+
+public:
+    // Keep the index in sync with the catalog
+    void add(BookHandle book, const Book &data);
+    void remove(BookHandle book, const Book &data);
+    void clear();
+
+    // Books published in [fromYear, toYear], oldest first
+    vector<BookHandle> findByPubDate(int fromYear, int toYear) const;
+
+    // Books of a genre published in [fromYear, toYear], oldest first
+    vector<BookHandle> findByGenre(genreType genre, int fromYear = INT_MIN, int toYear = INT_MAX) const;
+    size_t countGenre(genreType genre) const;
+};
+
+#endif
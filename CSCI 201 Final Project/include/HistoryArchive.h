@@ -0,0 +1,107 @@
+/* Program name: HistoryArchive.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the history archive class (old transactions compressed into sealed,
+* time-indexed segments)
+*/
+
+#ifndef HISTORYARCHIVE_H
+#define HISTORYARCHIVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+// One transaction as it is archived. The text points into whatever the record was read from
+// (the archive segment it was decoded from, a loaded file, or the transaction being archived).
+struct HistoryRecord {
+    bool isBorrow;
+    const char* isbn;
+    int memberID;
+    time_t transactionDate;
+    const char* dueDate; // Only set for borrows
+};
+
+/* Segment encoding (integers are varints, signed ones zigzag encoded):
+*   string count, then that many NUL-terminated strings (the segment's ISBNs and due dates)
+*   per transaction: ISBN string number * 2 + 1 if it is a borrow, member ID, seconds since
+*   the previous transaction (the first counts from the segment's minimum time), and for
+*   borrows the due date's string number
+* Segments never change once sealed. Each one's minimum and maximum time are kept beside it,
+* so a query for a time range only decodes the segments that overlap it.
+*/
+class HistoryArchive {
+public:
+    static const size_t SEGMENT_SIZE = 4096; // Transactions per sealed segment
+
+    struct SegmentInfo {
+        int64_t minTime;
+        int64_t maxTime;
+        uint32_t count;
+    };
+
+private:
+    struct Segment {
+        SegmentInfo info;
+        const uint8_t* data;
+        size_t size;
+        bool owned; // Sealed here (freed by the archive) rather than adopted from a snapshot
+    };
+
+    vector<Segment> segments;
+    size_t transactionCount;
+    size_t byteCount;
+
+public:
+    HistoryArchive();
+    HistoryArchive(const HistoryArchive&) = delete;
+    HistoryArchive& operator=(const HistoryArchive&) = delete;
+    ~HistoryArchive();
+
+    // Compress transactions (oldest first) into a new segment after the existing ones
+    void seal(const HistoryRecord* records, size_t count);
+
+    // Add a segment encoded elsewhere (a mapped snapshot); the data must stay valid until clear().
+    // Throws runtime_error if the segment's description does not fit its data.
+    void adopt(const SegmentInfo &info, const uint8_t* data, size_t size);
+
+    void clear();
+
+    size_t segmentCount() const;
+    size_t size() const;  // Archived transactions
+    size_t bytes() const; // Encoded size of every segment
+    const SegmentInfo& getInfo(size_t segment) const;
+    const uint8_t* getData(size_t segment, size_t &size) const;
+
+    // Decode a segment's transactions in order (throws runtime_error if the segment is corrupt)
+    void decode(size_t segment, vector<HistoryRecord> &records) const;
+
+    // Visit every archived transaction in order
+    template <typename Visitor> void forEach(Visitor visit) const {
+        forEach(numeric_limits<time_t>::min(), numeric_limits<time_t>::max(), visit);
+    }
+
+    // Visit the archived transactions made between two times (inclusive) in order, skipping
+    // every segment whose time range misses them
+    template <typename Visitor> void forEach(time_t from, time_t to, Visitor visit) const {
+        vector<HistoryRecord> records;
+        for (size_t segment = 0; segment < segments.size(); ++segment) {
+            const SegmentInfo &info = segments[segment].info;
+            if (info.maxTime < from || info.minTime > to) {
+                continue;
+            }
+            decode(segment, records);
+            for (size_t i = 0; i < records.size(); ++i) {
+                if (records[i].transactionDate >= from && records[i].transactionDate <= to) {
+                    visit(records[i]);
+                }
+            }
+        }
+    }
+};
+
+#endif
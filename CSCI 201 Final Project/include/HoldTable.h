@@ -0,0 +1,64 @@
+/* Program name: HoldTable.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the hold table class (first-come, first-served queues of members waiting for books)
+*/
+
+#ifndef HOLDTABLE_H
+#define HOLDTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Isbn.h"
+
+using namespace std;
+
+// Each book has a queue of the members holding it, first in line first. Holds live in one pool
+// and are linked into their book's queue, and every member keeps a reference to each of their
+// holds, so joining a queue, serving its front and cancelling from anywhere in line are all O(1).
+class HoldTable {
+private:
+    static const uint32_t NO_HOLD = UINT32_MAX;
+
+    struct Hold {
+        int memberID;
+        uint32_t prev; // NO_HOLD at the front of the queue
+        uint32_t next; // NO_HOLD at the back
+    };
+    struct Queue {
+        uint32_t first;
+        uint32_t last;
+        size_t length;
+    };
+
+    vector<Hold> holds;        // Freed holds are reused
+    vector<uint32_t> freeHolds;
+    unordered_map<Isbn, Queue> queues;                                // ISBN -> members waiting for it
+    unordered_map<int, unordered_map<Isbn, uint32_t> > holdsByMember; // Member ID -> ISBN -> their hold
+    size_t count;
+
+public:
+    HoldTable();
+
+    // Join and leave queues
+    size_t enqueue(const Isbn &ISBN, int memberID); // Returns the place in line (1 is next), or 0 if already waiting
+    bool cancel(const Isbn &ISBN, int memberID);    // Returns false if the member was not waiting
+    void cancelAll(const Isbn &ISBN);
+    void clear();
+
+    // Queries
+    bool isHeld(const Isbn &ISBN) const;
+    int getNextInLine(const Isbn &ISBN) const; // Returns -1 if nobody is waiting
+    bool hasHold(const Isbn &ISBN, int memberID) const;
+    bool hasHolds(int memberID) const;
+    size_t getQueueLength(const Isbn &ISBN) const;
+    vector<int> getQueue(const Isbn &ISBN) const; // Member IDs, first in line first
+    vector<Isbn> getHeldBooks() const;            // ISBNs with a queue, sorted
+    size_t size() const;                            // Holds in every queue
+};
+
+#endif
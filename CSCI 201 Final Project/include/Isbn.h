@@ -0,0 +1,70 @@
+/* Program name: Isbn.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the ISBN class (an ISBN packed into one 64-bit number)
+*/
+
+#ifndef ISBN_H
+#define ISBN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+// An ISBN kept as its ISBN-13 digits in one number, so indexes hash and compare integers and
+// every book, loan, hold and transaction stores 8 bytes instead of a string. ISBN-10s are
+// converted to their ISBN-13 (978 prefix), so both forms of a book's ISBN find it.
+// Numeric order is the same as the order of the 13-digit text.
+//
+// Data files written before ISBNs were checked can hold other text ("12345", or an ISBN with a
+// wrong check digit). Such a legacy ISBN is packed into the number as it was written, with the
+// top bit set: a string of up to 17 digits as its length and value, or up to 10 letters, digits
+// and hyphens at 6 bits each.
+// Legacy ISBNs sort after every real one and are saved and shown unchanged.
+class Isbn {
+private:
+    uint64_t value; // 0 for no ISBN
+
+    explicit Isbn(uint64_t value) : value(value) {}
+    static bool normalize(const char* text, Isbn &isbn);
+    static bool packLegacy(const char* text, Isbn &isbn);
+
+public:
+    static const size_t TEXT_SIZE = 18; // 13 digits (or a legacy ISBN's 17) and a NUL
+
+    Isbn() : value(0) {}
+
+    // Read an ISBN-10 or ISBN-13 (hyphens and spaces are ignored), checking the check digit and
+    // the 978/979 prefix. parseSaved keeps anything else it can pack as a legacy ISBN, exactly as
+    // it was saved (an ISBN-10 with a wrong check digit is not turned into an ISBN-13), so data
+    // files written before ISBNs were checked still load. Neither accepts empty text.
+    static bool parse(const string &text, Isbn &isbn);
+    static bool parseSaved(const char* text, Isbn &isbn);
+
+    bool isNull() const { return value == 0; }
+    bool isLegacy() const { return (value >> 63) != 0; }
+    uint64_t getValue() const { return value; }
+
+    // The 13 digits, or a legacy ISBN's text (toChars writes it and a NUL into TEXT_SIZE chars)
+    void toChars(char* text) const;
+    string toString() const;
+
+    bool operator==(const Isbn &other) const { return value == other.value; }
+    bool operator!=(const Isbn &other) const { return value != other.value; }
+    bool operator<(const Isbn &other) const { return value < other.value; }
+};
+
+ostream& operator<<(ostream &out, const Isbn &isbn);
+
+// So ISBNs can key unordered maps and sets
+namespace std {
+    template <> struct hash<Isbn> {
+        size_t operator()(const Isbn &isbn) const { return hash<uint64_t>()(isbn.getValue()); }
+    };
+}
+
+#endif
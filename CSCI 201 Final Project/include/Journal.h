@@ -0,0 +1,110 @@
+/* Program name: Journal.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the journal class (append-only log of library changes since the last save)
+*/
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Kinds of change recorded in the journal
+enum journalRecordType {
+    JOURNAL_ADD_BOOK = 1,
+    JOURNAL_EDIT_BOOK = 2,
+    JOURNAL_DELETE_BOOK = 3,
+    JOURNAL_REGISTER_MEMBER = 4,
+    JOURNAL_EDIT_MEMBER = 5,
+    JOURNAL_DELETE_MEMBER = 6,
+    JOURNAL_BORROW = 7,
+    JOURNAL_RETURN = 8,
+    JOURNAL_RESERVE = 9,
+    JOURNAL_CANCEL_RESERVATION = 10,
+    JOURNAL_CLEAR_HISTORY = 11
+};
+
+// One journal record: a type byte followed by varint integers and length-prefixed strings.
+// Fields are read back in the order they were written.
+// Entries read back from a journal file also carry the sequence number the journal gave them.
+class JournalEntry {
+private:
+    vector<char> bytes;
+    size_t readPos;
+    uint64_t sequence;
+
+public:
+    explicit JournalEntry(journalRecordType type);
+    JournalEntry(const char* data, size_t size, uint64_t sequence);
+
+    journalRecordType getType() const;
+    const vector<char>& getBytes() const;
+    uint64_t getSequence() const; // 0 for entries not read from a journal
+
+    // Writing
+    JournalEntry& putInt(int64_t value);
+    JournalEntry& putString(const string &value);
+
+    // Reading (throws runtime_error if the record is shorter than expected)
+    int64_t getInt();
+    string getString();
+};
+
+// Append-only file of JournalEntry records. Each record is framed as
+// (payload length, checksum, sequence number, payload), so a record torn by a crash is
+// detected and dropped. Sequence numbers keep rising across saves: a save stores the last one
+// it includes in the data file, and records at or below it are skipped on replay, so a crash
+// between writing the data file and truncating the journal does not apply them twice.
+// Each append is written with one write() and one fdatasync().
+// A background save first moves the records it covers to FILE.saving (see rotate()), which
+// is replayed before the journal itself until a save deletes it.
+class Journal {
+private:
+    int fd;
+    string filename;
+    vector<char> pending;  // Framed records not yet written
+    uint64_t lastSequence; // Given to the newest record
+
+    string savingName() const;
+    void clearFile();
+
+public:
+    Journal();
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+    ~Journal();
+
+    // Open (creating if needed) and return the records already in the file, oldest first.
+    // A torn or corrupt tail is cut off. Throws runtime_error if the file cannot be opened.
+    vector<JournalEntry> open(const string &filename);
+    bool isOpen() const;
+    void close();
+
+    // Number new records after a saved data file's last sequence number (never lowers it)
+    void startAfter(uint64_t sequence);
+    uint64_t getLastSequence() const;
+
+    // Write records and wait for them to reach the disk (throws as commit() does). Several
+    // records passed together are committed together.
+    void append(const JournalEntry &entry);
+    void append(const vector<JournalEntry> &entries);
+
+    // Write every queued record and wait for it to reach the disk. If that fails, the queued
+    // records are dropped, the file is cut back to where it was, and runtime_error is thrown.
+    void commit();
+
+    // Drop every record (call once the changes are in a saved data file)
+    void truncate();
+
+    // Background saves: rotate() when the save starts, so later changes go in a fresh journal;
+    // the save calls dropRotated() once the data file holds everything before that
+    void rotate();
+    void dropRotated();
+};
+
+#endif
@@ -1,6 +1,6 @@
 /* Program name: Library.h
 * Author: Joshua Yin
-* Date last updated: 7/24/2024
+* Date last updated: 10/17/2026
 * Purpose: Define the library class
 */
 
@@ -8,69 +8,354 @@
 #define LIBRARY_H
 
 #include <iostream>
+#include <cstdint>
+#include <ctime>
 #include <fstream>
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include <sys/types.h>
+
+#include "LoanTable.h"
 #include "Member.h"
 #include "Book.h"
+#include "FilterIndex.h"
+#include "HistoryArchive.h"
+#include "HoldTable.h"
+#include "Isbn.h"
+#include "BookStore.h"
+#include "ExportWriter.h"
+#include "Journal.h"
+#include "LineFile.h"
 #include "Transaction.h"
-#include "Return.h"
-#include "Borrow.h"
+#include "TransactionPool.h"
+#include "SearchIndex.h"
+#include "Snapshot.h"
+#include "TextPool.h"
 
 using namespace std;
 
 class Library {
 private:
-    vector<Book> books;
+    TextPool textPool; // Text of every book and member (each library has its own, freed on reload)
+    BookStore books;
     vector<Member> members;
-    vector<Transaction*> transactions;
+    TransactionPool transactions;      // Recent transactions, oldest first
+    HistoryArchive archive;            // Older transactions, compressed (history is the archive, then transactions)
+
+    HoldTable holds; // Reservations: a queue of members waiting for each book
+    LoanTable loans; // Open loans, so returns and member deletes never scan the transaction history
+    SearchIndex textIndex; // Title and author words, kept in sync with books
+    FilterIndex filterIndex; // Publication dates and genres, kept in sync with books
+
+    unordered_map<Isbn, BookHandle> bookIndex; // ISBN -> handle into books, kept in sync with the store
+    unordered_map<int, size_t> memberIndex;      // Member ID -> position in members, kept in sync with the vector
+
+    Journal journal; // Changes since the last save (only written once openJournal is called)
+
+    // What changed since the snapshot in checkpoint.filename was written, so saving to it
+    // again only has to append the changes as a delta segment
+    struct Checkpoint {
+        string filename;                    // Empty until a snapshot is saved or loaded
+        bool stale;                         // Everything must be rewritten (after a text load or a setter)
+        unordered_set<Isbn> books;          // ISBNs whose book or loan changed
+        unordered_set<int> members;         // IDs of members added, edited or deleted
+        unordered_set<Isbn> reservations;   // ISBNs whose hold queue changed
+        size_t transactions;                // Recent transactions already in the snapshot
+        size_t archiveSegments;             // Archived history segments already in the snapshot
+        size_t archivedTransactions;        // Saved recent transactions archived since
+        bool historyCleared;                // The saved history was deleted
+        uint64_t baseBytes;                 // Size of the full segment
+        uint64_t deltaBytes;                // Size of the delta segments after it
+
+        Checkpoint() : stale(true), transactions(0), archiveSegments(0), archivedTransactions(0), historyCleared(false),
+            baseBytes(0), deltaBytes(0) {}
+    };
+    Checkpoint checkpoint;
+
+    // Members and saved transactions that a lazy load left in the file (see setLazyLoading). The
+    // file stays in memory (textPool owns it), so they are built the first time they are needed.
+    struct DeferredLoad {
+        bool members;             // Members are still only in the file
+        size_t history;           // Saved recent transactions still only in the file (they go before any newer ones)
+        const char* memberText;   // Text files: first line of the member section
+        size_t memberCount;
+        const char* historyText;  // Text files: first line of the transaction section
+        MappedSnapshot* snapshot; // Snapshots: the file's segments (the mapping itself belongs to textPool)
+
+        DeferredLoad() : members(false), history(0), memberText(nullptr), memberCount(0), historyText(nullptr), snapshot(nullptr) {}
+    };
+    DeferredLoad deferred;
+    bool lazyLoading;
+
+    // A save being written by a child process (see startBackgroundSave)
+    struct BackgroundSave {
+        pid_t pid;         // -1 when no save is running
+        string filename;
+        bool snapshot;
+        bool append;       // Snapshots: appending a delta rather than rewriting the file
+
+        BackgroundSave() : pid(-1), snapshot(false), append(false) {}
+    };
+    BackgroundSave saver;
+
+    // Index helpers
+    void indexBook(BookHandle handle, const Book &book);
+    void unindexBook(BookHandle handle, const Book &book);
+    void rebuildBookIndex();
+    bool addBookBatch(const vector<Book> &batch); // Journaled first; false if that failed
+    void rebuildMemberIndex();
+    void rebuildLoans();
+    void clearLibrary(); // Drop every book, member, transaction and reservation before a load
+
+    // Copies whose text lives in textPool (for books and members built by callers, whose text
+    // is in a pool the library does not own)
+    Book pooledCopy(const Book &book);
+    Member pooledCopy(const Member &member);
+    bool ownsText(const Book &book) const; // Built by makeBook, so no copy is needed
+    bool ownsText(const Member &member) const;
+
+    // Journal a change before it is made; false (after reporting why) if it could not be written
+    bool journalChange(const JournalEntry &entry);
+    bool journalChange(const vector<JournalEntry> &entries);
+
+    // Quiet versions of the mutations (no checks or messages), shared with journal replay
+    void applyAddBook(const Book &book);
+    void applyEditBook(const Isbn &isbn, const Book &updatedBook);
+    void applyDeleteBook(const Isbn &isbn);
+    void applyRegisterMember(const Member &member);
+    void applyEditMember(int id, const Member &updatedMember);
+    void applyDeleteMember(int id);
+    void applyBorrow(const Isbn &isbn, int memberID, time_t transactionDate, const string &dueDate);
+    void applyReturn(const Isbn &isbn, int memberID, time_t transactionDate);
+    void processBorrow(BookHandle handle, const Transaction &transaction); // A new borrow (reported; the caller journals it)
+    void applyReserve(const Isbn &isbn, int memberID);
+    void applyCancelReservation(const Isbn &isbn, int memberID);
+    void applyClearHistory();
+    void replayEntry(JournalEntry &entry);
+
+    // Lazy loading helpers (the const versions let read-only methods build what they show on first use)
+    void loadDeferredMembers() const;
+    void loadDeferredHistory() const;
+    void buildDeferredMembers();
+    void buildDeferredHistory();
+    void releaseDeferredSnapshot(); // Once nothing is left to build from it
+    void dropDeferred();
+    size_t historySize() const; // Recent transactions, built and deferred
 
-    map<string, int> reservations;
+    // History archive helpers
+    void addHistory(const vector<HistoryRecord> &records);
+    void rollHistory();
+    void noteArchived(size_t count);
+
+    // Show an archived transaction to a visitor as the transaction it was (without a book handle)
+    static Transaction fromHistoryRecord(const HistoryRecord &record);
+
+    // Export helpers (each begin writes the columns, each export writes one record)
+    static void beginBookExport(ExportWriter &out);
+    static void exportBook(ExportWriter &out, const Book &book);
+    static void beginMemberExport(ExportWriter &out);
+    static void exportMember(ExportWriter &out, const Member &member);
+    static void beginLoanExport(ExportWriter &out);
+    static void exportLoan(ExportWriter &out, const LoanRecord &loan);
+    static void beginHistoryExport(ExportWriter &out);
+    static void exportHistoryRecord(ExportWriter &out, const HistoryRecord &record);
+    struct HistoryText { // The text a history record made from a transaction points to
+        char isbn[Isbn::TEXT_SIZE];
+        string dueDate;
+    };
+    static HistoryRecord makeHistoryRecord(const Transaction &transaction, HistoryText &text);
+
+    // Save helpers (used by saves made here and by background saves)
+    void writeTextFile(const string &filename) const;
+    bool canAppendSnapshot(const string &filename) const;
+    uint64_t writeSnapshot(const string &filename, bool append) const;
+    void reapBackgroundSave(bool wait);
+
+    // Snapshot helpers
+    void addFullSections(SnapshotWriter &writer) const;
+    void addDeltaSections(SnapshotWriter &writer) const;
+    void addArchiveSections(SnapshotWriter &writer, size_t firstSegment) const;
+    void addCatalogSections(SnapshotWriter &writer) const; // After the book section (full segments only)
+    void applySnapshotBooks(const MappedSnapshot &snapshot, size_t segment); // Also open loans and reservations
+    void applySnapshotMembers(const MappedSnapshot &snapshot, size_t segment);
+    void applySnapshotArchive(const MappedSnapshot &snapshot, size_t segment);
+    void applySnapshotHistory(const MappedSnapshot &snapshot, size_t segment, vector<HistoryRecord> &history) const;
+    bool hasCheckpointChanges() const;
+    void resetCheckpointChanges();
 
 public:
+    Library();
+
+    // Build a book or member whose text is stored in the library's own pool, so adding or editing
+    // with it needs no second copy of the text
+    Book makeBook(const string &title, const string &author, const Isbn &isbn, int pubDate, const string &callNum,
+        genreType genre);
+    Member makeMember(const string &name, int id, const string &phone, const string &email, const string &address);
+
     // Book methods
     void addBook(const Book &book);
-    void editBook(const string &isbn, const Book &updatedBook);
-    void deleteBook(const string &isbn);
+    void editBook(const Isbn &isbn, const Book &updatedBook);
+    void deleteBook(const Isbn &isbn);
     void displayBooks() const;
+    void displayInventory() const;
+    void displayAvailableBooks(genreType genre) const;
+    bool hasBook(const Isbn &isbn) const;
+    const Book* findBook(const Isbn &isbn) const; // Returns nullptr if no book has the ISBN
+
+    // Add every valid, new book in a delimited file of title, author, ISBN, publication date, call
+    // number and genre (".tsv" files are tab separated). Returns false if the file could not be
+    // read, or if the journal could not be written (books in batches written before then stay).
+    bool importBooks(const string &filename);
 
-    void borrowBook(const string &isbn, const int &memberId);
-    void returnBook(const string &isbn, const int &memberId);
+    void borrowBook(const Isbn &isbn, const int &memberId);
+    void returnBook(const Isbn &isbn, const int &memberId);
     void searchBook(const string &query, const string &searchType) const;
+    void searchBookByGenreAndDate(genreType genre, int fromYear, int toYear) const;
     
     // (Library) Member methods
     void registerMember(const Member &member);
     void editMember(int id, const Member &updatedMember);
     void deleteMember(int id);
     void displayMembers() const;
+    bool hasMember(int id) const;
+    const Member* findMember(int id) const; // Returns nullptr if no member has the ID
     
-    // Reservation methods
-    void reserveBook(const string &isbn, const int &memberId);
-    void cancelReservation(const string &isbn, const int &memberId);
+    // Reservation methods (members queue for borrowed books; once a book is returned, only the
+    // first member in line can borrow it until they do or cancel)
+    void reserveBook(const Isbn &isbn, const int &memberId);
+    void cancelReservation(const Isbn &isbn, const int &memberId);
     void displayReservations() const;
 
     // Transaction methods
     void displayTransactions() const;
+    void displayTransactionsBetween(time_t from, time_t to) const; // Inclusive; only decodes the archive segments in range
     void deleteTransactionHistory();
 
-    // File methods
-    void saveToFile(const string& filename);
-    void loadFromFile(const string& filename);
+    // Due date methods (loans are found through the book store's due date index, so these take
+    // time in proportion to the loans shown, not the size of the catalog)
+    static const int FINE_CENTS_PER_DAY = 25;   // Charged for each day a book is overdue
+    void displayOverdueLoans() const;           // As of today, with the fine owed on each
+    void displayLoansDueWithin(int days) const; // Due today or in the next days
+
+    // Memory methods
+    void displayMemoryReport() const;
+
+    // Export methods: stream books, members, open loans or the transaction history to a CSV or
+    // JSON Lines writer, one record at a time, keeping the records a filter returns true for
+    // (ExportAll keeps everything). Each returns the number of records written; call finish()
+    // on the writer afterwards.
+    template <typename Filter> size_t exportBooks(ExportWriter &out, Filter keep) const {
+        beginBookExport(out);
+        for (BookStore::const_iterator it = books.begin(); it != books.end(); ++it) {
+            if (keep(*it)) {
+                exportBook(out, *it);
+            }
+        }
+        return out.getRecordCount();
+    }
+    template <typename Filter> size_t exportMembers(ExportWriter &out, Filter keep) const {
+        loadDeferredMembers();
+        beginMemberExport(out);
+        for (vector<Member>::const_iterator it = members.begin(); it != members.end(); ++it) {
+            if (keep(*it)) {
+                exportMember(out, *it);
+            }
+        }
+        return out.getRecordCount();
+    }
+    template <typename Filter> size_t exportLoans(ExportWriter &out, Filter keep) const {
+        beginLoanExport(out);
+        const unordered_map<Isbn, int> &borrowers = loans.getBorrowers();
+        for (unordered_map<Isbn, int>::const_iterator it = borrowers.begin(); it != borrowers.end(); ++it) {
+            LoanRecord loan = { findBook(it->first), it->second, findMember(it->second) };
+            if (loan.book && keep(loan)) {
+                exportLoan(out, loan);
+            }
+        }
+        return out.getRecordCount();
+    }
+    // Only transactions made between two times (inclusive) are considered, so archive segments
+    // outside the range are never decoded
+    template <typename Filter> size_t exportHistory(ExportWriter &out, time_t from, time_t to, Filter keep) const {
+        loadDeferredHistory();
+        beginHistoryExport(out);
+        archive.forEach(from, to, [&out, &keep](const HistoryRecord &record) {
+            if (keep(record)) {
+                exportHistoryRecord(out, record);
+            }
+        });
+        HistoryText text;
+        for (TransactionPool::const_iterator it = transactions.begin(); it != transactions.end(); ++it) {
+            HistoryRecord record = makeHistoryRecord(*it, text);
+            if (record.transactionDate >= from && record.transactionDate <= to && keep(record)) {
+                exportHistoryRecord(out, record);
+            }
+        }
+        return out.getRecordCount();
+    }
+
+    // File methods (".snap" files are saved as binary snapshots; snapshots are detected on load;
+    // loads return false if the file could not be loaded, leaving nothing half loaded).
+    // A successful save empties the journal, since its changes are now in the file. Files are
+    // written under a temporary name and renamed into place, so a failed save leaves the old one.
+    bool saveToFile(const string& filename);
+    bool loadFromFile(const string& filename);
+    bool saveSnapshot(const string& filename);
+    bool loadSnapshot(const string& filename);
+
+    // Background saves: a forked copy of the library writes the file, so the save sees the library
+    // as it was when it started (memory is shared copy-on-write) while this one keeps being used.
+    // One runs at a time; any other save waits for it first.
+    bool startBackgroundSave(const string& filename);
+    void pollBackgroundSave(); // Report a background save that has finished (never blocks)
+    void waitForBackgroundSave();
+
+    // Replay the changes left in a journal (after a crash) and log every later change to it
+    void openJournal(const string& filename);
+
+    // Lazy loading (off by default): later loads only build the books, open loans and reservations
+    // up front; members and the transaction history are built the first time something uses them
+    void setLazyLoading(bool lazy);
+
+    // Getters (return references, so inspecting state never copies it)
+    const BookStore& getBooks() const;
+    const vector<Member>& getMembers() const;
+    const HoldTable& getHolds() const;
+    const TransactionPool& getTransactions() const; // Recent ones only (older ones are archived)
+    size_t getTransactionCount() const;                  // Archived and recent
 
-    // Getters
-    vector<Book> getBooks() const;
-    vector<Member> getMembers() const;
-    map<string, int> getReservations() const;
-    vector<Transaction*> getTransactions() const;
+    // Read-only iteration (visitors only ever see const references)
+    template <typename Visitor> void forEachBook(Visitor visit) const {
+        for (BookStore::const_iterator it = books.begin(); it != books.end(); ++it) {
+            visit(*it);
+        }
+    }
+    template <typename Visitor> void forEachMember(Visitor visit) const {
+        loadDeferredMembers();
+        for (vector<Member>::const_iterator it = members.begin(); it != members.end(); ++it) {
+            visit(*it);
+        }
+    }
+    template <typename Visitor> void forEachTransaction(Visitor visit) const {
+        loadDeferredHistory();
+        archive.forEach([&visit](const HistoryRecord &record) {
+            visit(fromHistoryRecord(record));
+        });
+        for (TransactionPool::const_iterator it = transactions.begin(); it != transactions.end(); ++it) {
+            visit(*it);
+        }
+    }
     
     // Setters
     void setBooks(const vector<Book> &books);
     void setMembers(const vector<Member> &members);
-    void setReservations(const map<string, int> &reservations);
-    void setTransactions(const vector<Transaction*> &transactions);
+    void setHolds(const HoldTable &holds);
+    void setTransactions(const TransactionPool &transactions);
 
     ~Library();
 };
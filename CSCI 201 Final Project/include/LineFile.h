@@ -0,0 +1,38 @@
+/* Program name: LineFile.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the line file class (a text file read into one buffer and split into lines)
+*/
+
+#ifndef LINEFILE_H
+#define LINEFILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Reads a whole file with one read and splits it into lines, the same lines getline would
+// return. Every '\n' is replaced by a NUL so each line can be used in place as a C string;
+// nothing is allocated per line or per field.
+class LineFile {
+private:
+    char* buffer;
+    size_t size;
+    vector<const char*> lines;
+
+public:
+    explicit LineFile(const string &filename); // Throws runtime_error if the file cannot be read
+    LineFile(const LineFile&) = delete;
+    LineFile& operator=(const LineFile&) = delete;
+    ~LineFile();
+
+    size_t lineCount() const;
+    const char* line(size_t index) const; // Throws runtime_error past the last line
+
+    // Hand the buffer (size bytes, allocated with new[]) to the caller; lines stay valid
+    char* release(size_t &size);
+};
+
+#endif
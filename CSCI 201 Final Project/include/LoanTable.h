@@ -0,0 +1,48 @@
+/* Program name: LoanTable.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the loan table class (tracks which books are currently borrowed and by whom)
+*/
+
+#ifndef LOANTABLE_H
+#define LOANTABLE_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Isbn.h"
+
+using namespace std;
+
+class Book;
+class Member;
+
+// One open loan with the book and member it belongs to (what a loans export sees)
+struct LoanRecord {
+    const Book* book;
+    int memberID;
+    const Member* member; // nullptr if no member has the ID
+};
+
+class LoanTable {
+private:
+    unordered_map<Isbn, int> borrowerByISBN;              // ISBN -> ID of member currently borrowing it
+    unordered_map<int, unordered_set<Isbn> > loansByMember; // Member ID -> ISBNs they currently have out
+
+public:
+    // Open and close loans (called when borrow and return transactions are processed)
+    void openLoan(const Isbn &ISBN, int memberID);
+    void closeLoan(const Isbn &ISBN);
+    void clear();
+
+    // Queries
+    bool isOnLoan(const Isbn &ISBN) const;
+    int getBorrower(const Isbn &ISBN) const; // Returns -1 if the book is not on loan
+    bool hasLoans(int memberID) const;
+    const unordered_set<Isbn>& getLoans(int memberID) const;
+    const unordered_map<Isbn, int>& getBorrowers() const; // Every open loan (ISBN -> member ID)
+    size_t size() const;
+};
+
+#endif
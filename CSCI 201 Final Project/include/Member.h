@@ -1,6 +1,6 @@
 /* Program name: Member.h
 * Author: Joshua Yin
-* Date last updated: 7/24/2024
+* Date last updated: 10/17/2026
 * Purpose: Define the member class
 */
 
@@ -10,33 +10,41 @@
 #include <iostream>
 #include <string>
 
+#include "TextPool.h"
+
 using namespace std;
 
+// Text fields point into a TextPool's arena (the library's own); a member must not outlive it
 class Member {
 private:
-    string name;
+    const char* name;
     int memberID;
-    string phone;
-    string email;
-    string address;
+    const char* phone;
+    const char* email;
+    const char* address;
+
+    Member(const char* name, int memberID, const char* phone, const char* email, const char* address);
 
 public:
     // Constructor
-    Member(string name, int memberID, string phone, string email, string address);
+    Member(TextPool &text, string name, int memberID, string phone, string email, string address);
+
+    // Build a member around text that already lives in a pool (no copies, used by the loaders)
+    static Member fromPooledText(const char* name, int memberID, const char* phone, const char* email, const char* address);
 
     // Getters
-    string getName() const;
+    const char* getName() const;
     int getMemberID() const;
-    string getPhone() const;
-    string getEmail() const;
-    string getAddress() const;
+    const char* getPhone() const;
+    const char* getEmail() const;
+    const char* getAddress() const;
 
     // Setters
-    void setName(const string &name);
+    void setName(TextPool &text, const string &name);
     void setMemberID(int memberID);
-    void setPhone(const string &phone);
-    void setEmail(const string &email);
-    void setAddress(const string &address);
+    void setPhone(TextPool &text, const string &phone);
+    void setEmail(TextPool &text, const string &email);
+    void setAddress(TextPool &text, const string &address);
 
     // Display member details
     void display() const;
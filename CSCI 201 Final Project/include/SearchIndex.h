@@ -0,0 +1,91 @@
+/* Program name: SearchIndex.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the search index class (inverted index of title and author words)
+*/
+
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Book.h"
+#include "BookStore.h"
+#include "TrigramIndex.h"
+
+using namespace std;
+
+// Fields a word can come from (combined as a bit mask)
+enum searchField {
+    TITLE_FIELD = 1,
+    AUTHOR_FIELD = 2,
+    ALL_FIELDS = TITLE_FIELD | AUTHOR_FIELD
+};
+
+// A ranked search hit (higher scores are better matches)
+struct SearchResult {
+    BookHandle book;
+    int score;
+};
+
+class SearchIndex {
+private:
+    // One entry in a word's posting list: which book has the word and in which fields
+    struct Posting {
+        BookHandle book;
+        unsigned char fields;
+    };
+
+    map<string, vector<Posting> > postings; // Word -> books containing it, sorted by slot (ordered so prefixes are ranges)
+    TrigramIndex vocabulary;                // Every indexed word, for typo-tolerant lookups
+
+    // A posting list matched by one query word, and how well its word matched
+    struct WordMatch {
+        const vector<Posting>* list;
+        int weight;
+    };
+    typedef unordered_map<uint32_t, SearchResult> CandidateMap; // Slot -> book and running score
+
+    static bool postingBefore(const Posting &posting, uint32_t slot);
+    static void mergeWord(CandidateMap &candidates, const vector<WordMatch> &matches, unsigned char fields, bool firstWord);
+    static vector<SearchResult> rank(const CandidateMap &candidates, size_t limit);
+    void addWords(BookHandle book, const string &text, unsigned char field);
+    void removeWords(BookHandle book, const string &text, unsigned char field);
+
+public:
+    // Split text into lowercase words, dropping punctuation ("J.R.R. Tolkien" -> "jrr", "tolkien")
+    static vector<string> tokenize(const string &text);
+
+    // Keep the index in sync with the catalog
+    void add(BookHandle book, const Book &data);
+    void remove(BookHandle book, const Book &data);
+    void clear();
+
+    // Books containing every query word (each word may be a prefix), best matches first
+    vector<SearchResult> search(const string &query, unsigned char fields, size_t limit) const;
+
+    // Books containing a word within a few typos of every query word, closest matches first
+    vector<SearchResult> fuzzySearch(const string &query, unsigned char fields, size_t limit) const;
+
+    // Indexed words starting with a prefix, most common first
+    vector<string> complete(const string &prefix, size_t limit) const;
+
+    // Visit every indexed word in order with the books it is in (handle and fields, in slot order)
+    template <typename Visitor> void forEachWord(Visitor visit) const {
+        vector<pair<BookHandle, unsigned char> > books;
+        for (map<string, vector<Posting> >::const_iterator it = postings.begin(); it != postings.end(); ++it) {
+            books.clear();
+            for (vector<Posting>::const_iterator p = it->second.begin(); p != it->second.end(); ++p) {
+                books.push_back(make_pair(p->book, p->fields));
+            }
+            visit(it->first, books);
+        }
+    }
+};
+
+#endif
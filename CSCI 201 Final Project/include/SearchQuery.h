@@ -0,0 +1,22 @@
+/* Program name: SearchQuery.h
+* Author: Joshua Yin
+* Date last updated: 10/18/2026
+* Purpose: Define the search query parsers shared by the library and catalog views
+*/
+
+#ifndef SEARCHQUERY_H
+#define SEARCHQUERY_H
+
+#include <string>
+
+#include "Book.h"
+
+using namespace std;
+
+// Genre searches need the genre's exact name, as the genre menu shows it
+bool parseGenreName(const string &name, genreType &genre);
+
+// Parse a publication year or year range ("1965" or "1960-1980")
+bool parseYearRange(const string &query, int &fromYear, int &toYear);
+
+#endif
@@ -0,0 +1,225 @@
+/* Program name: Snapshot.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the binary snapshot format (fixed-width record sections plus a string heap)
+*/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/* File layout (native byte order, every section and segment 8-byte aligned):
+*   one or more segments, each made of
+*     SnapshotHeader
+*     SnapshotSection[sectionCount]   (where each section lives, relative to the header)
+*     section data ...
+* Strings are stored once per segment, NUL-terminated, in the string section. Records refer to
+* them by byte offset, so a mapped snapshot can be read in place without parsing.
+*
+* The first segment is a full checkpoint. Later segments are deltas appended by incremental
+* saves and are applied in order: book, member, loan and reservation records replace the
+* entry with the same key, transactions are appended, and the deleted/closed/cancelled
+* sections remove entries. Applying a full segment to an empty library loads it.
+*
+* A book can have several reservation records, one per member in its hold queue, in queue
+* order. Together they replace the book's whole queue.
+*
+* Older transactions are kept in archived history segments (see HistoryArchive.h), stored
+* back to back in the archive data section and described by the archive index. They come
+* before the transaction records in history order. A delta that archived some of the saved
+* transaction records says how many with an archived transactions section; that many are
+* dropped from the front of the transaction records when it is applied.
+*
+* Full segments also carry a catalog index so read-only catalogs (see CatalogView.h) can
+* search the books in place: the search index's words (sorted, as in SearchIndex) with their
+* postings, the trigrams of those words, and the books in ISBN and publication date order.
+* Books are numbered by their position in the segment's book section.
+*
+* Each segment records the sequence number of the last journal record it includes (see
+* Journal.h), so those records are not replayed after loading it.
+*/
+
+const char SNAPSHOT_MAGIC[8] = { 'L', 'I', 'B', 'S', 'N', 'A', 'P', '\0' };
+const uint32_t SNAPSHOT_VERSION = 1;
+
+enum snapshotSectionType {
+    BOOK_SECTION = 1,
+    MEMBER_SECTION = 2,
+    TRANSACTION_SECTION = 3,
+    RESERVATION_SECTION = 4,
+    LOAN_SECTION = 5,
+    STRING_SECTION = 6,
+    DELETED_BOOK_SECTION = 7,           // uint32_t ISBN string offsets
+    DELETED_MEMBER_SECTION = 8,         // int32_t member IDs
+    CLOSED_LOAN_SECTION = 9,            // uint32_t ISBN string offsets
+    CANCELLED_RESERVATION_SECTION = 10, // uint32_t ISBN string offsets
+    CLEARED_HISTORY_SECTION = 11,       // One uint8_t record if the history was deleted before this segment's transactions
+    ARCHIVE_INDEX_SECTION = 12,         // ArchiveIndexRecord per archived history segment
+    ARCHIVE_DATA_SECTION = 13,          // uint8_t bytes of those segments
+    ARCHIVED_TRANSACTIONS_SECTION = 14, // One uint64_t record: saved transactions moved into the archive
+    CATALOG_WORD_SECTION = 15,          // CatalogWordRecord per indexed word, sorted by word
+    CATALOG_POSTING_SECTION = 16,       // uint32_t book number * 4 + searchField bits, grouped by word
+    CATALOG_TRIGRAM_SECTION = 17,       // CatalogTrigramRecord per word trigram, sorted by trigram
+    CATALOG_TRIGRAM_WORD_SECTION = 18,  // uint32_t word numbers, grouped by trigram
+    CATALOG_ISBN_ORDER_SECTION = 19,    // uint32_t book numbers sorted by ISBN
+    CATALOG_DATE_ORDER_SECTION = 20,    // uint32_t book numbers sorted by publication date
+    JOURNAL_SEQUENCE_SECTION = 21       // One uint64_t record: the last journal record the segment includes
+};
+
+enum snapshotTransactionType {
+    BORROW_RECORD = 1,
+    RETURN_RECORD = 2
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t sectionCount;
+    uint64_t segmentSize;   // Bytes from the start of this header to the start of the next segment
+};
+
+struct SnapshotSection {
+    uint32_t type;
+    uint32_t recordSize;    // Bytes per record (1 for the string section)
+    uint64_t offset;        // From the start of the header
+    uint64_t count;         // Number of records
+};
+
+struct BookRecord {
+    uint32_t title;         // String offsets
+    uint32_t author;
+    uint32_t isbn;
+    uint32_t callNum;
+    uint32_t dueDate;
+    int32_t pubDate;
+    uint8_t genre;
+    uint8_t isBorrowed;
+    uint8_t padding[2];
+};
+
+struct MemberRecord {
+    int32_t memberID;
+    uint32_t name;          // String offsets
+    uint32_t phone;
+    uint32_t email;
+    uint32_t address;
+};
+
+struct TransactionRecord {
+    uint8_t type;           // snapshotTransactionType
+    uint8_t padding[3];
+    int32_t memberID;
+    int64_t transactionDate;
+    uint32_t isbn;          // String offsets
+    uint32_t dueDate;       // Only meaningful for borrows
+};
+
+struct ArchiveIndexRecord {
+    int64_t minTime;        // Earliest and latest transaction in the segment
+    int64_t maxTime;
+    uint64_t offset;        // Into the archive data section
+    uint32_t count;         // Number of transactions
+    uint32_t size;          // Bytes
+};
+
+struct CatalogWordRecord {
+    uint32_t word;          // String offset
+    uint32_t firstPosting;  // Into the posting section
+    uint32_t postingCount;  // Books with the word (postings are in book number order)
+};
+
+struct CatalogTrigramRecord {
+    uint32_t trigram;       // Packed as in TrigramIndex
+    uint32_t firstWord;     // Into the trigram word section
+    uint32_t wordCount;
+};
+
+struct ReservationRecord { // Also used for open loans
+    uint32_t isbn;          // String offset
+    int32_t memberID;
+};
+
+// Builds a snapshot in memory and writes it with one call
+class SnapshotWriter {
+private:
+    struct Section {
+        uint32_t type;
+        uint32_t recordSize;
+        vector<char> data;
+        uint64_t count;
+    };
+
+    vector<Section> sections;
+    vector<char> strings;
+    unordered_map<string, uint32_t> stringOffsets; // Each distinct string is stored once
+
+public:
+    SnapshotWriter();
+
+    uint32_t addString(const string &text);
+
+    template <typename Record> void addSection(snapshotSectionType type, const vector<Record> &records) {
+        Section section;
+        section.type = type;
+        section.recordSize = sizeof(Record);
+        section.count = records.size();
+        const char* bytes = reinterpret_cast<const char*>(records.data());
+        section.data.assign(bytes, bytes + records.size() * sizeof(Record));
+        sections.push_back(section);
+    }
+
+    // Write the header, section table, sections and string heap as one segment, replacing the
+    // file (through a temporary file, so a failed write leaves the old one) or appending to it.
+    // Either way the data is on disk before this returns. Returns the number of bytes written.
+    uint64_t write(const string &filename, bool append = false) const;
+};
+
+// Read-only view of a snapshot file mapped into memory
+class MappedSnapshot {
+private:
+    struct Segment {
+        const char* start;
+        const char* strings;
+        size_t stringsSize;
+    };
+
+    char* data;
+    size_t length;
+    vector<Segment> segments;
+
+    void validateSegment(size_t offset); // Throws runtime_error if the segment is malformed
+
+public:
+    explicit MappedSnapshot(const string &filename); // Throws runtime_error if the file is missing or malformed
+    ~MappedSnapshot();
+    MappedSnapshot(const MappedSnapshot&) = delete;
+    MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+    // Segments in the order they were written (the first is the full checkpoint)
+    size_t segmentCount() const;
+    size_t segmentSize(size_t segment) const;
+
+    // Records of a section (nullptr and a count of 0 if the segment has no such section)
+    template <typename Record> const Record* records(size_t segment, snapshotSectionType type, size_t &count) const {
+        return static_cast<const Record*>(section(segment, type, sizeof(Record), count));
+    }
+    const void* section(size_t segment, snapshotSectionType type, size_t recordSize, size_t &count) const;
+
+    // String at an offset into a segment's string heap
+    const char* text(size_t segment, uint32_t offset) const;
+
+    // Hand the mapping to the caller (who must munmap it); the snapshot no longer owns it, but its
+    // records and strings can still be read for as long as the caller keeps the mapping
+    void release(void* &address, size_t &size);
+
+    static bool isSnapshotFile(const string &filename); // Checks the magic number
+};
+
+#endif
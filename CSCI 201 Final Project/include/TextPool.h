@@ -0,0 +1,75 @@
+/* Program name: TextPool.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the text pool class (arena and interning storage for book and member text)
+*/
+
+#ifndef TEXTPOOL_H
+#define TEXTPOOL_H
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Stores text as NUL-terminated strings in large blocks that are freed all at once. Each library
+// owns its own pool, so loading one never invalidates the text of another.
+// Repeated values (authors, due dates) are interned so every copy shares one string.
+// Pointers stay valid until reset(). A mapped snapshot can also be handed to the pool so its
+// strings are used in place and unmapped on reset().
+class TextPool {
+private:
+    // Hash and compare interned strings by content
+    struct TextHash {
+        size_t operator()(const char* text) const;
+    };
+    struct TextEqual {
+        bool operator()(const char* a, const char* b) const { return strcmp(a, b) == 0; }
+    };
+
+    vector<char*> blocks;
+    vector<size_t> blockSizes; // Size of each block in blocks
+    size_t blockUsed;      // Bytes used in the last block
+    size_t blockSize;      // Size of the last block
+    size_t totalBytes;     // Bytes allocated for all blocks
+    unordered_set<const char*, TextHash, TextEqual> interned;
+    vector<pair<void*, size_t> > mappings; // Adopted memory maps (address, length)
+    size_t mappedBytes;
+
+    char* allocate(size_t length);
+
+public:
+    TextPool();
+    TextPool(const TextPool&) = delete; // Blocks are owned by the pool, so it cannot be copied
+    TextPool& operator=(const TextPool&) = delete;
+    ~TextPool();
+
+    // Copy text into the arena
+    const char* store(const string &text);
+
+    // Return the pooled copy of text, adding it the first time it is seen
+    const char* intern(const string &text);
+
+    // Take ownership of a memory map or a new[] buffer whose strings are used in place
+    void adoptMapping(void* address, size_t length);
+    void adoptBuffer(char* buffer, size_t size);
+
+    // Make text that already lives in adopted memory the interned copy of its value
+    const char* adopt(const char* text);
+
+    // Whether text points into one of the pool's blocks or adopted mappings
+    bool owns(const char* text) const;
+
+    // Free every block and unmap every adopted mapping (all pointers handed out become invalid)
+    void reset();
+
+    size_t bytesAllocated() const;
+    size_t bytesMapped() const;
+    size_t internedCount() const;
+};
+
+#endif
@@ -1,44 +1,45 @@
 /* Program name: Transaction.h
 * Author: Joshua Yin
-* Date last updated: 7/24/2024
-* Purpose: Define the transaction class
+* Date last updated: 10/17/2026
+* Purpose: Define the transaction record (one borrow or return in the history)
 */
 
 #ifndef TRANSACTION_H
 #define TRANSACTION_H
 
+#include <cstdint>
 #include <ctime>
-#include <iostream>
-#include <stdexcept>
 #include <string>
 
-#include "Book.h"
+#include "EpochDay.h"
+#include "Isbn.h"
 
 using namespace std;
 
-class Transaction {
-protected:
-    string ISBN;
-    int memberID;
-    time_t transactionDate; // Time of transaction
-
-public:
-    Transaction(const string &ISBN, const int &memberID);
-
-    virtual void process_transaction() = 0;
-
-    // Getters
-    virtual const Book& getBook() const = 0; // Pure virtual function because base class does not have its own book
-    int getMemberID() const;
-    time_t getTransactionDate() const;
+enum TransactionType : uint8_t {
+    BORROW_TRANSACTION,
+    RETURN_TRANSACTION
+};
 
-    // Setters
-    void setTransactionDate(const string &transactionDate);
+// One borrow or return. Transactions are plain 32-byte values kept in order in a TransactionPool, so scans
+// and saves read them in order without following pointers or checking types at run time. The
+// ISBN is held by value (history outlives the book, which may be deleted).
+struct Transaction {
+    time_t transactionDate;
+    Isbn isbn;
+    int32_t dueDay;       // Epoch day, borrows only (NO_DUE_DATE for returns)
+    int32_t memberID;
+    TransactionType type;
+
+    bool isBorrow() const { return type == BORROW_TRANSACTION; }
+    string getDueDateText() const; // YYYY-MM-DD ("" for returns)
+    void display() const;
+};
 
-    // Virtual function to display transaction details
-    virtual void display() const;
+static_assert(sizeof(Transaction) <= 32, "Transaction records must stay small enough to scan quickly");
 
-    virtual ~Transaction();
-};
+// Build a borrow (due 14 days after the local day it is made) or a return, made at a given time
+Transaction makeBorrow(const Isbn &isbn, int memberID, time_t transactionDate);
+Transaction makeReturn(const Isbn &isbn, int memberID, time_t transactionDate);
 
 #endif
@@ -0,0 +1,82 @@
+/* Program name: TransactionPool.h
+* Author: Joshua Yin
+* Date last updated: 10/18/2026
+* Purpose: Define the transaction pool class (block storage for the recent transaction history)
+*/
+
+#ifndef TRANSACTIONPOOL_H
+#define TRANSACTIONPOOL_H
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "Transaction.h"
+
+using namespace std;
+
+// The recent history, oldest first, in fixed blocks of transaction records owned by the library.
+// New transactions go at the end of the last block, so adding one never moves the others and
+// only allocates once per block. Archiving drops the oldest transactions, freeing each block as
+// it empties, and clearing the history frees every block at once.
+class TransactionPool {
+private:
+    static const size_t BLOCK_RECORDS = 1024; // Transactions per block
+
+    vector<vector<Transaction> > blocks; // Each reserved to BLOCK_RECORDS, so records never move
+    size_t first;                        // Position of the oldest transaction in the first block
+    size_t count;
+
+public:
+    // Iterator over the transactions, oldest first
+    class const_iterator {
+    private:
+        const TransactionPool* pool;
+        size_t index;
+
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef Transaction value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const Transaction* pointer;
+        typedef const Transaction& reference;
+
+        const_iterator(const TransactionPool* pool, size_t index) : pool(pool), index(index) {}
+
+        const Transaction& operator*() const { return (*pool)[index]; }
+        const Transaction* operator->() const { return &(*pool)[index]; }
+
+        const_iterator& operator++() { ++index; return *this; }
+        const_iterator operator++(int) { const_iterator old = *this; ++index; return old; }
+        bool operator==(const const_iterator &other) const { return index == other.index; }
+        bool operator!=(const const_iterator &other) const { return index != other.index; }
+    };
+    typedef const_iterator iterator;
+
+    TransactionPool();
+    TransactionPool(const TransactionPool &other); // Copies into blocks of their own
+    TransactionPool& operator=(const TransactionPool &other);
+
+    // Add a transaction after the newest one
+    void push_back(const Transaction &transaction);
+
+    // Drop the oldest count transactions (at most size()), freeing the blocks they filled
+    void dropFront(size_t count);
+
+    // Free every block
+    void clear();
+    void swap(TransactionPool &other);
+
+    const Transaction& operator[](size_t index) const {
+        size_t position = first + index;
+        return blocks[position / BLOCK_RECORDS][position % BLOCK_RECORDS];
+    }
+    size_t size() const;
+    bool empty() const;
+    size_t bytesAllocated() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+};
+
+#endif
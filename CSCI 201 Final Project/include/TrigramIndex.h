@@ -0,0 +1,45 @@
+/* Program name: TrigramIndex.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the trigram index class (finds indexed words within a small edit distance of a typo)
+*/
+
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+class TrigramIndex {
+private:
+    vector<string> words;                                 // Word ID -> word (empty once removed)
+    vector<uint32_t> freeIds;                             // IDs of removed words, reused first
+    unordered_map<string, uint32_t> wordIds;              // Word -> word ID
+    unordered_map<uint32_t, vector<uint32_t> > postings;  // Packed trigram -> IDs of words containing it
+
+public:
+    // A word's distinct trigrams, packed into integers and sorted
+    static vector<uint32_t> trigrams(const string &word);
+
+    // Largest number of typos tolerated in a word of the given length
+    static int maxTypos(size_t length);
+
+    // Edit distance between a and b, or bound + 1 as soon as it must be larger than bound
+    static int boundedEditDistance(const string &a, const string &b, int bound);
+
+    // Keep the vocabulary in sync (words are already normalized)
+    void add(const string &word);
+    void remove(const string &word);
+    void clear();
+
+    // Indexed words within maxDistance edits of word, closest first
+    vector<pair<string, int> > similarWords(const string &word, int maxDistance, size_t limit) const;
+};
+
+#endif
@@ -1,6 +1,6 @@
 /* Program name: Book.cpp
 * Author: Joshua Yin
-* Date last updated: 7/24/2024
+* Date last updated: 10/17/2026
 * Purpose: Implement the book class methods
 */
 
@@ -25,28 +25,37 @@ map<genreType, string> genreNames = {
     {SCIENCE_FICTION, "Science Fiction"}
 };
 
-Book::Book(string t, string a, string i, int p, string c, genreType g)
-    : title(t), author(a), ISBN(i), pubDate(p), callNum(c), genre(g), isBorrowed(false), dueDate("None") {}
+Book::Book(TextPool &text, string t, string a, const Isbn &i, int p, string c, genreType g)
+    : title(text.store(t)), author(text.intern(a)), ISBN(i), pubDate(p),
+      callNum(text.store(c)), genre(g), isBorrowed(false), dueDay(NO_DUE_DATE) {}
+
+Book::Book(const char* t, const char* a, const Isbn &i, int p, const char* c, genreType g, bool b, int32_t d)
+    : title(t), author(a), ISBN(i), pubDate(p), callNum(c), genre(g), isBorrowed(b), dueDay(d) {}
+
+Book Book::fromPooledText(const char* t, const char* a, const Isbn &i, int p, const char* c, genreType g, bool b, int32_t d) {
+    return Book(t, a, i, p, c, g, b, d);
+}
 
 // Getters
-string Book::getTitle() const { return title; }
-string Book::getAuthor() const { return author; }
-string Book::getISBN() const { return ISBN; }
+const char* Book::getTitle() const { return title; }
+const char* Book::getAuthor() const { return author; }
+const Isbn& Book::getISBN() const { return ISBN; }
 int Book::getPubDate() const { return pubDate; }
-string Book::getCallNum() const {return callNum; }
+const char* Book::getCallNum() const { return callNum; }
 genreType Book::getGenre() const { return genre; }
 bool Book::getIsBorrowed() const { return isBorrowed; }
-string Book::getDueDate() const { return dueDate; }
+int32_t Book::getDueDay() const { return dueDay; }
+string Book::getDueDate() const { return formatDueDate(dueDay); }
 
 // Setters
-void Book::setTitle(const string &t) { title = t; }
-void Book::setAuthor(const string &a) { author = a; }
-void Book::setISBN(const string &i) { ISBN = i; }
+void Book::setTitle(TextPool &text, const string &t) { title = text.store(t); }
+void Book::setAuthor(TextPool &text, const string &a) { author = text.intern(a); }
+void Book::setISBN(const Isbn &i) { ISBN = i; }
 void Book::setPubDate(const int &p) { pubDate = p; }
-void Book::setCallNum(const string &c) { callNum = c; }
+void Book::setCallNum(TextPool &text, const string &c) { callNum = text.store(c); }
 void Book::setGenre(genreType g) { genre = g; }
 void Book::setIsBorrowed(bool b) { isBorrowed = b; }
-void Book::setDueDate(const string &d) { dueDate = d; }
+void Book::setDueDay(int32_t d) { dueDay = d; }
 
 // Display book details
 void Book::display() const {
@@ -58,5 +67,5 @@ void Book::display() const {
         << "Publication Date: " << pubDate << "\n"
         << "Call Number: " << callNum << "\n"
         << "Borrowed: " << (isBorrowed ? "Yes" : "No") << "\n"
-        << "Due Date: " << dueDate << endl;
+        << "Due Date: " << getDueDate() << endl;
 }
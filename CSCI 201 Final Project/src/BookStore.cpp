@@ -0,0 +1,250 @@
+/* Program name: BookStore.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the book store class methods
+*/
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "BookStore.h"
+
+using namespace std;
+
+namespace {
+  const uint8_t NO_GENRE = 0xFF; // Genre column value of a free slot, so it never matches a genre
+  const uint32_t NO_SLOT = UINT32_MAX; // End of a due list
+}
+
+BookStore::BookStore() : count(0) {}
+
+/* Column Helpers */
+void BookStore::setBit(vector<uint64_t> &bits, uint32_t slot, bool value) {
+    uint64_t mask = uint64_t(1) << (slot % 64);
+    if (value) {
+        bits[slot / 64] |= mask;
+    } else {
+        bits[slot / 64] &= ~mask;
+    }
+}
+
+void BookStore::writeColumns(uint32_t slot, const Book &book) {
+    genres[slot] = static_cast<uint8_t>(book.getGenre());
+    pubDates[slot] = book.getPubDate();
+    setBit(occupied, slot, true);
+    setBit(available, slot, !book.getIsBorrowed());
+    unlinkDue(slot);
+    if (book.getIsBorrowed()) {
+        linkDue(slot, book.getDueDay());
+    }
+}
+
+// Add a slot to the end of its due day's list
+void BookStore::linkDue(uint32_t slot, int32_t dueDay) {
+    if (dueDay == NO_DUE_DATE) {
+        return;
+    }
+    dueDays[slot] = dueDay;
+    dueNext[slot] = NO_SLOT;
+    map<int32_t, DueList>::iterator list = dueLists.find(dueDay);
+    if (list == dueLists.end()) {
+        duePrev[slot] = NO_SLOT;
+        DueList added = { slot, slot };
+        dueLists.insert(make_pair(dueDay, added));
+    } else {
+        duePrev[slot] = list->second.last;
+        dueNext[list->second.last] = slot;
+        list->second.last = slot;
+    }
+}
+
+// Take a slot out of its due day's list (dropping the day once its list is empty)
+void BookStore::unlinkDue(uint32_t slot) {
+    if (dueDays[slot] == NO_DUE_DATE) {
+        return;
+    }
+    map<int32_t, DueList>::iterator list = dueLists.find(dueDays[slot]);
+    uint32_t next = dueNext[slot], prev = duePrev[slot];
+    if (prev == NO_SLOT && next == NO_SLOT) {
+        dueLists.erase(list);
+    } else {
+        if (prev == NO_SLOT) {
+            list->second.first = next;
+        } else {
+            dueNext[prev] = next;
+        }
+        if (next == NO_SLOT) {
+            list->second.last = prev;
+        } else {
+            duePrev[next] = prev;
+        }
+    }
+    dueDays[slot] = NO_DUE_DATE;
+}
+
+// Bit mask of the slots in one 64-slot word whose genre matches (a branch-free loop over bytes the compiler can vectorize)
+uint64_t BookStore::genreMask(size_t word, genreType genre) const {
+    size_t first = word * 64;
+    size_t last = first + 64 < genres.size() ? first + 64 : genres.size();
+    uint64_t mask = 0;
+    for (size_t slot = first; slot < last; ++slot) {
+        mask |= static_cast<uint64_t>(genres[slot] == genre) << (slot - first);
+    }
+    return mask;
+}
+
+// Insert a book, reusing a freed slot if there is one
+BookHandle BookStore::insert(const Book &book) {
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        slots[slot] = book;
+    } else {
+        slot = static_cast<uint32_t>(slots.size());
+        slots.push_back(book);
+        generations.push_back(0);
+        genres.push_back(NO_GENRE);
+        pubDates.push_back(0);
+        dueDays.push_back(NO_DUE_DATE);
+        dueNext.push_back(NO_SLOT);
+        duePrev.push_back(NO_SLOT);
+        if (slot % 64 == 0) {
+            occupied.push_back(0);
+            available.push_back(0);
+        }
+    }
+    writeColumns(slot, book);
+    ++count;
+    return BookHandle(slot, generations[slot]);
+}
+
+// Free the slot and bump its generation so existing handles go stale
+bool BookStore::erase(BookHandle handle) {
+    if (!contains(handle)) {
+        return false;
+    }
+    genres[handle.index] = NO_GENRE;
+    setBit(occupied, handle.index, false);
+    setBit(available, handle.index, false);
+    unlinkDue(handle.index);
+    ++generations[handle.index];
+    freeSlots.push_back(handle.index);
+    --count;
+    return true;
+}
+
+void BookStore::clear() {
+    slots.clear();
+    generations.clear();
+    freeSlots.clear();
+    genres.clear();
+    pubDates.clear();
+    dueDays.clear();
+    dueNext.clear();
+    duePrev.clear();
+    dueLists.clear();
+    occupied.clear();
+    available.clear();
+    count = 0;
+}
+
+void BookStore::reserve(size_t capacity) {
+    slots.reserve(capacity);
+    generations.reserve(capacity);
+    genres.reserve(capacity);
+    pubDates.reserve(capacity);
+    dueDays.reserve(capacity);
+    dueNext.reserve(capacity);
+    duePrev.reserve(capacity);
+    occupied.reserve((capacity + 63) / 64);
+    available.reserve((capacity + 63) / 64);
+}
+
+// Updates
+bool BookStore::replace(BookHandle handle, const Book &book) {
+    if (!contains(handle)) {
+        return false;
+    }
+    slots[handle.index] = book;
+    writeColumns(handle.index, book);
+    return true;
+}
+
+bool BookStore::setBorrowed(BookHandle handle, bool isBorrowed, int32_t dueDay) {
+    if (!contains(handle)) {
+        return false;
+    }
+    slots[handle.index].setIsBorrowed(isBorrowed);
+    slots[handle.index].setDueDay(dueDay);
+    setBit(available, handle.index, !isBorrowed);
+    unlinkDue(handle.index);
+    if (isBorrowed) {
+        linkDue(handle.index, dueDay);
+    }
+    return true;
+}
+
+// Access
+bool BookStore::contains(BookHandle handle) const {
+    return handle.index < slots.size() && testBit(occupied, handle.index) && generations[handle.index] == handle.generation;
+}
+
+const Book* BookStore::get(BookHandle handle) const { return contains(handle) ? &slots[handle.index] : nullptr; }
+size_t BookStore::size() const { return count; }
+bool BookStore::empty() const { return count == 0; }
+
+// Column scans
+size_t BookStore::countAvailable() const {
+    size_t total = 0;
+    for (size_t word = 0; word < available.size(); ++word) {
+        total += __builtin_popcountll(available[word]);
+    }
+    return total;
+}
+
+size_t BookStore::countGenre(genreType genre) const {
+    size_t total = 0;
+    for (size_t slot = 0; slot < genres.size(); ++slot) {
+        total += genres[slot] == genre;
+    }
+    return total;
+}
+
+size_t BookStore::countAvailable(genreType genre) const {
+    size_t total = 0;
+    for (size_t word = 0; word < available.size(); ++word) {
+        total += __builtin_popcountll(available[word] & genreMask(word, genre));
+    }
+    return total;
+}
+
+vector<BookHandle> BookStore::findAvailable(genreType genre) const {
+    vector<BookHandle> found;
+    for (size_t word = 0; word < available.size(); ++word) {
+        uint64_t matches = available[word] & genreMask(word, genre);
+        while (matches) {
+            uint32_t slot = static_cast<uint32_t>(word * 64 + __builtin_ctzll(matches));
+            found.push_back(BookHandle(slot, generations[slot]));
+            matches &= matches - 1; // Clear lowest set bit
+        }
+    }
+    return found;
+}
+
+// Walk the day lists in range (days with nothing due have no entry, so they cost nothing)
+vector<BookHandle> BookStore::findDue(int32_t fromDay, int32_t toDay) const {
+    vector<BookHandle> found;
+    for (map<int32_t, DueList>::const_iterator list = dueLists.lower_bound(fromDay);
+         list != dueLists.end() && list->first <= toDay; ++list) {
+        for (uint32_t slot = list->second.first; slot != NO_SLOT; slot = dueNext[slot]) {
+            found.push_back(BookHandle(slot, generations[slot]));
+        }
+    }
+    return found;
+}
+
+BookStore::const_iterator BookStore::begin() const { return const_iterator(this, 0); }
+BookStore::const_iterator BookStore::end() const { return const_iterator(this, static_cast<uint32_t>(slots.size())); }
@@ -0,0 +1,617 @@
+/* Program name: CatalogView.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the catalog view class methods
+*/
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "CatalogView.h"
+#include "SearchQuery.h"
+#include "TrigramIndex.h"
+
+using namespace std;
+
+/* Helper Functions */
+namespace {
+    // Books keep their due date as text in the snapshot ("None" or YYYY-MM-DD)
+    int32_t snapshotDueDay(const char* text) {
+        int32_t dueDay;
+        if (!parseDueDate(text, dueDay)) {
+            throw runtime_error(string("Invalid due date in snapshot: ") + text);
+        }
+        return dueDay;
+    }
+
+    // ISBNs are kept as text in the snapshot
+    Isbn snapshotIsbn(const char* text) {
+        Isbn isbn;
+        if (!Isbn::parseSaved(text, isbn)) {
+            throw runtime_error(string("Invalid ISBN in snapshot: ") + text);
+        }
+        return isbn;
+    }
+}
+
+struct stat CatalogView::statFile(const string &filename) {
+    struct stat info;
+    if (stat(filename.c_str(), &info) != 0) {
+        memset(&info, 0, sizeof(info));
+    }
+    return info;
+}
+
+// Best matches first, then catalog order (changed books after the catalog's)
+bool CatalogView::hitBefore(const Hit &a, const Hit &b) {
+    if (a.score != b.score) {
+        return a.score > b.score;
+    }
+    if ((a.changed != nullptr) != (b.changed != nullptr)) {
+        return a.changed == nullptr;
+    }
+    return a.number < b.number;
+}
+
+// The file is looked at before it is mapped, so a save in between only makes it look stale
+CatalogView::CatalogView(const string &filename)
+    : opened(statFile(filename)), snapshot(filename), filename(filename), records(nullptr), recordCount(0),
+      words(nullptr), wordCount(0), postings(nullptr), postingCount(0), trigrams(nullptr), trigramCount(0),
+      trigramWords(nullptr), trigramWordCount(0), isbnOrder(nullptr), dateOrder(nullptr), bookCount(0) {
+    size_t isbnCount, dateCount;
+    records = snapshot.records<BookRecord>(0, BOOK_SECTION, recordCount);
+    words = snapshot.records<CatalogWordRecord>(0, CATALOG_WORD_SECTION, wordCount);
+    postings = snapshot.records<uint32_t>(0, CATALOG_POSTING_SECTION, postingCount);
+    trigrams = snapshot.records<CatalogTrigramRecord>(0, CATALOG_TRIGRAM_SECTION, trigramCount);
+    trigramWords = snapshot.records<uint32_t>(0, CATALOG_TRIGRAM_WORD_SECTION, trigramWordCount);
+    isbnOrder = snapshot.records<uint32_t>(0, CATALOG_ISBN_ORDER_SECTION, isbnCount);
+    dateOrder = snapshot.records<uint32_t>(0, CATALOG_DATE_ORDER_SECTION, dateCount);
+    if (!words || !postings || !trigrams || !trigramWords || !isbnOrder || !dateOrder) {
+        throw runtime_error("Snapshot has no catalog index");
+    }
+    if (isbnCount != recordCount || dateCount != recordCount) {
+        throw runtime_error("Snapshot catalog index does not match its books");
+    }
+
+    for (size_t segment = 1; segment < snapshot.segmentCount(); ++segment) {
+        applyDelta(segment);
+    }
+
+    bookCount = recordCount + changedBooks.size();
+    uint32_t number;
+    for (unordered_set<Isbn>::const_iterator it = replaced.begin(); it != replaced.end(); ++it) {
+        if (findNumber(*it, number)) {
+            --bookCount;
+        }
+    }
+}
+
+// Copy the books a delta segment changed (deleted ones first, as when a library loads it)
+void CatalogView::applyDelta(size_t segment) {
+    size_t count;
+    const uint32_t* deletedBooks = snapshot.records<uint32_t>(segment, DELETED_BOOK_SECTION, count);
+    for (size_t i = 0; i < count; ++i) {
+        Isbn isbn = snapshotIsbn(snapshot.text(segment, deletedBooks[i]));
+        removeChanged(isbn);
+        replaced.insert(isbn);
+    }
+    const BookRecord* bookRecords = snapshot.records<BookRecord>(segment, BOOK_SECTION, count);
+    for (size_t i = 0; i < count; ++i) {
+        const BookRecord &record = bookRecords[i];
+        if (record.genre > SCIENCE_FICTION) {
+            throw runtime_error("Unknown genre in snapshot");
+        }
+        Book book = Book::fromPooledText(snapshot.text(segment, record.title), snapshot.text(segment, record.author),
+            snapshotIsbn(snapshot.text(segment, record.isbn)), record.pubDate, snapshot.text(segment, record.callNum),
+            static_cast<genreType>(record.genre), record.isBorrowed != 0, snapshotDueDay(snapshot.text(segment, record.dueDate)));
+        removeChanged(book.getISBN());
+        replaced.insert(book.getISBN());
+        BookHandle handle = changedBooks.insert(book);
+        changedIndex[book.getISBN()] = handle;
+        changedText.add(handle, book);
+        changedFilter.add(handle, book);
+    }
+}
+
+void CatalogView::removeChanged(const Isbn &isbn) {
+    unordered_map<Isbn, BookHandle>::iterator it = changedIndex.find(isbn);
+    if (it == changedIndex.end()) {
+        return;
+    }
+    const Book &book = *changedBooks.get(it->second);
+    changedText.remove(it->second, book);
+    changedFilter.remove(it->second, book);
+    changedBooks.erase(it->second);
+    changedIndex.erase(it);
+}
+
+// Build a book around a record's text in the mapped file (nothing is copied; the ISBN is parsed)
+Book CatalogView::bookAt(uint32_t number) const {
+    if (number >= recordCount) {
+        throw runtime_error("Snapshot catalog index is out of range");
+    }
+    const BookRecord &record = records[number];
+    if (record.genre > SCIENCE_FICTION) {
+        throw runtime_error("Unknown genre in snapshot");
+    }
+    return Book::fromPooledText(snapshot.text(0, record.title), snapshot.text(0, record.author), snapshotIsbn(snapshot.text(0, record.isbn)),
+        record.pubDate, snapshot.text(0, record.callNum), static_cast<genreType>(record.genre), record.isBorrowed != 0,
+        snapshotDueDay(snapshot.text(0, record.dueDate)));
+}
+
+// Check that a catalog book has not been changed or deleted by a later delta
+bool CatalogView::isCurrent(uint32_t number) const {
+    if (number >= recordCount) {
+        throw runtime_error("Snapshot catalog index is out of range");
+    }
+    return replaced.empty() || !replaced.count(snapshotIsbn(snapshot.text(0, records[number].isbn)));
+}
+
+const char* CatalogView::wordAt(size_t word) const {
+    return snapshot.text(0, words[word].word);
+}
+
+// Words are sorted, so the ones starting with a prefix are a range found by two binary searches
+pair<size_t, size_t> CatalogView::prefixRange(const string &prefix) const {
+    size_t low = 0, high = wordCount;
+    while (low < high) { // First word not before the prefix
+        size_t middle = low + (high - low) / 2;
+        if (strncmp(wordAt(middle), prefix.c_str(), prefix.size()) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    size_t first = low;
+    high = wordCount;
+    while (low < high) { // First word after every word with the prefix
+        size_t middle = low + (high - low) / 2;
+        if (strncmp(wordAt(middle), prefix.c_str(), prefix.size()) <= 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return make_pair(first, low);
+}
+
+// Catalog words within maxDistance edits of word, closest first (the same test as TrigramIndex)
+vector<CatalogView::WordMatch> CatalogView::similarWords(const string &word, int maxDistance, size_t limit) const {
+    vector<uint32_t> grams = TrigramIndex::trigrams(word);
+    unordered_map<uint32_t, int> shared; // Word number -> trigrams shared with the query
+    for (size_t i = 0; i < grams.size(); ++i) {
+        const CatalogTrigramRecord* found = lower_bound(trigrams, trigrams + trigramCount, grams[i],
+            [](const CatalogTrigramRecord &record, uint32_t gram) { return record.trigram < gram; });
+        if (found == trigrams + trigramCount || found->trigram != grams[i]) {
+            continue;
+        }
+        if (found->firstWord > trigramWordCount || found->wordCount > trigramWordCount - found->firstWord) {
+            throw runtime_error("Snapshot catalog index is out of range");
+        }
+        for (uint32_t j = 0; j < found->wordCount; ++j) {
+            ++shared[trigramWords[found->firstWord + j]];
+        }
+    }
+
+    int needed = static_cast<int>(word.size()) + 2 - 3 * maxDistance; // Each edit destroys at most three trigrams
+    vector<pair<int, size_t> > close; // (distance, word number); word numbers are in word order
+    for (unordered_map<uint32_t, int>::const_iterator it = shared.begin(); it != shared.end(); ++it) {
+        if (it->first >= wordCount) {
+            throw runtime_error("Snapshot catalog index is out of range");
+        }
+        string candidate = wordAt(it->first);
+        if (it->second < needed || abs(static_cast<int>(candidate.size()) - static_cast<int>(word.size())) > maxDistance) {
+            continue;
+        }
+        int distance = TrigramIndex::boundedEditDistance(word, candidate, maxDistance);
+        if (distance <= maxDistance) {
+            close.push_back(make_pair(distance, it->first));
+        }
+    }
+
+    size_t count = min(limit, close.size());
+    partial_sort(close.begin(), close.begin() + count, close.end());
+    vector<WordMatch> matches;
+    for (size_t i = 0; i < count; ++i) {
+        WordMatch match = { close[i].second, maxDistance + 1 - close[i].first }; // Fewer typos score higher
+        matches.push_back(match);
+    }
+    return matches;
+}
+
+// Fold one query word into the candidates, scored as SearchIndex does (title hits count double,
+// and only books that matched the earlier words are kept)
+void CatalogView::mergeWord(CandidateMap &candidates, const vector<WordMatch> &matches, unsigned char fields, bool firstWord) const {
+    unordered_map<uint32_t, int> best; // Book number -> best score for this word
+    for (size_t m = 0; m < matches.size(); ++m) {
+        const CatalogWordRecord &word = words[matches[m].word];
+        if (word.firstPosting > postingCount || word.postingCount > postingCount - word.firstPosting) {
+            throw runtime_error("Snapshot catalog index is out of range");
+        }
+        for (uint32_t p = word.firstPosting; p < word.firstPosting + word.postingCount; ++p) {
+            uint32_t number = postings[p] / 4;
+            unsigned char matched = static_cast<unsigned char>(postings[p] % 4) & fields;
+            if (matched == 0 || (!firstWord && !candidates.count(number))) {
+                continue;
+            }
+            int score = matches[m].weight * ((matched & TITLE_FIELD) ? 2 : 1);
+            int &current = best[number];
+            if (score > current) {
+                current = score;
+            }
+            if (firstWord) {
+                candidates.insert(make_pair(number, 0));
+            }
+        }
+    }
+
+    for (CandidateMap::iterator c = candidates.begin(); c != candidates.end();) {
+        unordered_map<uint32_t, int>::const_iterator hit = best.find(c->first);
+        if (hit == best.end()) {
+            c = candidates.erase(c);
+        } else {
+            c->second += hit->second;
+            ++c;
+        }
+    }
+}
+
+// Best limit hits among the catalog's candidates and the changed books' results
+vector<CatalogView::Hit> CatalogView::rank(const CandidateMap &candidates, const vector<SearchResult> &changed, size_t limit) const {
+    vector<Hit> hits;
+    hits.reserve(candidates.size() + changed.size());
+    for (CandidateMap::const_iterator c = candidates.begin(); c != candidates.end(); ++c) {
+        if (isCurrent(c->first)) {
+            Hit hit = { c->first, nullptr, c->second };
+            hits.push_back(hit);
+        }
+    }
+    for (size_t i = 0; i < changed.size(); ++i) {
+        Hit hit = { changed[i].book.index, changedBooks.get(changed[i].book), changed[i].score };
+        hits.push_back(hit);
+    }
+    size_t count = min(limit, hits.size());
+    partial_sort(hits.begin(), hits.begin() + count, hits.end(), hitBefore);
+    hits.resize(count);
+    return hits;
+}
+
+// Books containing every query word (each word may be a prefix), as SearchIndex::search
+vector<CatalogView::Hit> CatalogView::search(const string &query, unsigned char fields, size_t limit) const {
+    vector<string> terms = SearchIndex::tokenize(query);
+    CandidateMap candidates;
+
+    // Start from the query word with the fewest postings so the candidate set stays small
+    vector<pair<size_t, size_t> > ordered; // (postings, query word)
+    bool missing = terms.empty();
+    for (size_t i = 0; i < terms.size() && !missing; ++i) {
+        pair<size_t, size_t> range = prefixRange(terms[i]);
+        size_t volume = 0;
+        for (size_t w = range.first; w < range.second; ++w) {
+            volume += words[w].postingCount;
+        }
+        missing = volume == 0; // A word with no matches means no catalog book matches them all
+        ordered.push_back(make_pair(volume, i));
+    }
+    if (!missing) {
+        sort(ordered.begin(), ordered.end());
+        for (size_t w = 0; w < ordered.size() && (w == 0 || !candidates.empty()); ++w) {
+            const string &term = terms[ordered[w].second];
+            pair<size_t, size_t> range = prefixRange(term);
+            vector<WordMatch> matches;
+            for (size_t word = range.first; word < range.second; ++word) {
+                WordMatch match = { word, strlen(wordAt(word)) == term.size() ? 2 : 1 }; // Exact words beat prefixes
+                matches.push_back(match);
+            }
+            mergeWord(candidates, matches, fields, w == 0);
+        }
+    }
+    return rank(candidates, changedText.search(query, fields, limit), limit);
+}
+
+// Books with a word within a few typos of every query word, as SearchIndex::fuzzySearch
+vector<CatalogView::Hit> CatalogView::fuzzySearch(const string &query, unsigned char fields, size_t limit) const {
+    vector<string> terms = SearchIndex::tokenize(query);
+    CandidateMap candidates;
+    for (size_t w = 0; w < terms.size() && (w == 0 || !candidates.empty()); ++w) {
+        int maxDistance = TrigramIndex::maxTypos(terms[w].size());
+        mergeWord(candidates, similarWords(terms[w], maxDistance, 32), fields, w == 0);
+    }
+    return rank(candidates, changedText.fuzzySearch(query, fields, limit), limit);
+}
+
+// Catalog words starting with the last word of prefix, most common first (then the changed books')
+vector<string> CatalogView::complete(const string &prefix, size_t limit) const {
+    vector<string> terms = SearchIndex::tokenize(prefix);
+    pair<size_t, size_t> range = prefixRange(terms.empty() ? "" : terms.back());
+    vector<pair<uint32_t, size_t> > matches; // (postings, word number)
+    for (size_t w = range.first; w < range.second; ++w) {
+        matches.push_back(make_pair(words[w].postingCount, w));
+    }
+    size_t count = min(limit, matches.size());
+    partial_sort(matches.begin(), matches.begin() + count, matches.end(),
+        [](const pair<uint32_t, size_t> &a, const pair<uint32_t, size_t> &b) {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        });
+
+    vector<string> completions;
+    for (size_t i = 0; i < count; ++i) {
+        completions.push_back(wordAt(matches[i].second));
+    }
+    vector<string> changed = changedText.complete(prefix, limit);
+    for (size_t i = 0; i < changed.size() && completions.size() < limit; ++i) {
+        if (find(completions.begin(), completions.end(), changed[i]) == completions.end()) {
+            completions.push_back(changed[i]);
+        }
+    }
+    return completions;
+}
+
+// Books published in [fromYear, toYear] (of one genre if given), oldest first
+vector<CatalogView::Hit> CatalogView::findByDate(int fromYear, int toYear, const genreType* genre) const {
+    vector<Hit> hits;
+    const uint32_t* first = lower_bound(dateOrder, dateOrder + recordCount, fromYear, [this](uint32_t number, int year) {
+        if (number >= recordCount) {
+            throw runtime_error("Snapshot catalog index is out of range");
+        }
+        return records[number].pubDate < year;
+    });
+    for (const uint32_t* it = first; it != dateOrder + recordCount; ++it) {
+        if (*it >= recordCount) {
+            throw runtime_error("Snapshot catalog index is out of range");
+        }
+        const BookRecord &record = records[*it];
+        if (record.pubDate > toYear) {
+            break;
+        }
+        if ((!genre || record.genre == *genre) && isCurrent(*it)) {
+            Hit hit = { *it, nullptr, record.pubDate };
+            hits.push_back(hit);
+        }
+    }
+
+    vector<BookHandle> changed = genre ? changedFilter.findByGenre(*genre, fromYear, toYear) : changedFilter.findByPubDate(fromYear, toYear);
+    for (size_t i = 0; i < changed.size(); ++i) {
+        const Book* book = changedBooks.get(changed[i]);
+        Hit hit = { changed[i].index, book, book->getPubDate() };
+        hits.push_back(hit);
+    }
+    stable_sort(hits.begin(), hits.end(), [](const Hit &a, const Hit &b) { return a.score < b.score; }); // Score is the year here
+    return hits;
+}
+
+// Binary search of the ISBN order (whether or not a delta replaced the book since). The order
+// is by ISBN number, which legacy ISBNs' text does not follow, so each candidate is parsed.
+bool CatalogView::findNumber(const Isbn &isbn, uint32_t &number) const {
+    const uint32_t* found = lower_bound(isbnOrder, isbnOrder + recordCount, isbn, [this](uint32_t candidate, const Isbn &key) {
+        if (candidate >= recordCount) {
+            throw runtime_error("Snapshot catalog index is out of range");
+        }
+        return snapshotIsbn(snapshot.text(0, records[candidate].isbn)) < key;
+    });
+    if (found == isbnOrder + recordCount || snapshotIsbn(snapshot.text(0, records[*found].isbn)) != isbn) {
+        return false;
+    }
+    number = *found;
+    return true;
+}
+
+// Find a book by ISBN: changed books first, then the catalog
+bool CatalogView::findBook(const Isbn &isbn, Hit &hit) const {
+    hit.score = 0;
+    unordered_map<Isbn, BookHandle>::const_iterator changed = changedIndex.find(isbn);
+    if (changed != changedIndex.end()) {
+        hit.number = changed->second.index;
+        hit.changed = changedBooks.get(changed->second);
+        return true;
+    }
+    hit.changed = nullptr;
+    return !replaced.count(isbn) && findNumber(isbn, hit.number); // Replaced and not changed means deleted
+}
+
+void CatalogView::display(const Hit &hit) const {
+    if (hit.changed) {
+        hit.changed->display();
+    } else {
+        bookAt(hit.number).display();
+    }
+}
+
+void CatalogView::displayBooks() const {
+    if (size() == 0) {
+        cout << "The library has no books." << endl;
+        return;
+    }
+
+    cout << "Books in the Library:" << endl;
+    for (uint32_t number = 0; number < recordCount; ++number) {
+        if (isCurrent(number)) {
+            bookAt(number).display();
+        }
+    }
+    for (BookStore::const_iterator it = changedBooks.begin(); it != changedBooks.end(); ++it) {
+        it->display();
+    }
+}
+
+// Display book counts per genre (one pass over the catalog's records)
+void CatalogView::displayInventory() const {
+    size_t total[SCIENCE_FICTION + 1] = {}, available[SCIENCE_FICTION + 1] = {};
+    for (uint32_t number = 0; number < recordCount; ++number) {
+        const BookRecord &record = records[number];
+        if (record.genre <= SCIENCE_FICTION && isCurrent(number)) {
+            ++total[record.genre];
+            available[record.genre] += record.isBorrowed ? 0 : 1;
+        }
+    }
+
+    size_t allTotal = 0, allAvailable = 0;
+    cout << "Inventory Summary:" << endl;
+    for (map<genreType, string>::const_iterator it = genreNames.begin(); it != genreNames.end(); ++it) {
+        size_t genreTotal = total[it->first] + changedBooks.countGenre(it->first);
+        size_t genreAvailable = available[it->first] + changedBooks.countAvailable(it->first);
+        cout << it->second << ": " << genreTotal << " total, " << genreAvailable << " available, " << genreTotal - genreAvailable << " borrowed" << endl;
+        allTotal += genreTotal;
+        allAvailable += genreAvailable;
+    }
+    cout << "All genres: " << allTotal << " total, " << allAvailable << " available, " << allTotal - allAvailable << " borrowed" << endl;
+}
+
+void CatalogView::displayAvailableBooks(genreType genre) const {
+    bool found = false;
+    for (uint32_t number = 0; number < recordCount; ++number) {
+        const BookRecord &record = records[number];
+        if (record.genre == genre && !record.isBorrowed && isCurrent(number)) {
+            if (!found) {
+                cout << "Available " << genreNames.at(genre) << " Books:" << endl;
+                found = true;
+            }
+            bookAt(number).display();
+        }
+    }
+    vector<BookHandle> changed = changedBooks.findAvailable(genre);
+    for (size_t i = 0; i < changed.size(); ++i) {
+        if (!found) {
+            cout << "Available " << genreNames.at(genre) << " Books:" << endl;
+            found = true;
+        }
+        changedBooks.get(changed[i])->display();
+    }
+    if (!found) {
+        cout << "No " << genreNames.at(genre) << " books are available." << endl;
+    }
+}
+
+// Search the same ways Library::searchBook does, with the same output
+void CatalogView::searchBook(const string &query, const string &searchType) const {
+    cout << "Searching " << query << " by " << searchType << ":" << endl;
+
+    Isbn isbn;
+    bool isISBN = Isbn::parseSaved(query.c_str(), isbn);
+    if (searchType == "isbn") {
+        Hit hit;
+        if (isISBN && findBook(isbn, hit)) {
+            display(hit);
+        } else {
+            cout << "No book matching the query was found." << endl;
+        }
+        return;
+    }
+
+    if (searchType == "fuzzy") {
+        vector<Hit> hits = fuzzySearch(query, ALL_FIELDS, 10);
+        for (size_t i = 0; i < hits.size(); ++i) {
+            display(hits[i]);
+        }
+        if (hits.empty()) {
+            cout << "No book matching the query was found." << endl;
+        }
+        return;
+    }
+
+    if (searchType == "title" || searchType == "author" || searchType == "any") {
+        unsigned char fields = searchType == "title" ? TITLE_FIELD : searchType == "author" ? AUTHOR_FIELD : ALL_FIELDS;
+
+        // An exact ISBN match comes first for "any" searches
+        Hit byISBN;
+        bool hasISBN = searchType == "any" && isISBN && findBook(isbn, byISBN);
+        if (hasISBN) {
+            display(byISBN);
+        }
+
+        vector<Hit> hits = search(query, fields, size());
+        for (size_t i = 0; i < hits.size(); ++i) {
+            if (!hasISBN || hits[i].number != byISBN.number || hits[i].changed != byISBN.changed) {
+                display(hits[i]);
+            }
+        }
+
+        if (!hasISBN && hits.empty()) {
+            cout << "No book matching the query was found." << endl;
+
+            vector<string> suggestions = complete(query, 5);
+            if (!suggestions.empty() && !SearchIndex::tokenize(query).empty()) {
+                cout << "Did you mean:";
+                for (size_t i = 0; i < suggestions.size(); ++i) {
+                    cout << (i == 0 ? " " : ", ") << suggestions[i];
+                }
+                cout << endl;
+            }
+
+            vector<Hit> closest = fuzzySearch(query, fields, 5);
+            if (!closest.empty()) {
+                cout << "Closest matches:" << endl;
+                for (size_t i = 0; i < closest.size(); ++i) {
+                    Book book = closest[i].changed ? *closest[i].changed : bookAt(closest[i].number);
+                    cout << "  " << book.getTitle() << " by " << book.getAuthor() << " (ISBN: " << book.getISBN() << ")" << endl;
+                }
+            }
+        }
+        return;
+    }
+
+    vector<Hit> matches;
+    if (searchType == "genre") {
+        genreType genre;
+        if (parseGenreName(query, genre)) {
+            matches = findByDate(INT_MIN, INT_MAX, &genre);
+        }
+    } else if (searchType == "pubdate") {
+        int fromYear, toYear;
+        if (parseYearRange(query, fromYear, toYear)) {
+            matches = findByDate(fromYear, toYear, nullptr);
+        }
+    } else if (searchType == "callnumber") {
+        for (uint32_t number = 0; number < recordCount; ++number) {
+            if (snapshot.text(0, records[number].callNum) == query && isCurrent(number)) {
+                Hit hit = { number, nullptr, 0 };
+                matches.push_back(hit);
+            }
+        }
+        for (BookStore::const_iterator it = changedBooks.begin(); it != changedBooks.end(); ++it) {
+            if (it->getCallNum() == query) {
+                Hit hit = { it.handle().index, &*it, 0 };
+                matches.push_back(hit);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < matches.size(); ++i) {
+        display(matches[i]);
+    }
+    if (matches.empty()) {
+        cout << "No book matching the query was found." << endl;
+    }
+}
+
+void CatalogView::searchBookByGenreAndDate(genreType genre, int fromYear, int toYear) const {
+    cout << "Searching " << genreNames.at(genre) << " published " << fromYear << "-" << toYear << ":" << endl;
+
+    vector<Hit> matches = findByDate(fromYear, toYear, &genre);
+    for (size_t i = 0; i < matches.size(); ++i) {
+        display(matches[i]);
+    }
+    if (matches.empty()) {
+        cout << "No book matching the query was found." << endl;
+    }
+}
+
+size_t CatalogView::size() const { return bookCount; }
+
+// Saves either replace the file (a new inode) or append a delta to it (a new size)
+bool CatalogView::isStale() const {
+    struct stat now = statFile(filename);
+    return now.st_dev != opened.st_dev || now.st_ino != opened.st_ino || now.st_size != opened.st_size;
+}
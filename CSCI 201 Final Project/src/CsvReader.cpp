@@ -0,0 +1,101 @@
+/* Program name: CsvReader.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the CSV reader class methods
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CsvReader.h"
+
+using namespace std;
+
+CsvReader::CsvReader(const string &filename, char delimiter)
+    : fd(-1), delimiter(delimiter), buffer(BUFFER_SIZE), pos(0), end(0), line(0), recordLine(0), bytesRead(0), fileSize(0) {
+    fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("Unable to open " + filename + ": " + strerror(errno));
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0) {
+        fileSize = static_cast<uint64_t>(info.st_size);
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL); // Read ahead further (only a hint)
+}
+
+CsvReader::~CsvReader() {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+bool CsvReader::fill() {
+    while (true) {
+        ssize_t count = read(fd, buffer.data(), buffer.size());
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw runtime_error(string("Error reading file: ") + strerror(errno));
+        }
+        pos = 0;
+        end = static_cast<size_t>(count);
+        bytesRead += end;
+        return count > 0;
+    }
+}
+
+bool CsvReader::next(vector<string> &fields) {
+    fields.clear();
+    if (pos == end && !fill()) {
+        return false;
+    }
+    recordLine = ++line;
+
+    string field;
+    bool quoted = false;     // Inside a quoted field
+    bool fieldStart = true;  // Nothing read into this field yet (a quote here opens a quoted field)
+    while (pos < end || fill()) {
+        char c = buffer[pos++];
+        if (quoted) {
+            if (c != '"') {
+                if (c == '\n') {
+                    ++line;
+                }
+                field += c;
+            } else if ((pos < end || fill()) && buffer[pos] == '"') {
+                field += '"'; // "" inside quotes
+                ++pos;
+            } else {
+                quoted = false;
+            }
+        } else if (c == '"' && fieldStart) {
+            quoted = true;
+            fieldStart = false;
+        } else if (c == delimiter) {
+            fields.push_back(field);
+            field.clear();
+            fieldStart = true;
+        } else if (c == '\n') {
+            fields.push_back(field);
+            return true;
+        } else if (c != '\r') { // Windows line endings
+            field += c;
+            fieldStart = false;
+        }
+    }
+    fields.push_back(field); // The last line had no line break
+    return true;
+}
+
+size_t CsvReader::getLineNumber() const { return recordLine; }
+uint64_t CsvReader::getBytesRead() const { return bytesRead - (end - pos); }
+uint64_t CsvReader::getFileSize() const { return fileSize; }
@@ -0,0 +1,65 @@
+/* Program name: DurableFile.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the helpers used to write files so a crash never leaves one half written
+*/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "DurableFile.h"
+
+using namespace std;
+
+namespace {
+    void syncPath(const string &path, int flags) {
+        int fd = open(path.c_str(), flags);
+        if (fd < 0) {
+            throw runtime_error("Unable to open " + path + ": " + strerror(errno));
+        }
+        int result = fsync(fd);
+        int error = errno;
+        close(fd);
+        if (result != 0) {
+            throw runtime_error("Error flushing " + path + ": " + strerror(error));
+        }
+    }
+}
+
+string temporaryName(const string &filename) {
+    return filename + ".tmp";
+}
+
+void syncFile(const string &filename) {
+    syncPath(filename, O_RDONLY);
+}
+
+void syncDirectory(const string &filename) {
+    string::size_type slash = filename.rfind('/');
+    string directory = slash == string::npos ? "." : (slash == 0 ? "/" : filename.substr(0, slash));
+    syncPath(directory, O_RDONLY | O_DIRECTORY);
+}
+
+void replaceFile(const string &tempName, const string &filename) {
+    syncFile(tempName);
+    if (rename(tempName.c_str(), filename.c_str()) != 0) {
+        throw runtime_error("Unable to replace " + filename + ": " + strerror(errno));
+    }
+    syncDirectory(filename);
+}
+
+void removeFile(const string &filename) {
+    if (unlink(filename.c_str()) != 0) {
+        if (errno == ENOENT) {
+            return;
+        }
+        throw runtime_error("Unable to delete " + filename + ": " + strerror(errno));
+    }
+    syncDirectory(filename);
+}
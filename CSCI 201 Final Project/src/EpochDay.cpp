@@ -0,0 +1,98 @@
+/* Program name: EpochDay.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the epoch day functions
+*/
+
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+#include "EpochDay.h"
+
+using namespace std;
+
+// Days from 1970-01-01 in the proleptic Gregorian calendar, counted in 400-year eras
+// (each era is exactly 146097 days, so the calendar repeats)
+int32_t epochDayFromDate(int year, int month, int day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yearOfEra = year - era * 400;                                     // [0, 399]
+    int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1; // [0, 365], from March 1st
+    int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+void dateFromEpochDay(int32_t epochDay, int &year, int &month, int &day) {
+    int32_t days = epochDay + 719468;
+    int era = (days >= 0 ? days : days - 146096) / 146097;
+    int dayOfEra = days - era * 146097;
+    int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int shiftedMonth = (5 * dayOfYear + 2) / 153; // March is 0
+    day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    year = yearOfEra + era * 400 + (month <= 2);
+}
+
+int32_t localEpochDay(time_t time) {
+    tm local;
+    if (!localtime_r(&time, &local)) {
+        return 0;
+    }
+    return epochDayFromDate(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+}
+
+int32_t currentEpochDay() { return localEpochDay(time(nullptr)); }
+
+bool parseEpochDay(const char* text, int32_t &epochDay) {
+    if (strlen(text) != 10 || text[4] != '-' || text[7] != '-') {
+        return false;
+    }
+    int digits[10];
+    for (size_t i = 0; i < 10; ++i) {
+        if (i == 4 || i == 7) {
+            continue;
+        }
+        if (!isdigit(static_cast<unsigned char>(text[i]))) {
+            return false;
+        }
+        digits[i] = text[i] - '0';
+    }
+    int year = digits[0] * 1000 + digits[1] * 100 + digits[2] * 10 + digits[3];
+    int month = digits[5] * 10 + digits[6];
+    int day = digits[8] * 10 + digits[9];
+    if (month < 1 || month > 12 || day < 1) {
+        return false;
+    }
+
+    // Check the day against the length of the month
+    int nextYear, nextMonth, nextDay;
+    dateFromEpochDay(epochDayFromDate(year, month, day), nextYear, nextMonth, nextDay);
+    if (nextMonth != month || nextDay != day) {
+        return false;
+    }
+    epochDay = epochDayFromDate(year, month, day);
+    return true;
+}
+
+string formatEpochDay(int32_t epochDay) {
+    int year, month, day;
+    dateFromEpochDay(epochDay, year, month, day);
+    char buffer[40];
+    snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day);
+    return buffer;
+}
+
+bool parseDueDate(const char* text, int32_t &epochDay) {
+    if (strcmp(text, "None") == 0) {
+        epochDay = NO_DUE_DATE;
+        return true;
+    }
+    return parseEpochDay(text, epochDay);
+}
+
+string formatDueDate(int32_t epochDay) { return epochDay == NO_DUE_DATE ? "None" : formatEpochDay(epochDay); }
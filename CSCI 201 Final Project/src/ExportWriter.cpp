@@ -0,0 +1,238 @@
+/* Program name: ExportWriter.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the export writer class methods
+*/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "DurableFile.h"
+#include "ExportWriter.h"
+
+using namespace std;
+
+ExportWriter::ExportWriter(const string &filename, ExportFormat format)
+    : filename(filename), fd(-1), format(format), buffer(BUFFER_SIZE), used(0), column(0), records(0) {
+    if (filename == "-") {
+        fd = STDOUT_FILENO;
+        return;
+    }
+    tempName = temporaryName(filename);
+    fd = open(tempName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw runtime_error("Unable to create " + tempName + ": " + strerror(errno));
+    }
+}
+
+ExportWriter::~ExportWriter() {
+    if (!tempName.empty() && fd >= 0) {
+        close(fd);
+        unlink(tempName.c_str()); // Never finished, so the old file (if any) stays
+    }
+}
+
+ExportFormat ExportWriter::formatFor(const string &filename) {
+    const char* extensions[] = { ".jsonl", ".ndjson", ".json" };
+    for (size_t i = 0; i < 3; ++i) {
+        size_t length = strlen(extensions[i]);
+        if (filename.size() >= length && filename.compare(filename.size() - length, length, extensions[i]) == 0) {
+            return EXPORT_JSON_LINES;
+        }
+    }
+    return EXPORT_CSV;
+}
+
+void ExportWriter::put(const char* text, size_t length) {
+    if (used + length > buffer.size()) {
+        flush();
+    }
+    if (length > buffer.size()) {
+        buffer.resize(length); // Only for a single value bigger than the buffer
+    }
+    memcpy(buffer.data() + used, text, length);
+    used += length;
+}
+
+void ExportWriter::put(const string &text) {
+    put(text.data(), text.size());
+}
+
+void ExportWriter::put(char c) {
+    if (used == buffer.size()) {
+        flush();
+    }
+    buffer[used++] = c;
+}
+
+void ExportWriter::flush() {
+    size_t written = 0;
+    while (written < used) {
+        ssize_t count = write(fd, buffer.data() + written, used - written);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw runtime_error("Error writing " + filename + ": " + strerror(errno));
+        }
+        written += static_cast<size_t>(count);
+    }
+    used = 0;
+}
+
+void ExportWriter::begin(const vector<string> &columnNames) {
+    columns = columnNames;
+    column = 0;
+    if (format == EXPORT_CSV) {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (i > 0) {
+                put(',');
+            }
+            putEscaped(columns[i].c_str());
+        }
+        put('\n');
+    }
+}
+
+// Write what goes before a value: the separator, and for JSON the column's key
+void ExportWriter::startField() {
+    if (column >= columns.size()) {
+        throw logic_error("Export record has more values than columns");
+    }
+    if (format == EXPORT_CSV) {
+        if (column > 0) {
+            put(',');
+        }
+    } else {
+        put(column == 0 ? '{' : ',');
+        putEscaped(columns[column].c_str());
+        put(':');
+    }
+    ++column;
+}
+
+void ExportWriter::putEscaped(const char* text) {
+    if (format == EXPORT_CSV) {
+        size_t length = strlen(text);
+        if (strpbrk(text, ",\"\r\n") == nullptr) {
+            put(text, length);
+            return;
+        }
+        put('"');
+        for (const char* c = text; *c; ++c) {
+            if (*c == '"') {
+                put('"'); // "" stands for a quote
+            }
+            put(*c);
+        }
+        put('"');
+        return;
+    }
+
+    put('"');
+    const char* start = text; // Runs of characters that need no escaping are copied at once
+    for (const char* c = text; ; ++c) {
+        unsigned char ch = static_cast<unsigned char>(*c);
+        if (ch != 0 && ch >= 0x20 && ch != '"' && ch != '\\') {
+            continue;
+        }
+        put(start, static_cast<size_t>(c - start));
+        if (ch == 0) {
+            break;
+        }
+        if (ch == '"' || ch == '\\') {
+            put('\\');
+            put(static_cast<char>(ch));
+        } else if (ch == '\n') {
+            put("\\n", 2);
+        } else if (ch == '\t') {
+            put("\\t", 2);
+        } else {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", ch);
+            put(escape, 6);
+        }
+        start = c + 1;
+    }
+    put('"');
+}
+
+void ExportWriter::addText(const char* value) {
+    startField();
+    if (format == EXPORT_CSV && *value == '\0') {
+        return; // An empty CSV field is just nothing
+    }
+    putEscaped(value);
+}
+
+void ExportWriter::addText(const string &value) {
+    addText(value.c_str());
+}
+
+void ExportWriter::addNumber(long long value) {
+    startField();
+    char text[24];
+    int length = snprintf(text, sizeof(text), "%lld", value);
+    put(text, static_cast<size_t>(length));
+}
+
+void ExportWriter::addBool(bool value) {
+    startField();
+    if (value) {
+        put("true", 4);
+    } else {
+        put("false", 5);
+    }
+}
+
+void ExportWriter::addTime(time_t value) {
+    tm local;
+    char text[32];
+    size_t length = localtime_r(&value, &local) ? strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local) : 0;
+    text[length] = '\0';
+    addText(text);
+}
+
+void ExportWriter::endRecord() {
+    if (column != columns.size()) {
+        throw logic_error("Export record has fewer values than columns");
+    }
+    if (format == EXPORT_JSON_LINES) {
+        put('}');
+    }
+    put('\n');
+    column = 0;
+    ++records;
+}
+
+void ExportWriter::finish() {
+    flush();
+    if (tempName.empty()) {
+        return;
+    }
+    int result = close(fd);
+    fd = -1;
+    if (result != 0) {
+        int error = errno;
+        unlink(tempName.c_str());
+        throw runtime_error("Error writing " + filename + ": " + strerror(error));
+    }
+    try {
+        replaceFile(tempName, filename);
+    } catch (...) {
+        unlink(tempName.c_str());
+        throw;
+    }
+}
+
+size_t ExportWriter::getRecordCount() const {
+    return records;
+}
@@ -0,0 +1,61 @@
+/* Program name: FilterIndex.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the filter index class methods
+*/
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "FilterIndex.h"
+
+using namespace std;
+
+// Append the books in a date range of one ordered map (only matching entries are visited)
+void FilterIndex::collect(const DateMap &dates, int fromYear, int toYear, vector<BookHandle> &out) {
+    if (fromYear > toYear) {
+        return;
+    }
+    DateMap::const_iterator it = dates.lower_bound(DateKey(fromYear, 0));
+    DateMap::const_iterator end = dates.upper_bound(DateKey(toYear, UINT32_MAX));
+    for (; it != end; ++it) {
+        out.push_back(it->second);
+    }
+}
+
+// Keep the index in sync with the catalog
+void FilterIndex::add(BookHandle book, const Book &data) {
+    DateKey key(data.getPubDate(), book.index);
+    byPubDate[key] = book;
+    byGenre[data.getGenre()][key] = book;
+}
+
+void FilterIndex::remove(BookHandle book, const Book &data) {
+    DateKey key(data.getPubDate(), book.index);
+    byPubDate.erase(key);
+    byGenre[data.getGenre()].erase(key);
+}
+
+void FilterIndex::clear() {
+    byPubDate.clear();
+    for (size_t i = 0; i <= SCIENCE_FICTION; ++i) {
+        byGenre[i].clear();
+    }
+}
+
+// Queries
+vector<BookHandle> FilterIndex::findByPubDate(int fromYear, int toYear) const {
+    vector<BookHandle> found;
+    collect(byPubDate, fromYear, toYear, found);
+    return found;
+}
+
+vector<BookHandle> FilterIndex::findByGenre(genreType genre, int fromYear, int toYear) const {
+    vector<BookHandle> found;
+    collect(byGenre[genre], fromYear, toYear, found);
+    return found;
+}
+
+size_t FilterIndex::countGenre(genreType genre) const { return byGenre[genre].size(); }
@@ -0,0 +1,185 @@
+/* Program name: HistoryArchive.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the history archive class methods
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "HistoryArchive.h"
+
+using namespace std;
+
+namespace {
+    void putVarint(vector<uint8_t> &out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    uint64_t getVarint(const uint8_t* &pos, const uint8_t* end) {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos == end) {
+                break;
+            }
+            uint8_t byte = *pos++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        throw runtime_error("Archived history segment is corrupt");
+    }
+
+    // Zigzag encoding keeps small negative numbers small (0, -1, 1, -2 ... become 0, 1, 2, 3 ...)
+    uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    int64_t unzigzag(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+}
+
+HistoryArchive::HistoryArchive() : transactionCount(0), byteCount(0) {}
+
+HistoryArchive::~HistoryArchive() {
+    clear();
+}
+
+void HistoryArchive::seal(const HistoryRecord* records, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    // Number each distinct ISBN and due date in the order they are first seen
+    unordered_map<string, uint32_t> numbers;
+    vector<const char*> strings;
+    auto number = [&numbers, &strings](const char* text) {
+        pair<unordered_map<string, uint32_t>::iterator, bool> added =
+            numbers.insert(make_pair(string(text), static_cast<uint32_t>(strings.size())));
+        if (added.second) {
+            strings.push_back(text);
+        }
+        return added.first->second;
+    };
+
+    vector<uint32_t> isbnNumbers(count), dueDateNumbers(count);
+    int64_t minTime = records[0].transactionDate, maxTime = records[0].transactionDate;
+    for (size_t i = 0; i < count; ++i) {
+        isbnNumbers[i] = number(records[i].isbn);
+        if (records[i].isBorrow) {
+            dueDateNumbers[i] = number(records[i].dueDate);
+        }
+        minTime = min(minTime, static_cast<int64_t>(records[i].transactionDate));
+        maxTime = max(maxTime, static_cast<int64_t>(records[i].transactionDate));
+    }
+
+    vector<uint8_t> out;
+    putVarint(out, strings.size());
+    for (size_t i = 0; i < strings.size(); ++i) {
+        out.insert(out.end(), strings[i], strings[i] + strlen(strings[i]) + 1);
+    }
+    int64_t previous = minTime;
+    for (size_t i = 0; i < count; ++i) {
+        putVarint(out, static_cast<uint64_t>(isbnNumbers[i]) * 2 + (records[i].isBorrow ? 1 : 0));
+        putVarint(out, zigzag(records[i].memberID));
+        putVarint(out, zigzag(static_cast<int64_t>(records[i].transactionDate) - previous));
+        previous = records[i].transactionDate;
+        if (records[i].isBorrow) {
+            putVarint(out, dueDateNumbers[i]);
+        }
+    }
+
+    uint8_t* data = new uint8_t[out.size()];
+    memcpy(data, out.data(), out.size());
+    Segment segment = { { minTime, maxTime, static_cast<uint32_t>(count) }, data, out.size(), true };
+    segments.push_back(segment);
+    transactionCount += count;
+    byteCount += out.size();
+}
+
+void HistoryArchive::adopt(const SegmentInfo &info, const uint8_t* data, size_t size) {
+    if (info.count == 0 || info.count > size || info.minTime > info.maxTime) { // Every transaction takes at least a byte
+        throw runtime_error("Archived history segment is corrupt");
+    }
+    Segment segment = { info, data, size, false };
+    segments.push_back(segment);
+    transactionCount += info.count;
+    byteCount += size;
+}
+
+void HistoryArchive::clear() {
+    for (size_t i = 0; i < segments.size(); ++i) {
+        if (segments[i].owned) {
+            delete[] segments[i].data;
+        }
+    }
+    segments.clear();
+    transactionCount = 0;
+    byteCount = 0;
+}
+
+size_t HistoryArchive::segmentCount() const { return segments.size(); }
+size_t HistoryArchive::size() const { return transactionCount; }
+size_t HistoryArchive::bytes() const { return byteCount; }
+
+const HistoryArchive::SegmentInfo& HistoryArchive::getInfo(size_t segment) const {
+    return segments[segment].info;
+}
+
+const uint8_t* HistoryArchive::getData(size_t segment, size_t &size) const {
+    size = segments[segment].size;
+    return segments[segment].data;
+}
+
+void HistoryArchive::decode(size_t segment, vector<HistoryRecord> &records) const {
+    const Segment &source = segments[segment];
+    const uint8_t* pos = source.data;
+    const uint8_t* end = source.data + source.size;
+
+    // The string table
+    uint64_t stringCount = getVarint(pos, end);
+    if (stringCount > source.size) {
+        throw runtime_error("Archived history segment is corrupt");
+    }
+    vector<const char*> strings(static_cast<size_t>(stringCount));
+    for (size_t i = 0; i < strings.size(); ++i) {
+        const uint8_t* nul = static_cast<const uint8_t*>(memchr(pos, '\0', end - pos));
+        if (!nul) {
+            throw runtime_error("Archived history segment is corrupt");
+        }
+        strings[i] = reinterpret_cast<const char*>(pos);
+        pos = nul + 1;
+    }
+
+    // The transactions
+    records.resize(source.info.count);
+    int64_t previous = source.info.minTime;
+    for (size_t i = 0; i < records.size(); ++i) {
+        HistoryRecord &record = records[i];
+        uint64_t key = getVarint(pos, end);
+        uint64_t memberID = getVarint(pos, end);
+        previous = static_cast<int64_t>(static_cast<uint64_t>(previous) + unzigzag(getVarint(pos, end))); // Wraps instead of overflowing on bad data
+        bool isBorrow = (key & 1) != 0;
+        uint64_t dueDate = isBorrow ? getVarint(pos, end) : 0;
+        if (key / 2 >= strings.size() || (isBorrow && dueDate >= strings.size())) {
+            throw runtime_error("Archived history segment is corrupt");
+        }
+        record.isBorrow = isBorrow;
+        record.isbn = strings[key / 2];
+        record.memberID = static_cast<int>(unzigzag(memberID));
+        record.transactionDate = static_cast<time_t>(previous);
+        record.dueDate = record.isBorrow ? strings[dueDate] : nullptr;
+    }
+}
@@ -0,0 +1,155 @@
+/* Program name: HoldTable.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the hold table class methods
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "HoldTable.h"
+
+using namespace std;
+
+HoldTable::HoldTable() : count(0) {}
+
+// Join and leave queues
+size_t HoldTable::enqueue(const Isbn &ISBN, int memberID) {
+    unordered_map<Isbn, uint32_t> &memberHolds = holdsByMember[memberID];
+    if (memberHolds.count(ISBN)) {
+        return 0;
+    }
+
+    // Take a hold from the pool and add it to the back of the book's queue
+    uint32_t hold;
+    if (!freeHolds.empty()) {
+        hold = freeHolds.back();
+        freeHolds.pop_back();
+    } else {
+        hold = static_cast<uint32_t>(holds.size());
+        holds.push_back(Hold());
+    }
+    unordered_map<Isbn, Queue>::iterator queue = queues.find(ISBN);
+    if (queue == queues.end()) {
+        Queue added = { hold, hold, 0 };
+        queue = queues.insert(make_pair(ISBN, added)).first;
+        holds[hold].prev = NO_HOLD;
+    } else {
+        holds[hold].prev = queue->second.last;
+        holds[queue->second.last].next = hold;
+        queue->second.last = hold;
+    }
+    holds[hold].memberID = memberID;
+    holds[hold].next = NO_HOLD;
+    memberHolds[ISBN] = hold;
+    ++count;
+    return ++queue->second.length;
+}
+
+bool HoldTable::cancel(const Isbn &ISBN, int memberID) {
+    unordered_map<int, unordered_map<Isbn, uint32_t> >::iterator member = holdsByMember.find(memberID);
+    if (member == holdsByMember.end()) {
+        return false;
+    }
+    unordered_map<Isbn, uint32_t>::iterator held = member->second.find(ISBN);
+    if (held == member->second.end()) {
+        return false;
+    }
+    uint32_t hold = held->second;
+    member->second.erase(held);
+    if (member->second.empty()) {
+        holdsByMember.erase(member);
+    }
+
+    // Unlink the hold from its queue, dropping the queue once it is empty
+    unordered_map<Isbn, Queue>::iterator queue = queues.find(ISBN);
+    uint32_t prev = holds[hold].prev, next = holds[hold].next;
+    if (prev == NO_HOLD) {
+        queue->second.first = next;
+    } else {
+        holds[prev].next = next;
+    }
+    if (next == NO_HOLD) {
+        queue->second.last = prev;
+    } else {
+        holds[next].prev = prev;
+    }
+    if (--queue->second.length == 0) {
+        queues.erase(queue);
+    }
+    freeHolds.push_back(hold);
+    --count;
+    return true;
+}
+
+void HoldTable::cancelAll(const Isbn &ISBN) {
+    unordered_map<Isbn, Queue>::iterator queue = queues.find(ISBN);
+    if (queue == queues.end()) {
+        return;
+    }
+    for (uint32_t hold = queue->second.first; hold != NO_HOLD; hold = holds[hold].next) {
+        unordered_map<int, unordered_map<Isbn, uint32_t> >::iterator member = holdsByMember.find(holds[hold].memberID);
+        member->second.erase(ISBN);
+        if (member->second.empty()) {
+            holdsByMember.erase(member);
+        }
+        freeHolds.push_back(hold);
+        --count;
+    }
+    queues.erase(queue);
+}
+
+void HoldTable::clear() {
+    holds.clear();
+    freeHolds.clear();
+    queues.clear();
+    holdsByMember.clear();
+    count = 0;
+}
+
+// Queries
+bool HoldTable::isHeld(const Isbn &ISBN) const { return queues.count(ISBN) != 0; }
+
+int HoldTable::getNextInLine(const Isbn &ISBN) const {
+    unordered_map<Isbn, Queue>::const_iterator queue = queues.find(ISBN);
+    return queue != queues.end() ? holds[queue->second.first].memberID : -1;
+}
+
+bool HoldTable::hasHold(const Isbn &ISBN, int memberID) const {
+    unordered_map<int, unordered_map<Isbn, uint32_t> >::const_iterator member = holdsByMember.find(memberID);
+    return member != holdsByMember.end() && member->second.count(ISBN) != 0;
+}
+
+bool HoldTable::hasHolds(int memberID) const { return holdsByMember.count(memberID) != 0; }
+
+size_t HoldTable::getQueueLength(const Isbn &ISBN) const {
+    unordered_map<Isbn, Queue>::const_iterator queue = queues.find(ISBN);
+    return queue != queues.end() ? queue->second.length : 0;
+}
+
+vector<int> HoldTable::getQueue(const Isbn &ISBN) const {
+    vector<int> members;
+    unordered_map<Isbn, Queue>::const_iterator queue = queues.find(ISBN);
+    if (queue != queues.end()) {
+        members.reserve(queue->second.length);
+        for (uint32_t hold = queue->second.first; hold != NO_HOLD; hold = holds[hold].next) {
+            members.push_back(holds[hold].memberID);
+        }
+    }
+    return members;
+}
+
+vector<Isbn> HoldTable::getHeldBooks() const {
+    vector<Isbn> isbns;
+    isbns.reserve(queues.size());
+    for (unordered_map<Isbn, Queue>::const_iterator it = queues.begin(); it != queues.end(); ++it) {
+        isbns.push_back(it->first);
+    }
+    sort(isbns.begin(), isbns.end());
+    return isbns;
+}
+
+size_t HoldTable::size() const { return count; }
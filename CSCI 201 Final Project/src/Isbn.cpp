@@ -0,0 +1,167 @@
+/* Program name: Isbn.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the ISBN class methods
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "Isbn.h"
+
+using namespace std;
+
+namespace {
+    const uint64_t LEGACY_BIT = 1ULL << 63;
+    const uint64_t LEGACY_TEXT_BIT = 1ULL << 62;  // Set for letters; clear for a string of digits
+    const int LEGACY_DIGITS_SHIFT = 57;           // Digit count above the value (10^17 < 2^57)
+    const size_t LEGACY_MAX_DIGITS = 17;
+    const size_t LEGACY_MAX_CHARS = 10;           // 6 bits each, the first in the highest bits
+
+    // Characters a legacy text ISBN can hold, coded from 1 so 0 can mark the end of a short one
+    const char LEGACY_ALPHABET[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz-";
+
+    // Check digit of an ISBN-13 from its first 12 digits (weights alternate 1 and 3)
+    int isbn13CheckDigit(const int* digits) {
+        int sum = 0;
+        for (int i = 0; i < 12; ++i) {
+            sum += digits[i] * (i % 2 == 0 ? 1 : 3);
+        }
+        return (10 - sum % 10) % 10;
+    }
+}
+
+bool Isbn::normalize(const char* text, Isbn &isbn) {
+    // Collect the digits (an X may only end an ISBN-10, where it stands for 10)
+    int digits[13];
+    int length = 0;
+    for (const char* c = text; *c; ++c) {
+        if (*c == '-' || *c == ' ') {
+            continue;
+        }
+        if (length == 13) {
+            return false;
+        }
+        if (*c >= '0' && *c <= '9') {
+            digits[length++] = *c - '0';
+        } else if ((*c == 'X' || *c == 'x') && length == 9 && c[1] == '\0') {
+            digits[length++] = 10;
+        } else {
+            return false;
+        }
+    }
+
+    if (length == 10) {
+        int sum = 0;
+        for (int i = 0; i < 10; ++i) {
+            sum += digits[i] * (10 - i);
+        }
+        if (sum % 11 != 0) {
+            return false;
+        }
+
+        // The ISBN-13 is 978, the first 9 digits and a new check digit
+        for (int i = 8; i >= 0; --i) {
+            digits[i + 3] = digits[i];
+        }
+        digits[0] = 9;
+        digits[1] = 7;
+        digits[2] = 8;
+        digits[12] = isbn13CheckDigit(digits);
+    } else if (length == 13) {
+        if (digits[0] != 9 || digits[1] != 7 || (digits[2] != 8 && digits[2] != 9) || digits[12] != isbn13CheckDigit(digits)) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+
+    uint64_t value = 0;
+    for (int i = 0; i < 13; ++i) {
+        value = value * 10 + digits[i];
+    }
+    if (value == 0) {
+        return false;
+    }
+    isbn = Isbn(value);
+    return true;
+}
+
+// Keep text that is not an ISBN as it was written (false if it is too long or has other characters)
+bool Isbn::packLegacy(const char* text, Isbn &isbn) {
+    size_t length = strlen(text);
+    if (length <= LEGACY_MAX_DIGITS && strspn(text, "0123456789") == length) {
+        uint64_t number = 0;
+        for (size_t i = 0; i < length; ++i) {
+            number = number * 10 + static_cast<uint64_t>(text[i] - '0');
+        }
+        isbn = Isbn(LEGACY_BIT | (static_cast<uint64_t>(length) << LEGACY_DIGITS_SHIFT) | number);
+        return true;
+    }
+    if (length > LEGACY_MAX_CHARS) {
+        return false;
+    }
+    uint64_t codes = 0;
+    for (size_t i = 0; i < LEGACY_MAX_CHARS; ++i) {
+        uint64_t code = 0;
+        if (i < length) {
+            const char* found = strchr(LEGACY_ALPHABET, text[i]);
+            if (!found) {
+                return false;
+            }
+            code = static_cast<uint64_t>(found - LEGACY_ALPHABET) + 1;
+        }
+        codes = (codes << 6) | code;
+    }
+    isbn = Isbn(LEGACY_BIT | LEGACY_TEXT_BIT | codes);
+    return true;
+}
+
+bool Isbn::parse(const string &text, Isbn &isbn) { return normalize(text.c_str(), isbn); }
+bool Isbn::parseSaved(const char* text, Isbn &isbn) { return *text != '\0' && (normalize(text, isbn) || packLegacy(text, isbn)); }
+
+void Isbn::toChars(char* text) const {
+    if (isLegacy() && (value & LEGACY_TEXT_BIT)) {
+        size_t length = 0;
+        for (int shift = 6 * (LEGACY_MAX_CHARS - 1); shift >= 0; shift -= 6) {
+            uint64_t code = (value >> shift) & 0x3F;
+            if (code == 0) {
+                break;
+            }
+            text[length++] = LEGACY_ALPHABET[code - 1];
+        }
+        text[length] = '\0';
+        return;
+    }
+    if (isLegacy()) {
+        size_t length = static_cast<size_t>((value >> LEGACY_DIGITS_SHIFT) & 0x1F);
+        uint64_t rest = value & ((1ULL << LEGACY_DIGITS_SHIFT) - 1);
+        for (size_t i = length; i > 0; --i) {
+            text[i - 1] = static_cast<char>('0' + rest % 10);
+            rest /= 10;
+        }
+        text[length] = '\0';
+        return;
+    }
+
+    uint64_t rest = value;
+    for (int i = 12; i >= 0; --i) {
+        text[i] = static_cast<char>('0' + rest % 10);
+        rest /= 10;
+    }
+    text[13] = '\0';
+}
+
+string Isbn::toString() const {
+    char text[TEXT_SIZE];
+    toChars(text);
+    return string(text);
+}
+
+ostream& operator<<(ostream &out, const Isbn &isbn) {
+    char text[Isbn::TEXT_SIZE];
+    isbn.toChars(text);
+    return out << text;
+}
@@ -0,0 +1,385 @@
+/* Program name: Journal.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the journal entry and journal class methods
+*/
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "DurableFile.h"
+#include "Journal.h"
+
+using namespace std;
+
+namespace {
+    const char JOURNAL_MAGIC[8] = { 'L', 'I', 'B', 'J', 'R', 'N', 'L', '2' };
+    const size_t FRAME_SIZE = 16; // Payload length and checksum (4 bytes each), then the 8 byte sequence number
+
+    // FNV-1a hash of a record's payload
+    uint32_t checksum(const char* data, size_t size) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    void putUint32(vector<char> &out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    void putUint64(vector<char> &out, uint64_t value) {
+        putUint32(out, static_cast<uint32_t>(value));
+        putUint32(out, static_cast<uint32_t>(value >> 32));
+    }
+
+    uint32_t getUint32(const char* data) {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value |= static_cast<uint32_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+        }
+        return value;
+    }
+
+    uint64_t getUint64(const char* data) {
+        return getUint32(data) | (static_cast<uint64_t>(getUint32(data + 4)) << 32);
+    }
+
+    // Frame a record. The checksum covers the sequence number too.
+    void putFrame(vector<char> &out, const vector<char> &payload, uint64_t sequence) {
+        size_t start = out.size();
+        putUint32(out, static_cast<uint32_t>(payload.size()));
+        putUint32(out, 0); // Filled in below
+        putUint64(out, sequence);
+        out.insert(out.end(), payload.begin(), payload.end());
+        uint32_t sum = checksum(&out[start + 8], 8 + payload.size());
+        for (int i = 0; i < 4; ++i) {
+            out[start + 4 + i] = static_cast<char>((sum >> (8 * i)) & 0xFF);
+        }
+    }
+
+    // Write all of a buffer, retrying short writes
+    void writeAll(int fd, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t written = write(fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw runtime_error(string("Error writing journal: ") + strerror(errno));
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+
+    // Read a whole file from the current position
+    void readAll(int fd, vector<char> &contents) {
+        char buffer[64 * 1024];
+        ssize_t count;
+        while ((count = read(fd, buffer, sizeof(buffer))) != 0) {
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw runtime_error(string("Error reading journal: ") + strerror(errno));
+            }
+            contents.insert(contents.end(), buffer, buffer + count);
+        }
+    }
+
+    // Add every complete record in a journal file's contents to entries, and return the number
+    // of bytes up to the end of the last good one (0 if the file does not start with the magic)
+    size_t readRecords(const vector<char> &contents, vector<JournalEntry> &entries) {
+        if (contents.size() < sizeof(JOURNAL_MAGIC) || memcmp(&contents[0], JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0) {
+            return 0;
+        }
+        size_t valid = sizeof(JOURNAL_MAGIC);
+        while (contents.size() - valid >= FRAME_SIZE) {
+            uint32_t size = getUint32(&contents[valid]);
+            uint32_t sum = getUint32(&contents[valid + 4]);
+            if (size == 0 || size > contents.size() - valid - FRAME_SIZE ||
+                checksum(&contents[valid + 8], 8 + size) != sum) {
+                break; // Torn or corrupt record: everything from here on is dropped
+            }
+            entries.push_back(JournalEntry(&contents[valid + FRAME_SIZE], size, getUint64(&contents[valid + 8])));
+            valid += FRAME_SIZE + size;
+        }
+        return valid;
+    }
+}
+
+/* Journal Entry */
+JournalEntry::JournalEntry(journalRecordType type) : readPos(1), sequence(0) {
+    bytes.push_back(static_cast<char>(type));
+}
+
+JournalEntry::JournalEntry(const char* data, size_t size, uint64_t sequence) : bytes(data, data + size), readPos(1), sequence(sequence) {}
+
+journalRecordType JournalEntry::getType() const {
+    return static_cast<journalRecordType>(static_cast<unsigned char>(bytes[0]));
+}
+
+const vector<char>& JournalEntry::getBytes() const { return bytes; }
+
+uint64_t JournalEntry::getSequence() const { return sequence; }
+
+// Integers are zigzag encoded so small negative values stay short, then written 7 bits at a time
+JournalEntry& JournalEntry::putInt(int64_t value) {
+    uint64_t zigzag = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    while (zigzag >= 0x80) {
+        bytes.push_back(static_cast<char>((zigzag & 0x7F) | 0x80));
+        zigzag >>= 7;
+    }
+    bytes.push_back(static_cast<char>(zigzag));
+    return *this;
+}
+
+JournalEntry& JournalEntry::putString(const string &value) {
+    putInt(static_cast<int64_t>(value.size()));
+    bytes.insert(bytes.end(), value.begin(), value.end());
+    return *this;
+}
+
+int64_t JournalEntry::getInt() {
+    uint64_t zigzag = 0;
+    for (int shift = 0; ; shift += 7) {
+        if (readPos >= bytes.size() || shift > 63) {
+            throw runtime_error("Journal record is truncated");
+        }
+        unsigned char byte = static_cast<unsigned char>(bytes[readPos++]);
+        zigzag |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+    return static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+}
+
+string JournalEntry::getString() {
+    int64_t size = getInt();
+    if (size < 0 || static_cast<uint64_t>(size) > bytes.size() - readPos) {
+        throw runtime_error("Journal record is truncated");
+    }
+    string value(bytes.begin() + readPos, bytes.begin() + readPos + size);
+    readPos += static_cast<size_t>(size);
+    return value;
+}
+
+/* Journal */
+Journal::Journal() : fd(-1), lastSequence(0) {}
+
+Journal::~Journal() {
+    close();
+}
+
+// Open the journal and read back every complete record (the ones moved aside for a background
+// save that never finished come first)
+vector<JournalEntry> Journal::open(const string &filename) {
+    close();
+    this->filename = filename;
+    vector<JournalEntry> entries;
+
+    int savingFd = ::open(savingName().c_str(), O_RDWR);
+    if (savingFd >= 0) {
+        try {
+            vector<char> contents;
+            readAll(savingFd, contents);
+            size_t valid = readRecords(contents, entries);
+            if (valid != contents.size() && ftruncate(savingFd, static_cast<off_t>(valid)) != 0) { // So rotate() can append to it
+                throw runtime_error(string("Error repairing journal: ") + strerror(errno));
+            }
+        } catch (...) {
+            ::close(savingFd);
+            throw;
+        }
+        ::close(savingFd);
+    }
+
+    fd = ::open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        throw runtime_error("Unable to open journal: " + filename);
+    }
+
+    // Read the whole file (it only holds the changes since the last save)
+    vector<char> contents;
+    readAll(fd, contents);
+    size_t valid = readRecords(contents, entries);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].getSequence() > lastSequence) {
+            lastSequence = entries[i].getSequence();
+        }
+    }
+
+    if (valid != contents.size() || valid == 0) {
+        // Cut off anything after the last good record (or start a fresh file)
+        if (valid == 0) {
+            clearFile();
+        } else if (ftruncate(fd, static_cast<off_t>(valid)) != 0 || fdatasync(fd) != 0) {
+            throw runtime_error(string("Error repairing journal: ") + strerror(errno));
+        }
+    }
+    if (lseek(fd, 0, SEEK_END) < 0) {
+        throw runtime_error(string("Error opening journal: ") + strerror(errno));
+    }
+    return entries;
+}
+
+bool Journal::isOpen() const { return fd >= 0; }
+
+void Journal::close() {
+    if (fd >= 0) {
+        try {
+            commit();
+        } catch (const exception &e) {
+            cerr << e.what() << endl;
+        }
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+void Journal::startAfter(uint64_t sequence) {
+    if (sequence > lastSequence) {
+        lastSequence = sequence;
+    }
+}
+
+uint64_t Journal::getLastSequence() const { return lastSequence; }
+
+// Frame the record and write it
+void Journal::append(const JournalEntry &entry) {
+    if (fd < 0) {
+        return;
+    }
+    putFrame(pending, entry.getBytes(), ++lastSequence);
+    commit();
+}
+
+void Journal::append(const vector<JournalEntry> &entries) {
+    if (fd < 0) {
+        return;
+    }
+    for (size_t i = 0; i < entries.size(); ++i) {
+        putFrame(pending, entries[i].getBytes(), ++lastSequence);
+    }
+    commit();
+}
+
+// One sequential write and one flush for everything queued. On failure the file is cut back
+// so a later commit does not land after a half-written record.
+void Journal::commit() {
+    if (fd < 0 || pending.empty()) {
+        return;
+    }
+    off_t start = lseek(fd, 0, SEEK_CUR);
+    try {
+        if (start < 0) {
+            throw runtime_error(string("Error writing journal: ") + strerror(errno));
+        }
+        writeAll(fd, pending.data(), pending.size());
+        if (fdatasync(fd) != 0) {
+            throw runtime_error(string("Error flushing journal: ") + strerror(errno));
+        }
+    } catch (...) {
+        pending.clear();
+        if (start >= 0 && ftruncate(fd, start) == 0) {
+            lseek(fd, start, SEEK_SET);
+        }
+        throw;
+    }
+    pending.clear();
+}
+
+// Drop every record, including any moved aside for a background save
+void Journal::truncate() {
+    if (fd < 0) {
+        return;
+    }
+    clearFile();
+    dropRotated();
+}
+
+// Move the records so far to FILE.saving and carry on in an empty journal. If an earlier
+// background save failed, FILE.saving is still needed, so the records are added to its end.
+void Journal::rotate() {
+    if (fd < 0) {
+        return;
+    }
+    commit();
+    string saving = savingName();
+    if (access(saving.c_str(), F_OK) != 0) {
+        if (rename(filename.c_str(), saving.c_str()) != 0) {
+            throw runtime_error(string("Error rotating journal: ") + strerror(errno));
+        }
+        ::close(fd);
+        fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw runtime_error("Unable to open journal: " + filename);
+        }
+        clearFile();
+        syncDirectory(filename);
+        return;
+    }
+
+    vector<char> contents;
+    if (lseek(fd, 0, SEEK_SET) < 0) {
+        throw runtime_error(string("Error reading journal: ") + strerror(errno));
+    }
+    readAll(fd, contents);
+    if (contents.size() > sizeof(JOURNAL_MAGIC)) {
+        int savingFd = ::open(saving.c_str(), O_WRONLY | O_APPEND);
+        if (savingFd < 0) {
+            throw runtime_error("Unable to open journal: " + saving);
+        }
+        try {
+            writeAll(savingFd, &contents[sizeof(JOURNAL_MAGIC)], contents.size() - sizeof(JOURNAL_MAGIC));
+            if (fdatasync(savingFd) != 0) {
+                throw runtime_error(string("Error flushing journal: ") + strerror(errno));
+            }
+        } catch (...) {
+            ::close(savingFd);
+            throw;
+        }
+        ::close(savingFd);
+    }
+    clearFile(); // Only once the records are safely in FILE.saving
+}
+
+// Delete FILE.saving once a save holds its records. Safe to call from a forked save, since
+// it does not touch the open journal.
+void Journal::dropRotated() {
+    if (!filename.empty()) {
+        removeFile(savingName());
+    }
+}
+
+string Journal::savingName() const {
+    return filename + ".saving";
+}
+
+// Empty the file, keeping only the magic number
+void Journal::clearFile() {
+    pending.clear();
+    if (ftruncate(fd, 0) != 0 || lseek(fd, 0, SEEK_SET) < 0) {
+        throw runtime_error(string("Error truncating journal: ") + strerror(errno));
+    }
+    writeAll(fd, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    if (fdatasync(fd) != 0) {
+        throw runtime_error(string("Error flushing journal: ") + strerror(errno));
+    }
+}
@@ -1,19 +1,37 @@
 /* Program name: Library.cpp
 * Author: Joshua Yin
-* Date last updated: 7/24/2024
+* Date last updated: 10/17/2026
 * Purpose: Implement the library class methods
 */
 
 #include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
 #include <iostream>
 #include <fstream>
+#include <limits>
 #include <map>
-#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "CsvReader.h"
+#include "DurableFile.h"
 #include "Library.h"
+#include "SearchQuery.h"
 
 using namespace std;
 
@@ -27,540 +45,2597 @@ string genreToString(genreType genre) {
   return "Unknown Genre"; // Fallback
 }
 
-// Helper function to convert string to genre representation (only used for loading genre from file)
-genreType stringToGenreType(const string& genreStr) {
-  map<genreType, string>::const_iterator it;
-  for (it = genreNames.begin(); it != genreNames.end(); ++it) {
-    if (it->second == genreStr) {
-      return it->first;
-    }
+// Helper structs holding one book or member as read by the text loader (text fields point
+// into the file buffer). Transactions are read into HistoryRecords.
+struct ParsedBook {
+  const char* title;
+  const char* author;
+  Isbn isbn;
+  int pubDate;
+  const char* callNum;
+  genreType genre;
+  bool isBorrowed;
+  int32_t dueDay;
+};
+
+struct ParsedMember {
+  const char* name;
+  int memberID;
+  const char* phone;
+  const char* email;
+  const char* address;
+};
+
+// Helper struct to read the lines of a loaded section in order (the loader has already turned
+// every newline into a NUL and checked that the section's lines are all there). number counts
+// from the section's first line, so after a read it is the line number (from 1) of that line.
+struct LineCursor {
+  const char* next;
+  size_t number;
+
+  explicit LineCursor(const char* first, size_t firstLine = 0) : next(first), number(firstLine) {}
+
+  const char* read() {
+    const char* line = next;
+    next += strlen(next) + 1;
+    ++number;
+    return line;
   }
-  throw invalid_argument("Unknown genre: " + genreStr);
+};
+
+// Helper function to say which line of a data file (numbered from 0 here, from 1 in the message)
+// an error was found on
+runtime_error errorAtLine(size_t line, const exception &e) {
+  return runtime_error("line " + to_string(line + 1) + ": " + e.what());
 }
 
-/* Book Methods */
-void Library::addBook(const Book &book) {
-  books.push_back(book);
-  cout << "Book added successfully." << endl;
+// Helper function to read a number from the start of a line (like operator>>, trailing text is ignored)
+long long parseInteger(const char* text) {
+  char* end;
+  errno = 0;
+  long long value = strtoll(text, &end, 10);
+  if (end == text || errno == ERANGE) {
+    throw runtime_error(string("Invalid number: ") + text);
+  }
+  return value;
 }
 
-void Library::editBook(const string &isbn, const Book &updatedBook) {
-  for (size_t i = 0; i < books.size(); ++i) {
-    if (books[i].getISBN() == isbn) {
-      if (books[i].getIsBorrowed()) { // Can't edit if book is currently borrowed
-        cout << "Book is borrowed. Cannot edit currently borrowed books." << endl;
-        return;
-      } else {
-        books[i] = updatedBook;
-        cout << "Book edited successfully." << endl;
-        return;
-      }
-    }
+// Helper function to read a section's record count (a missing section counts as empty)
+size_t parseCount(const LineFile &file, size_t line) {
+  if (line >= file.lineCount()) {
+    return 0;
+  }
+  long long count;
+  try {
+    count = parseInteger(file.line(line));
+  } catch (const exception &e) {
+    throw errorAtLine(line, e);
   }
-  cout << "Book not found." << endl;
+  if (count < 0) {
+    throw errorAtLine(line, runtime_error("Invalid record count"));
+  }
+  return static_cast<size_t>(count);
 }
 
-void Library::deleteBook(const string &isbn) {
-  for (size_t i = 0; i < books.size(); ++i) {
-    if (books[i].getISBN() == isbn) {
-      if (books[i].getIsBorrowed()) { // Can't edit if book is currently borrowed
-        cout << "Book is borrowed. Cannot delete currently borrowed books." << endl;
-        return;
-      } else {
-        books.erase(books.begin() + i);
-        cout << "Book deleted successfully." << endl;
-      }
-      return;
+// Helper function to convert a genre name without building a string
+genreType parseGenre(const char* genreStr) {
+  for (map<genreType, string>::const_iterator it = genreNames.begin(); it != genreNames.end(); ++it) {
+    if (it->second == genreStr) {
+      return it->first;
     }
   }
-  cout << "Book not found." << endl;
+  throw invalid_argument(string("Unknown genre: ") + genreStr);
 }
 
-void Library::displayBooks() const {
-  if (books.empty()) {
-    cout << "The library has no books." << endl;
-    return;
+// Helper function to read a book's due date ("None" or YYYY-MM-DD) as an epoch day
+int32_t parseBookDueDate(const char* text) {
+  int32_t dueDay;
+  if (!parseDueDate(text, dueDay)) {
+    throw runtime_error(string("Invalid due date: ") + text);
   }
+  return dueDay;
+}
 
-  cout << "Books in the Library:" << endl;
-  for (vector<Book>::const_iterator it = books.begin(); it != books.end(); ++it) {
-    it->display();
+// Helper function to read an ISBN from a data file or journal
+Isbn parseSavedIsbn(const char* text) {
+  Isbn isbn;
+  if (!Isbn::parseSaved(text, isbn)) {
+    throw runtime_error(string("Invalid ISBN: ") + text);
   }
+  return isbn;
 }
 
-void Library::borrowBook(const string &isbn, const int &memberID) {
-  for (size_t i = 0; i < books.size(); ++i) {
-    if (books[i].getISBN() == isbn) {
-      // Check if book is already borrowed
-      if (books[i].getIsBorrowed()) {
-        cout << "Book is already borrowed." << endl;
-        return;
-      }
+// Helper function to format an amount of cents as dollars
+string formatCents(long long cents) {
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "$%lld.%02lld", cents / 100, cents % 100);
+  return buffer;
+}
 
-      // Check if the book is reserved
-      map<string, int>::const_iterator it = reservations.find(isbn);
-      if (it != reservations.end()) {
-        if (it->second == memberID) {
-          // Book is reserved by the borrowing member
-          cancelReservation(isbn, memberID);
-
-          // Borrow the book
-          Borrow* transaction = new Borrow(books[i], memberID);
-          transaction->process_transaction();
-          transactions.push_back(transaction);
-        } else {
-          // Book is reserved by another member
-          cout << "This book is reserved by another member." << endl;
-        }
-      } else {
-        // Book is not reserved; borrow it directly
-        Borrow* transaction = new Borrow(books[i], memberID);
-        transaction->process_transaction();
-        transactions.push_back(transaction);
+// Helper functions to parse each section of the text format (8 lines per book, 5 per member,
+// 5 per borrow and 4 per return). Members and transactions are read with a cursor so a lazy
+// load can parse them again later without keeping every line's position. Errors give the line
+// number of the bad line. A book whose ISBN cannot be read is left with a null ISBN and reported
+// in skipped, so the rest of the file still loads.
+void parseBooks(const LineFile &file, size_t first, size_t count, vector<ParsedBook> &books, vector<string> &skipped) {
+  books.resize(count);
+  size_t line = first;
+  try {
+    for (size_t i = 0; i < count; ++i) {
+      ParsedBook &book = books[i];
+      book.title = file.line(line);                                          // Read title
+      book.author = file.line(++line);                                       // Read author
+      if (!Isbn::parseSaved(file.line(++line), book.isbn)) {                 // Read isbn
+        book.isbn = Isbn();
+        skipped.push_back(errorAtLine(line, runtime_error(string("Invalid ISBN: ") + file.line(line))).what());
       }
-      return;
+      book.pubDate = static_cast<int>(parseInteger(file.line(++line)));      // Read publication date
+      book.callNum = file.line(++line);                                      // Read call number
+      book.genre = parseGenre(file.line(++line));                            // Read genre (as string)
+      book.isBorrowed = parseInteger(file.line(++line)) != 0;                // Read borrowed status
+      book.dueDay = parseBookDueDate(file.line(++line));                     // Read due date of book
+      ++line;
     }
+  } catch (const exception &e) {
+    throw errorAtLine(line, e);
   }
-  cout << "Book not found." << endl;
 }
 
-void Library::returnBook(const string &isbn, const int &memberID) {
-  // Find the book with the given ISBN
+// Helper function to find the books whose ISBN an earlier book already has, reporting each in
+// skipped (only called once the index shows there is one). A file can hold both forms of a
+// book's ISBN, which read as the same ISBN-13.
+vector<size_t> duplicateIsbnBooks(size_t first, const vector<ParsedBook> &books, vector<string> &skipped) {
+  vector<size_t> duplicates;
+  unordered_map<Isbn, size_t> seen;
   for (size_t i = 0; i < books.size(); ++i) {
-    if (books[i].getISBN() == isbn) {
-      // Check if the book is currently borrowed
-      if (!books[i].getIsBorrowed()) {
-        cout << "Book is not currently borrowed." << endl;
-        return;
-      }
+    if (books[i].isbn.isNull()) {
+      continue;
+    }
+    pair<unordered_map<Isbn, size_t>::iterator, bool> inserted = seen.insert(make_pair(books[i].isbn, i));
+    if (!inserted.second) {
+      duplicates.push_back(i);
+      skipped.push_back(errorAtLine(first + 8 * i + 2, runtime_error("ISBN " + books[i].isbn.toString()
+          + " is also the ISBN of the book on line " + to_string(first + 8 * inserted.first->second + 3))).what());
+    }
+  }
+  return duplicates;
+}
 
-      // Check if the member ID matches the one who borrowed the book
-      bool foundBorrowingTransaction = false;
-      for (size_t j = 0; j < transactions.size(); ++j) {
-        if (Borrow* borrowTransaction = dynamic_cast<Borrow*>(transactions[j])) {
-          if (borrowTransaction->getBook().getISBN() == isbn && borrowTransaction->getMemberID() == memberID) {
-            foundBorrowingTransaction = true;
-            // Create a return transaction
-            Return* transaction = new Return(books[i], memberID);
-            transaction->process_transaction();
-            transactions.push_back(transaction);
-            return;
-          }
-        }
+void parseMembers(LineCursor lines, size_t count, vector<ParsedMember> &members) {
+  members.resize(count);
+  try {
+    for (size_t i = 0; i < count; ++i) {
+      ParsedMember &member = members[i];
+      member.name = lines.read();                                      // Read name
+      member.memberID = static_cast<int>(parseInteger(lines.read()));  // Read member id
+      member.phone = lines.read();                                     // Read phone number
+      member.email = lines.read();                                     // Read email
+      member.address = lines.read();                                   // Read address
+    }
+  } catch (const exception &e) {
+    throw errorAtLine(lines.number - 1, e);
+  }
+}
+
+void parseTransactions(LineCursor lines, size_t count, vector<HistoryRecord> &transactions) {
+  int32_t dueDay;
+  transactions.resize(count);
+  try {
+    for (size_t i = 0; i < count; ++i) {
+      HistoryRecord &transaction = transactions[i];
+      transaction.isBorrow = strcmp(lines.read(), "borrow") == 0;                      // Read type of transaction
+      transaction.isbn = lines.read();                                                  // Read isbn of the book
+      parseSavedIsbn(transaction.isbn);
+      transaction.memberID = static_cast<int>(parseInteger(lines.read()));              // Read id of the member
+      transaction.transactionDate = static_cast<time_t>(parseInteger(lines.read()));    // Read date of transaction
+      transaction.dueDate = transaction.isBorrow ? lines.read() : nullptr;              // Read due date
+      if (transaction.isBorrow && !parseEpochDay(transaction.dueDate, dueDay)) {
+        throw runtime_error(string("Invalid due date: ") + transaction.dueDate);
       }
+    }
+  } catch (const exception &e) {
+    throw errorAtLine(lines.number - 1, e);
+  }
+}
 
-      if (!foundBorrowingTransaction) {
-        // If no matching borrowing transaction is found
-        cout << "Member with ID " << memberID << " is not the one who borrowed this book." << endl;
-     }
+// Helper functions to build members and transactions from parsed or archived records (shared
+// by loading and by building what a lazy load deferred)
+void addParsedMembers(const vector<ParsedMember> &parsedMembers, vector<Member> &members, unordered_map<int, size_t> &memberIndex) {
+  members.reserve(members.size() + parsedMembers.size());
+  memberIndex.reserve(memberIndex.size() + parsedMembers.size());
+  for (size_t i = 0; i < parsedMembers.size(); ++i) {
+    const ParsedMember &parsed = parsedMembers[i];
+    members.push_back(Member::fromPooledText(parsed.name, parsed.memberID, parsed.phone, parsed.email, parsed.address));
+    memberIndex[parsed.memberID] = members.size() - 1; // Index member by ID
+  }
+}
 
-      return;
+// Helper functions to run a task on another thread and hand any exception back to the caller
+template <typename Task> thread startTask(Task task, exception_ptr &error) {
+  return thread([task, &error]() {
+    try {
+      task();
+    } catch (...) {
+      error = current_exception();
     }
+  });
+}
+
+void rethrowTaskError(const exception_ptr &error) {
+  if (error) {
+    rethrow_exception(error);
   }
-  cout << "Book not found." << endl;
 }
 
-void Library::searchBook(const string &query, const string &searchType) const {
-  bool found = false;
+// Helper struct and functions for importing books from a delimited file
+struct ImportedBook {
+  string title;
+  string author;
+  Isbn isbn;
+  int pubDate;
+  string callNum;
+  genreType genre;
+};
+
+string trimField(const string &field) {
+  size_t first = field.find_first_not_of(" \t");
+  if (first == string::npos) {
+    return "";
+  }
+  return field.substr(first, field.find_last_not_of(" \t") - first + 1);
+}
 
-  // Display full search query
-  cout << "Searching " << query << " by " << searchType << ":" << endl;
+string lowercase(string text) {
+  for (size_t i = 0; i < text.size(); ++i) {
+    text[i] = static_cast<char>(tolower(static_cast<unsigned char>(text[i])));
+  }
+  return text;
+}
 
-  for (vector<Book>::const_iterator it = books.begin(); it != books.end(); ++it) {
-    const Book& book = *it;
-
-    bool match = false;
-
-    // Check based on the search type or default to "any"
-    if (searchType == "title" && book.getTitle() == query) {                // Search by title
-      match = true;
-    } else if (searchType == "author" && book.getAuthor() == query) {       // Search by author
-      match = true;
-    } else if (searchType == "isbn" && book.getISBN() == query) {           // Search by ISBN
-      match = true;
-    } else if (searchType == "callnumber" && book.getCallNum() == query) {  // Search by call number
-      match = true;
-    } else if (searchType == "genre") {                                     // Search by genre
-      try {
-        genreType genre = stringToGenreType(query);
-        if (book.getGenre() == genre) {
-          match = true;
-        }
-      } catch (const invalid_argument&) {
-        // Invalid genre string, skip this criterion
-      }
-    } else if (searchType == "pubdate") {                                   // Search by publication date
-      // We need to convert user's string input to an integer
-      int pubDate;
-      stringstream ss(query);
-      ss >> pubDate;
-      if (book.getPubDate() == pubDate) {
-        match = true;
-      }
-    } else if (searchType == "any") {                                       // Search by any
-      // Default search by title, author, or ISBN
-      if (book.getTitle() == query || book.getAuthor() == query || book.getISBN() == query) {
-        match = true;
-      }
+// Genres can be given by name (any case) or by their number in the genre menu
+bool parseImportGenre(const string &text, genreType &genre) {
+  string name = lowercase(text);
+  for (map<genreType, string>::const_iterator it = genreNames.begin(); it != genreNames.end(); ++it) {
+    if (lowercase(it->second) == name) {
+      genre = it->first;
+      return true;
     }
+  }
+  char* end = nullptr;
+  long number = strtol(text.c_str(), &end, 10);
+  if (!text.empty() && *end == '\0' && number >= 1 && number <= SCIENCE_FICTION + 1) {
+    genre = static_cast<genreType>(number - 1);
+    return true;
+  }
+  return false;
+}
 
-    if (match) {
-      book.display();
-      found = true;
+// Check one row and pull out the book (false, with the reason, if it is not a valid book)
+bool parseImportRow(const vector<string> &fields, ImportedBook &book, string &problem) {
+  if (fields.size() != 6) {
+    problem = "expected 6 fields, found " + to_string(fields.size());
+    return false;
+  }
+  for (size_t i = 0; i < fields.size(); ++i) {
+    if (fields[i].find('\n') != string::npos) {
+      problem = "a field contains a line break"; // The text data file has one field per line
+      return false;
     }
   }
+  book.title = trimField(fields[0]);
+  book.author = trimField(fields[1]);
+  book.callNum = trimField(fields[4]);
+  string isbn = trimField(fields[2]);
+  if (book.title.empty() || book.author.empty() || isbn.empty() || book.callNum.empty()) {
+    problem = "title, author, ISBN and call number are required";
+    return false;
+  }
+  if (!Isbn::parse(isbn, book.isbn)) {
+    problem = "invalid ISBN \"" + isbn + "\" (check the digits)";
+    return false;
+  }
+  string pubDate = trimField(fields[3]);
+  char* end = nullptr;
+  errno = 0;
+  long year = strtol(pubDate.c_str(), &end, 10);
+  if (pubDate.empty() || *end != '\0' || errno != 0 || year <= 0 || year > INT32_MAX) {
+    problem = "invalid publication date \"" + pubDate + "\"";
+    return false;
+  }
+  book.pubDate = static_cast<int>(year);
+  if (!parseImportGenre(trimField(fields[5]), book.genre)) {
+    problem = "unknown genre \"" + trimField(fields[5]) + "\"";
+    return false;
+  }
+  return true;
+}
 
-  if (!found) {
-      cout << "No book matching the query was found." << endl;
+// Helper function to check for the binary snapshot extension
+bool hasSnapshotExtension(const string &filename) {
+  const string extension = ".snap";
+  return filename.size() >= extension.size()
+      && filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+// Helper functions to write and read the fields of a book or member in a journal record
+void putBook(JournalEntry &entry, const Book &book) {
+  entry.putString(book.getTitle()).putString(book.getAuthor()).putString(book.getISBN().toString())
+      .putInt(book.getPubDate()).putString(book.getCallNum()).putInt(book.getGenre());
+}
+
+Book getBook(JournalEntry &entry, TextPool &text) {
+  string title = entry.getString();
+  string author = entry.getString();
+  Isbn isbn = parseSavedIsbn(entry.getString().c_str());
+  int pubDate = static_cast<int>(entry.getInt());
+  string callNum = entry.getString();
+  int64_t genre = entry.getInt();
+  if (genre < FANTASY || genre > SCIENCE_FICTION) {
+    throw runtime_error("Unknown genre in journal");
   }
+  return Book(text, title, author, isbn, pubDate, callNum, static_cast<genreType>(genre));
 }
 
-/* (Library) Member Methods */
-void Library::registerMember(const Member &member) {
-  members.push_back(member);
-  cout << "Member registered successfully." << endl;
+// Helper function to build the journal record for a borrow
+JournalEntry borrowEntry(const Transaction &transaction) {
+  JournalEntry entry(JOURNAL_BORROW);
+  entry.putString(transaction.isbn.toString()).putInt(transaction.memberID)
+      .putInt(transaction.transactionDate).putString(transaction.getDueDateText());
+  return entry;
 }
 
-void Library::editMember(int id, const Member &updatedMember) {
-  for (size_t i = 0; i < members.size(); ++i) {
-    if (members[i].getMemberID() == id) {
-      members[i] = updatedMember;
-      cout << "Member edited successfully." << endl;
-      return;
+void putMember(JournalEntry &entry, const Member &member) {
+  entry.putString(member.getName()).putInt(member.getMemberID()).putString(member.getPhone())
+      .putString(member.getEmail()).putString(member.getAddress());
+}
+
+Member getMember(JournalEntry &entry, TextPool &text) {
+  string name = entry.getString();
+  int memberID = static_cast<int>(entry.getInt());
+  string phone = entry.getString();
+  string email = entry.getString();
+  string address = entry.getString();
+  return Member(text, name, memberID, phone, email, address);
+}
+
+// Helper functions to build snapshot records (their strings go into the writer's string heap)
+BookRecord makeBookRecord(SnapshotWriter &writer, const Book &book) {
+  BookRecord record = BookRecord(); // Zero the padding so snapshots of the same data are identical
+  record.title = writer.addString(book.getTitle());
+  record.author = writer.addString(book.getAuthor());
+  record.isbn = writer.addString(book.getISBN().toString());
+  record.callNum = writer.addString(book.getCallNum());
+  record.dueDate = writer.addString(book.getDueDate());
+  record.pubDate = book.getPubDate();
+  record.genre = static_cast<uint8_t>(book.getGenre());
+  record.isBorrowed = book.getIsBorrowed() ? 1 : 0;
+  return record;
+}
+
+MemberRecord makeMemberRecord(SnapshotWriter &writer, const Member &member) {
+  MemberRecord record = MemberRecord();
+  record.memberID = member.getMemberID();
+  record.name = writer.addString(member.getName());
+  record.phone = writer.addString(member.getPhone());
+  record.email = writer.addString(member.getEmail());
+  record.address = writer.addString(member.getAddress());
+  return record;
+}
+
+TransactionRecord makeTransactionRecord(SnapshotWriter &writer, const Transaction &transaction) {
+  TransactionRecord record = TransactionRecord();
+  record.memberID = transaction.memberID;
+  record.transactionDate = static_cast<int64_t>(transaction.transactionDate);
+  record.isbn = writer.addString(transaction.isbn.toString());
+  switch (transaction.type) {
+    case BORROW_TRANSACTION:
+      record.type = BORROW_RECORD;
+      record.dueDate = writer.addString(transaction.getDueDateText());
+      break;
+    case RETURN_TRANSACTION:
+      record.type = RETURN_RECORD;
+      break;
+  }
+  return record;
+}
+
+// Used for open loans and holds (ISBN -> member ID)
+ReservationRecord makeKeyRecord(SnapshotWriter &writer, const Isbn &isbn, int memberID) {
+  ReservationRecord record = ReservationRecord();
+  record.isbn = writer.addString(isbn.toString());
+  record.memberID = memberID;
+  return record;
+}
+
+// Add one record per hold on a book, first in line first
+void addHoldRecords(SnapshotWriter &writer, const HoldTable &holds, const Isbn &isbn, vector<ReservationRecord> &records) {
+  vector<int> queue = holds.getQueue(isbn);
+  for (size_t i = 0; i < queue.size(); ++i) {
+    records.push_back(makeKeyRecord(writer, isbn, queue[i]));
+  }
+}
+
+// Helper struct to total the memory of one text field, as one std::string per value
+// versus as a pointer into the text pool (interned values are only stored once)
+struct TextUsage {
+  size_t values;
+  size_t stringBytes;
+  size_t pooledBytes;
+  unordered_set<const char*> seen;
+
+  TextUsage() : values(0), stringBytes(0), pooledBytes(0) {}
+
+  void add(const char* text, bool interned) {
+    size_t length = strlen(text);
+    ++values;
+    stringBytes += sizeof(string) + (length > 15 ? length + 1 : 0); // Short strings fit inside the object
+    pooledBytes += sizeof(const char*);
+    if (!interned || seen.insert(text).second) {
+      pooledBytes += length + 1;
     }
   }
-  cout << "Member not found." << endl;
+};
+
+/* Index Helpers */
+// Add a book to every book index
+void Library::indexBook(BookHandle handle, const Book &book) {
+  bookIndex[book.getISBN()] = handle;
+  textIndex.add(handle, book);
+  filterIndex.add(handle, book);
 }
 
-void Library::deleteMember(int id) {
-  // Check if user is currently borrowing anything
-  for (size_t i = 0; i < transactions.size(); ++i) {
-    Borrow* borrowTransaction = dynamic_cast<Borrow*>(transactions[i]);
-    if (borrowTransaction != nullptr && borrowTransaction->getMemberID() == id) {
-      cout << "Cannot delete member with ID " << id << " because they have at least one book borrowed." << endl;
-      return;
+// Remove a book from every book index (call before the book is changed or erased)
+void Library::unindexBook(BookHandle handle, const Book &book) {
+  bookIndex.erase(book.getISBN());
+  textIndex.remove(handle, book);
+  filterIndex.remove(handle, book);
+}
+
+// Rebuild the book indexes from scratch (used after the book store is replaced or loaded).
+// The three indexes share nothing, so the text and filter indexes are built on their own threads.
+void Library::rebuildBookIndex() {
+  bookIndex.clear();
+  bookIndex.reserve(books.size());
+  textIndex.clear();
+  filterIndex.clear();
+
+  thread textBuilder([this]() {
+    for (BookStore::const_iterator it = books.begin(); it != books.end(); ++it) {
+      textIndex.add(it.handle(), *it);
+    }
+  });
+  thread filterBuilder([this]() {
+    for (BookStore::const_iterator it = books.begin(); it != books.end(); ++it) {
+      filterIndex.add(it.handle(), *it);
     }
+  });
+  for (BookStore::const_iterator it = books.begin(); it != books.end(); ++it) {
+    bookIndex[it->getISBN()] = it.handle();
   }
+  textBuilder.join();
+  filterBuilder.join();
+}
 
-  // Check if user is currently reserving anything
-  for (map<string, int>::const_iterator it = reservations.begin(); it != reservations.end(); ++it) {
-    if (it->second == id) {
-      cout << "Cannot delete member with ID " << id << " because they have at least one reservation." << endl;
-      return;
+// Journal a batch of new books with one commit, then add them to the store and the ISBN index,
+// and index them for search and filtering (each on its own thread, as in rebuildBookIndex).
+// Nothing is added if the journal could not be written.
+bool Library::addBookBatch(const vector<Book> &batch) {
+  if (batch.empty()) {
+    return true;
+  }
+  vector<JournalEntry> entries;
+  entries.reserve(batch.size());
+  for (size_t i = 0; i < batch.size(); ++i) {
+    entries.push_back(JournalEntry(JOURNAL_ADD_BOOK));
+    putBook(entries.back(), batch[i]);
+  }
+  if (!journalChange(entries)) {
+    return false;
+  }
+
+  vector<BookHandle> handles;
+  handles.reserve(batch.size());
+  for (size_t i = 0; i < batch.size(); ++i) {
+    BookHandle handle = books.insert(batch[i]);
+    bookIndex[batch[i].getISBN()] = handle;
+    checkpoint.books.insert(batch[i].getISBN());
+    handles.push_back(handle);
+  }
+  thread textBuilder([this, &handles]() {
+    for (size_t i = 0; i < handles.size(); ++i) {
+      textIndex.add(handles[i], *books.get(handles[i]));
     }
+  });
+  for (size_t i = 0; i < handles.size(); ++i) {
+    filterIndex.add(handles[i], *books.get(handles[i]));
   }
+  textBuilder.join();
+  return true;
+}
 
-  // If no active borrowings or reservations, proceed with deletion
+// Rebuild the member ID index from scratch (used after the members vector is replaced)
+void Library::rebuildMemberIndex() {
+  memberIndex.clear();
+  memberIndex.reserve(members.size());
   for (size_t i = 0; i < members.size(); ++i) {
-    if (members[i].getMemberID() == id) {
-      members.erase(members.begin() + i);
-      cout << "Member deleted successfully." << endl;
-      return;
+    memberIndex[members[i].getMemberID()] = i;
+  }
+}
+
+// Rebuild the open loans by replaying the transaction history in order
+void Library::rebuildLoans() {
+  loans.clear();
+  for (size_t i = 0; i < transactions.size(); ++i) {
+    if (transactions[i].isBorrow()) {
+      loans.openLoan(transactions[i].isbn, transactions[i].memberID);
+    } else {
+      loans.closeLoan(transactions[i].isbn);
     }
   }
+}
 
-  cout << "Member not found." << endl;
+// Drop every book, member, transaction and reservation (used before loading)
+void Library::clearLibrary() {
+  books.clear();
+  bookIndex.clear();
+  textIndex.clear();
+  filterIndex.clear();
+  members.clear();
+  memberIndex.clear();
+  transactions.clear();
+  archive.clear();
+  loans.clear();
+  holds.clear();
+  dropDeferred();
+  textPool.reset(); // Every book and member is gone, so their text can be freed in one go
+  checkpoint = Checkpoint(); // Nothing is known to be saved until the load finishes
 }
 
-void Library::displayMembers() const {
-  if (members.empty()) {
-    cout << "There are no members in the library." << endl;
-    return;
+Book Library::pooledCopy(const Book &book) {
+  return Book::fromPooledText(textPool.store(book.getTitle()), textPool.intern(book.getAuthor()), book.getISBN(),
+      book.getPubDate(), textPool.store(book.getCallNum()), book.getGenre(), book.getIsBorrowed(), book.getDueDay());
+}
+
+Member Library::pooledCopy(const Member &member) {
+  return Member::fromPooledText(textPool.store(member.getName()), member.getMemberID(), textPool.store(member.getPhone()),
+      textPool.store(member.getEmail()), textPool.store(member.getAddress()));
+}
+
+bool Library::ownsText(const Book &book) const {
+  return textPool.owns(book.getTitle()) && textPool.owns(book.getAuthor()) && textPool.owns(book.getCallNum());
+}
+
+bool Library::ownsText(const Member &member) const {
+  return textPool.owns(member.getName()) && textPool.owns(member.getPhone()) && textPool.owns(member.getEmail()) &&
+      textPool.owns(member.getAddress());
+}
+
+/* Mutation Helpers */
+// These change state without checks or messages. The public methods check first; journal
+// replay only sees changes that were checked when they were made, but still skips anything
+// that no longer applies (e.g. a journal replayed over an older data file).
+void Library::applyAddBook(const Book &book) {
+  if (!bookIndex.count(book.getISBN())) {
+    indexBook(books.insert(book), book);
+    checkpoint.books.insert(book.getISBN());
   }
+}
 
-  cout << "Members in the Library:" << endl;
-  for (vector<Member>::const_iterator it = members.begin(); it != members.end(); ++it) {
-    it->display();
+void Library::applyEditBook(const Isbn &isbn, const Book &updatedBook) {
+  unordered_map<Isbn, BookHandle>::iterator it = bookIndex.find(isbn);
+  if (it == bookIndex.end()) {
+    return;
   }
+  BookHandle handle = it->second;
+  unindexBook(handle, *books.get(handle));
+  books.replace(handle, updatedBook);
+  indexBook(handle, updatedBook);
+  checkpoint.books.insert(isbn);
+  checkpoint.books.insert(updatedBook.getISBN());
 }
 
-/* Reservation Methods*/
-void Library::reserveBook(const string &isbn, const int &memberID) {
-  for (size_t i = 0; i < books.size(); ++i) {
-    if (books[i].getISBN() == isbn) {
-      if (books[i].getIsBorrowed()) { // If book is already borrowed
-        map<string, int>::iterator it = reservations.find(isbn);
-        if (it != reservations.end()) { // If book is already reserved
-          if (it->second == memberID) { // Reserved by this member
-            cout << "Book is already reserved by this member." << endl;
-          } else { // Reserved by another member
-            cout << "Book is already reserved by another member." << endl;
-          }
-        } else { // No reservation exists, proceed with reservation
-          reservations[isbn] = memberID;
-          cout << "Book reserved successfully." << endl;
-        }
-      } else { // Book is not borrowed, no need to reserve
-          cout << "Book is available, no need to reserve." << endl;
-      }
-      return;
-    }
+void Library::applyDeleteBook(const Isbn &isbn) {
+  unordered_map<Isbn, BookHandle>::iterator it = bookIndex.find(isbn);
+  if (it == bookIndex.end()) {
+    return;
   }
-  cout << "Book not found." << endl;
+  BookHandle handle = it->second; // History, loans and holds refer to books by ISBN, so only the indexes hold the handle
+  unindexBook(handle, *books.get(handle));
+  books.erase(handle);
+  checkpoint.books.insert(isbn);
 }
 
-void Library::cancelReservation(const string &isbn, const int &memberID) {
-  map<string, int>::iterator it = reservations.find(isbn);
-  if (it != reservations.end() && it->second == memberID) {
-    // Reservation found and matches the memberID
-    reservations.erase(it);
-    cout << "Reservation cancelled successfully." << endl;
-  } else {
-    // Reservation not found or memberID does not match
-    cout << "Reservation not found or you are not the one who reserved it." << endl;
+void Library::applyRegisterMember(const Member &member) {
+  loadDeferredMembers();
+  if (!memberIndex.count(member.getMemberID())) {
+    members.push_back(member);
+    memberIndex[member.getMemberID()] = members.size() - 1;
+    checkpoint.members.insert(member.getMemberID());
   }
 }
 
-void Library::displayReservations() const {
-  if (reservations.empty()) {
-    cout << "No books are currently reserved." << endl;
+void Library::applyEditMember(int id, const Member &updatedMember) {
+  loadDeferredMembers();
+  unordered_map<int, size_t>::iterator it = memberIndex.find(id);
+  if (it == memberIndex.end()) {
     return;
   }
+  size_t i = it->second;
 
-  cout << "Current Reservations:" << endl;
-  for (map<string, int>::const_iterator it = reservations.begin(); it != reservations.end(); ++it) {
-    string isbn = it->first;
-    int memberID = it->second;
-
-    cout << "ISBN: " << isbn << ", Reserved by Member ID: " << memberID << endl;
+  // Move the index entry if the ID itself is being changed
+  if (updatedMember.getMemberID() != id) {
+    memberIndex.erase(it);
+    memberIndex[updatedMember.getMemberID()] = i;
   }
+  members[i] = updatedMember;
+  checkpoint.members.insert(id);
+  checkpoint.members.insert(updatedMember.getMemberID());
 }
 
-/* Transaction Methods */
-void Library::displayTransactions() const {
-  if (transactions.empty()) {
-    cout << "There are no transactions yet." << endl;
+void Library::applyDeleteMember(int id) {
+  loadDeferredMembers();
+  unordered_map<int, size_t>::iterator it = memberIndex.find(id);
+  if (it == memberIndex.end()) {
     return;
   }
-  cout << "Transaction History:" << endl;
-  for (size_t i = 0; i < transactions.size(); ++i) {
-    transactions[i]->display();
+
+  // Erase in place so members keep the order they registered in, and move the index of every
+  // member after it down one
+  size_t i = it->second;
+  memberIndex.erase(it);
+  members.erase(members.begin() + i);
+  for (size_t j = i; j < members.size(); ++j) {
+    memberIndex[members[j].getMemberID()] = j;
   }
+  checkpoint.members.insert(id);
 }
 
-void Library::deleteTransactionHistory() {
-  // Free the memory for each transaction pointer in the vector
-  for (Transaction* transaction : transactions) {
-    delete transaction;
+void Library::applyBorrow(const Isbn &isbn, int memberID, time_t transactionDate, const string &dueDate) {
+  unordered_map<Isbn, BookHandle>::const_iterator found = bookIndex.find(isbn);
+  BookHandle handle = found != bookIndex.end() ? found->second : BookHandle();
+
+  Transaction transaction = makeBorrow(isbn, memberID, transactionDate);
+  if (!parseEpochDay(dueDate.c_str(), transaction.dueDay)) {
+    throw runtime_error("Invalid due date: " + dueDate);
   }
-  // Clear the vector
-  transactions.clear();
-  cout << "Transaction history deleted successfully." << endl;
+  transactions.push_back(transaction);
+  if (!handle.isNull()) {
+    books.setBorrowed(handle, true, transaction.dueDay);
+  }
+  loans.openLoan(isbn, memberID);
+  checkpoint.books.insert(isbn);
+  rollHistory();
 }
 
-/* File Methods */
-// Save library data to file (separated by newlines)
-void Library::saveToFile(const string &filename) {
-  ofstream file(filename);
-  if (!file) { // Check for file errors
-    cerr << "Error opening file for writing: " << filename << endl;
-    return;
+void Library::applyReturn(const Isbn &isbn, int memberID, time_t transactionDate) {
+  unordered_map<Isbn, BookHandle>::const_iterator found = bookIndex.find(isbn);
+  BookHandle handle = found != bookIndex.end() ? found->second : BookHandle();
+
+  transactions.push_back(makeReturn(isbn, memberID, transactionDate));
+  if (!handle.isNull()) {
+    books.setBorrowed(handle, false, NO_DUE_DATE);
   }
+  loans.closeLoan(isbn);
+  checkpoint.books.insert(isbn);
+  rollHistory();
+}
 
-  try {
-    // Save books
-    file << books.size() << endl;                   // Write size of books vector
-    for (vector<Book>::const_iterator it = books.begin(); it != books.end(); ++it) {
-      const Book& book = *it; // Dereference iterator to get books
-      file << book.getTitle() << endl               // Write title
-          << book.getAuthor() << endl               // Write author
-          << book.getISBN() << endl                 // Write ISBN
-          << book.getPubDate() << endl              // Write publication date
-          << book.getCallNum() << endl              // Write call number
-          << genreToString(book.getGenre()) << endl // Write genre (as string)
-          << book.getIsBorrowed() << endl           // Write borrowed status
-          << book.getDueDate() << endl;             // Write due date
-    }
+void Library::applyReserve(const Isbn &isbn, int memberID) {
+  if (holds.enqueue(isbn, memberID)) {
+    checkpoint.reservations.insert(isbn);
+  }
+}
 
-    // Save members
-    file << members.size() << endl;         // Write size of members vector
-    for (vector<Member>::const_iterator it = members.begin(); it != members.end(); ++it) {
-      const Member& member = *it; // Dereference iterator to get members
-      file << member.getName() << endl      // Write name
-          << member.getMemberID() << endl   // Write id
-          << member.getPhone() << endl      // Write phone number
-          << member.getEmail() << endl      // Write email
-          << member.getAddress() << endl;   // Write address
-    }
+void Library::applyCancelReservation(const Isbn &isbn, int memberID) {
+  if (holds.cancel(isbn, memberID)) {
+    checkpoint.reservations.insert(isbn);
+  }
+}
 
-    // Save transactions
-    file << transactions.size() << endl;                         // Write size of transactions vector
-    for (vector<Transaction*>::const_iterator it = transactions.begin(); it != transactions.end(); ++it) {
-      Transaction* transaction = *it; // Dereference iterator to get the transaction
-      if (Borrow* borrowTransaction = dynamic_cast<Borrow*>(transaction)) { // If transaction is of borrow class
-        file << "borrow" << endl;                                // Write "borrow" to indicate borrow type transaction
-        file << borrowTransaction->getBook().getISBN() << endl   // Write ISBN of borrowed book
-            << borrowTransaction->getMemberID() << endl          // Write ID of borrowing member
-            << borrowTransaction->getTransactionDate() << endl   // Write date of transaction (UNIX)
-            << borrowTransaction->getDueDate() << endl;          // Write due date of book
-      } else if (Return* returnTransaction = dynamic_cast<Return*>(transaction)) { // If transaction is of return class
-        file << "return" << endl;                                // Write "return" to indicate return type transaction
-        file << returnTransaction->getBook().getISBN() << endl   // Write ISBN of returned book
-            << returnTransaction->getMemberID() << endl          // Write ID of member returning the book
-            << returnTransaction->getTransactionDate() << endl;  // Write date of transaction (UNIX)
-      }
-    }
-      
-    // Save reservations
-    file << reservations.size() << endl;    // Write size of reservations map
-    for (map<string, int>::const_iterator it = reservations.begin(); it != reservations.end(); ++it) {
-      const string& isbn = it->first; // Get book ISBN
-      const int& memberID = it->second; // Get member ID
+void Library::applyClearHistory() {
+  transactions.clear();
+  archive.clear();
+  deferred.history = 0; // Saved transactions that were never built are dropped too
+  releaseDeferredSnapshot();
+  checkpoint.transactions = 0;
+  checkpoint.archiveSegments = 0;
+  checkpoint.archivedTransactions = 0;
+  checkpoint.historyCleared = true;
+}
 
-      file << isbn << endl                  // Write book ISBN
-          << memberID << endl;              // Write member ID
+// Apply one journal record
+void Library::replayEntry(JournalEntry &entry) {
+  switch (entry.getType()) {
+    case JOURNAL_ADD_BOOK:
+      applyAddBook(getBook(entry, textPool));
+      break;
+    case JOURNAL_EDIT_BOOK: {
+      Isbn isbn = parseSavedIsbn(entry.getString().c_str());
+      applyEditBook(isbn, getBook(entry, textPool));
+      break;
     }
+    case JOURNAL_DELETE_BOOK:
+      applyDeleteBook(parseSavedIsbn(entry.getString().c_str()));
+      break;
+    case JOURNAL_REGISTER_MEMBER:
+      applyRegisterMember(getMember(entry, textPool));
+      break;
+    case JOURNAL_EDIT_MEMBER: {
+      int id = static_cast<int>(entry.getInt());
+      applyEditMember(id, getMember(entry, textPool));
+      break;
+    }
+    case JOURNAL_DELETE_MEMBER:
+      applyDeleteMember(static_cast<int>(entry.getInt()));
+      break;
+    case JOURNAL_BORROW: {
+      Isbn isbn = parseSavedIsbn(entry.getString().c_str());
+      int memberID = static_cast<int>(entry.getInt());
+      time_t transactionDate = static_cast<time_t>(entry.getInt());
+      applyBorrow(isbn, memberID, transactionDate, entry.getString());
+      break;
+    }
+    case JOURNAL_RETURN: {
+      Isbn isbn = parseSavedIsbn(entry.getString().c_str());
+      int memberID = static_cast<int>(entry.getInt());
+      applyReturn(isbn, memberID, static_cast<time_t>(entry.getInt()));
+      break;
+    }
+    case JOURNAL_RESERVE: {
+      Isbn isbn = parseSavedIsbn(entry.getString().c_str());
+      applyReserve(isbn, static_cast<int>(entry.getInt()));
+      break;
+    }
+    case JOURNAL_CANCEL_RESERVATION: {
+      Isbn isbn = parseSavedIsbn(entry.getString().c_str());
+      applyCancelReservation(isbn, static_cast<int>(entry.getInt()));
+      break;
+    }
+    case JOURNAL_CLEAR_HISTORY:
+      applyClearHistory();
+      break;
+    default:
+      throw runtime_error("Unknown journal record type");
   }
-  catch (const exception &e) {
-    cerr << "An error occurred while saving data: " << e.what() << endl;
-  }
-
-  file.close();
-  cout << "Library data saved successfully." << endl;
 }
 
-// Load library data from file
-void Library::loadFromFile(const string &filename) {
-  ifstream file(filename);
-  if (!file) { // Check for file errors
-    cerr << "Error opening file for reading: " << filename << endl;
+/* Lazy Loading Helpers */
+// Build the members or history a lazy load deferred. These are const so read-only methods can
+// call them: building changes how the library is stored, not what it holds.
+void Library::loadDeferredMembers() const {
+  if (!deferred.members) {
     return;
   }
-
+  Library* self = const_cast<Library*>(this);
   try {
-    // Clear existing vectors and map
-    books.clear();
-    members.clear();
-    transactions.clear();
-    reservations.clear();
-
-    size_t size; // Size variable that will be reused whenever loading size of each vector and the map
-
-    // Load books
-    file >> size;                     // Read size of books vector
-    file.ignore();
-    for (size_t i = 0; i < size; ++i) { // For each book:
-      string title, author, isbn, callNum, genreStr, dueDate;
-      int pubDate;
-      bool isBorrowed;
-
-      getline(file, title);           // Read title
-      getline(file, author);          // Read author
-      getline(file, isbn);            // Read isbn
-      file >> pubDate;                // Read publication date
-      file.ignore();          
-      getline(file, callNum);         // Read call number
-      file >> genreStr >> isBorrowed; // Read genre (as string) and borrowed status
-      file.ignore();
-      getline(file, dueDate);         // Read due date of book
-
-      genreType genre = stringToGenreType(genreStr); // Convert genre string to enum type
-
-      books.push_back(Book(title, author, isbn, pubDate, callNum, genre)); // Add book to vector (with title, author, isbn, and genre)
-      books.back().setIsBorrowed(isBorrowed);  // Set borrowed status
-      books.back().setDueDate(dueDate); // Set due date
-    }
-    
-    // Load members
-    file >> size;             // Read size of members vector
-    file.ignore();
-    for (size_t i = 0; i < size; ++i) { // For each member:
-      string name, phone, email, address;
-      int memberID;
-
-      getline(file, name);    // Read name
-      file >> memberID;       // Read member id
-      file.ignore();
-      getline(file, phone);   // Read phone number
-      getline(file, email);   // Read email
-      getline(file, address); // Read address
-
-      members.push_back(Member(name, memberID, phone, email, address)); // Add member to vector
-    }
-
-    // Load transactions
-    file >> size;                     // Read size of transactions vector
-    file.ignore();
-    for (size_t i = 0; i < size; ++i) { // For each transaction:
-      string type, isbn, transactionDate;
-      int memberID;
-
-      getline(file, type);            // Read type of transaction ("borrow" or "return")
-      getline(file, isbn);            // Read isbn of the book in the transaction
-      file >> memberID;               // Read id of the member in the transaction
-      file.ignore();
-      getline(file, transactionDate); // Read date of transaction
-
-      // Check if a book with the isbn exists
-      Book* book = nullptr;
-      for (vector<Book>::iterator it = books.begin(); it != books.end(); ++it) {
-        Book& b = *it; // Dereference iterator to get the book
-        if (b.getISBN() == isbn) {
-          // Book found
-          book = &b; // Initialize book to the book with the isbn
-          break;
-        }
-      }
-      if (!book) {
-        // Book not found
-        throw runtime_error("Book with ISBN " + isbn + " not found.");
-      }
-
-      // Create the transaction object
-      Transaction* transaction = nullptr;
-      if (type == "borrow") { // If transaction type is borrow
-        string dueDate;
-        getline(file, dueDate);     // Read due date
-        transaction = new Borrow(*book, memberID);
-      } else if (type == "return") { // If transaction type is return
-        transaction = new Return(*book, memberID);
-      } else {
-        throw runtime_error("Unknown transaction type: " + type);
-      }
+    self->buildDeferredMembers();
+  } catch (const exception &e) {
+    cerr << "An error occurred while loading members: " << e.what() << endl;
+    self->checkpoint.stale = true; // Only some were built, so the next save must rewrite everything
+  }
+  self->releaseDeferredSnapshot();
+}
 
-      // Set the transaction date
-      transaction->setTransactionDate(transactionDate);
+void Library::loadDeferredHistory() const {
+  if (deferred.history == 0) {
+    return;
+  }
+  Library* self = const_cast<Library*>(this);
+  try {
+    self->buildDeferredHistory();
+  } catch (const exception &e) {
+    cerr << "An error occurred while loading the transaction history: " << e.what() << endl;
+    self->deferred.history = 0;
+    self->checkpoint.stale = true;
+  }
+  self->releaseDeferredSnapshot();
+}
 
-      // Add the transaction to the vector
-      transactions.push_back(transaction);
+// Build the members a lazy load left in the text buffer or snapshot
+void Library::buildDeferredMembers() {
+  if (!deferred.members) {
+    return;
+  }
+  deferred.members = false; // First, so the apply helpers used below don't come back here
+  if (deferred.snapshot) {
+    for (size_t segment = 0; segment < deferred.snapshot->segmentCount(); ++segment) {
+      applySnapshotMembers(*deferred.snapshot, segment);
     }
+  } else {
+    vector<ParsedMember> parsedMembers;
+    parseMembers(LineCursor(deferred.memberText), deferred.memberCount, parsedMembers);
+    addParsedMembers(parsedMembers, members, memberIndex);
+  }
+  checkpoint.members.clear(); // Nothing could change members while they were deferred, so none need saving
+}
 
-    // Load reservations
-    file >> size;          // Read number of reservations
-    file.ignore();
-    for (size_t i = 0; i < size; ++i) { // For each reservation
-      string isbn;
-      int memberID;
-      getline(file, isbn); // Read book ISBN
-      file >> memberID;    // Read member id
-      file.ignore();
-      reservations[isbn] = memberID;
+// Build the saved transactions a lazy load left behind, in front of any made since the load
+void Library::buildDeferredHistory() {
+  if (deferred.history == 0) {
+    return;
+  }
+  vector<HistoryRecord> history;
+  if (deferred.snapshot) {
+    history.reserve(deferred.history);
+    for (size_t segment = 0; segment < deferred.snapshot->segmentCount(); ++segment) {
+      applySnapshotHistory(*deferred.snapshot, segment, history);
     }
+  } else {
+    parseTransactions(LineCursor(deferred.historyText), deferred.history, history);
   }
-  catch (const exception &e) {
-    cerr << "An error occurred while loading data: " << e.what() << endl;
+  deferred.history = 0;
+  addHistory(history);
+}
+
+// Unmapping is up to textPool; this only frees the segment table once nothing is left to build
+void Library::releaseDeferredSnapshot() {
+  if (!deferred.members && deferred.history == 0) {
+    delete deferred.snapshot;
+    deferred.snapshot = nullptr;
   }
+}
 
-  file.close();
-  cout << "Library data loaded successfully." << endl;
+// Forget everything that was deferred (used when the library is cleared)
+void Library::dropDeferred() {
+  delete deferred.snapshot;
+  deferred = DeferredLoad();
 }
 
-// Getters
-vector<Book> Library::getBooks() const { return books; }
-vector<Member> Library::getMembers() const { return members; }
-map<string, int> Library::getReservations() const { return reservations; }
-vector<Transaction*> Library::getTransactions() const { return transactions; }
+size_t Library::historySize() const {
+  return deferred.history + transactions.size();
+}
 
-// Setters
-void Library::setBooks(const vector<Book> &books) { this->books = books; }
-void Library::setMembers(const vector<Member> &members) { this->members = members; }
-void Library::setReservations(const map<string, int> &reservations) { this->reservations = reservations; }
-void Library::setTransactions(const vector<Transaction*> &transactions) { this->transactions = transactions; }
+/* History Archive Helpers */
+// Recent transactions are kept as objects until there are two segments' worth; then the oldest
+// segment's worth is sealed into the archive.
+
+// Put saved transactions (oldest first) in front of any made since they were loaded. The ones
+// that would be archived anyway are sealed straight from the records without being built.
+void Library::addHistory(const vector<HistoryRecord> &records) {
+  const size_t segmentSize = HistoryArchive::SEGMENT_SIZE;
+  size_t sealed = 0;
+  while (records.size() - sealed >= segmentSize && records.size() - sealed + transactions.size() >= 2 * segmentSize) {
+    archive.seal(&records[sealed], segmentSize);
+    sealed += segmentSize;
+  }
+  noteArchived(sealed);
+
+  TransactionPool history;
+  for (size_t i = sealed; i < records.size(); ++i) {
+    history.push_back(fromHistoryRecord(records[i]));
+  }
+  for (TransactionPool::const_iterator it = transactions.begin(); it != transactions.end(); ++it) {
+    history.push_back(*it);
+  }
+  transactions.swap(history);
+  rollHistory(); // In case the transactions made since the load were enough to fill a segment too
+}
+
+// Archive the oldest recent transactions while there are two segments' worth
+void Library::rollHistory() {
+  const size_t segmentSize = HistoryArchive::SEGMENT_SIZE;
+  if (deferred.history > 0 || transactions.size() < 2 * segmentSize) {
+    return; // Deferred transactions are older than these, so nothing can be archived before them
+  }
+  vector<HistoryRecord> records(segmentSize);
+  vector<HistoryText> texts(segmentSize); // Keeps the records' text alive until the segment is sealed
+  size_t rolled = 0;
+  while (transactions.size() - rolled >= 2 * segmentSize) {
+    for (size_t i = 0; i < segmentSize; ++i) {
+      records[i] = makeHistoryRecord(transactions[rolled + i], texts[i]);
+    }
+    archive.seal(records.data(), segmentSize);
+    rolled += segmentSize;
+  }
+  transactions.dropFront(rolled); // Frees the blocks they filled
+  noteArchived(rolled);
+}
+
+// Keep the checkpoint in step when the oldest recent transactions are archived: any of them
+// that were already saved now only need dropping from the snapshot's recent history
+void Library::noteArchived(size_t count) {
+  size_t saved = min(count, checkpoint.transactions);
+  checkpoint.transactions -= saved;
+  checkpoint.archivedTransactions += saved;
+}
+
+/* Journal Helpers */
+bool Library::journalChange(const JournalEntry &entry) {
+  return journalChange(vector<JournalEntry>(1, entry));
+}
+
+// Several entries are committed together, so a crash replays all of them or none
+bool Library::journalChange(const vector<JournalEntry> &entries) {
+  try {
+    journal.append(entries);
+    return true;
+  }
+  catch (const exception &e) {
+    cerr << "An error occurred while journaling the change (nothing was changed): " << e.what() << endl;
+    return false;
+  }
+}
+
+/* Book Methods */
+Book Library::makeBook(const string &title, const string &author, const Isbn &isbn, int pubDate, const string &callNum,
+    genreType genre) {
+  return Book(textPool, title, author, isbn, pubDate, callNum, genre);
+}
+
+void Library::addBook(const Book &newBook) {
+  Book book = ownsText(newBook) ? newBook : pooledCopy(newBook);
+  if (bookIndex.count(book.getISBN())) { // ISBNs must stay unique for the index
+    cout << "A book with this ISBN already exists." << endl;
+    return;
+  }
+  JournalEntry entry(JOURNAL_ADD_BOOK);
+  putBook(entry, book);
+  if (!journalChange(entry)) {
+    return;
+  }
+  applyAddBook(book);
+  cout << "Book added successfully." << endl;
+}
+
+// Import books from a delimited file. The file is read a chunk at a time and books are added in
+// batches: each row is checked against the ISBN index as it is read (so repeats within the file
+// are caught too), and the search and filter indexes and the journal are updated once per batch.
+bool Library::importBooks(const string &filename) {
+  const size_t batchSize = 10000;
+  const size_t maxReported = 10; // Problem rows listed before the rest are only counted
+  size_t imported = 0, duplicates = 0, invalid = 0;
+  bool estimated = false, complete = false;
+  vector<Book> batch; // Read but not yet journaled or added
+  unordered_set<Isbn> batchIsbns;
+  batch.reserve(batchSize);
+
+  try {
+    string extension = filename.size() >= 4 ? lowercase(filename.substr(filename.size() - 4)) : "";
+    CsvReader reader(filename, extension == ".tsv" ? '\t' : ',');
+    vector<string> fields;
+    ImportedBook row;
+    string problem;
+    while (reader.next(fields)) {
+      if (reader.getLineNumber() == 1) {
+        if (!fields.empty() && fields[0].compare(0, 3, "\xEF\xBB\xBF") == 0) {
+          fields[0].erase(0, 3); // Byte order mark left by spreadsheet programs
+        }
+        if (fields.size() > 2 && lowercase(trimField(fields[2])) == "isbn") {
+          continue; // Header row
+        }
+      }
+      if (fields.size() == 1 && trimField(fields[0]).empty()) {
+        continue; // Blank line
+      }
+
+      if (!parseImportRow(fields, row, problem)) {
+        if (++invalid <= maxReported) {
+          cerr << filename << ", line " << reader.getLineNumber() << ": " << problem << endl;
+        }
+        continue;
+      }
+      if (bookIndex.count(row.isbn) || !batchIsbns.insert(row.isbn).second) {
+        ++duplicates;
+        continue;
+      }
+      batch.push_back(Book(textPool, row.title, row.author, row.isbn, row.pubDate, row.callNum, row.genre));
+
+      if (batch.size() == batchSize) {
+        if (!estimated && reader.getBytesRead() > 0) {
+          // Make room for the rest of the file at the rate the first batch used it
+          size_t expected = static_cast<size_t>(static_cast<double>(reader.getFileSize()) / reader.getBytesRead() * batchSize);
+          books.reserve(books.size() + expected);
+          bookIndex.reserve(bookIndex.size() + expected);
+          estimated = true;
+        }
+        if (!addBookBatch(batch)) {
+          break;
+        }
+        imported += batch.size();
+        batch.clear();
+        batchIsbns.clear();
+      }
+    }
+    if (batch.size() < batchSize && addBookBatch(batch)) { // Otherwise the full batch could not be journaled
+      imported += batch.size();
+      complete = true;
+    }
+  }
+  catch (const exception &e) { // Batches already added stay; the rows read since are dropped
+    cerr << "An error occurred while importing books: " << e.what() << endl;
+    if (imported == 0) {
+      return false;
+    }
+  }
+
+  if (invalid > maxReported) {
+    cerr << "(" << invalid - maxReported << " more invalid rows not shown)" << endl;
+  }
+  cout << "Imported " << imported << " books (" << duplicates << " duplicate ISBNs and " << invalid
+      << " invalid rows skipped)." << endl;
+  return complete;
+}
+
+void Library::editBook(const Isbn &isbn, const Book &editedBook) {
+  Book updatedBook = ownsText(editedBook) ? editedBook : pooledCopy(editedBook);
+  unordered_map<Isbn, BookHandle>::iterator it = bookIndex.find(isbn);
+  if (it == bookIndex.end()) {
+    cout << "Book not found." << endl;
+    return;
+  }
+
+  if (books.get(it->second)->getIsBorrowed()) { // Can't edit if book is currently borrowed
+    cout << "Book is borrowed. Cannot edit currently borrowed books." << endl;
+    return;
+  }
+
+  // The ISBN can only change to one that is not already taken
+  if (updatedBook.getISBN() != isbn && bookIndex.count(updatedBook.getISBN())) {
+    cout << "A book with this ISBN already exists." << endl;
+    return;
+  }
+
+  JournalEntry entry(JOURNAL_EDIT_BOOK);
+  entry.putString(isbn.toString());
+  putBook(entry, updatedBook);
+  if (!journalChange(entry)) {
+    return;
+  }
+  applyEditBook(isbn, updatedBook);
+  cout << "Book edited successfully." << endl;
+}
+
+void Library::deleteBook(const Isbn &isbn) {
+  unordered_map<Isbn, BookHandle>::iterator it = bookIndex.find(isbn);
+  if (it == bookIndex.end()) {
+    cout << "Book not found." << endl;
+    return;
+  }
+
+  if (books.get(it->second)->getIsBorrowed()) { // Can't edit if book is currently borrowed
+    cout << "Book is borrowed. Cannot delete currently borrowed books." << endl;
+    return;
+  }
+
+  if (!journalChange(JournalEntry(JOURNAL_DELETE_BOOK).putString(isbn.toString()))) {
+    return;
+  }
+  applyDeleteBook(isbn);
+  cout << "Book deleted successfully." << endl;
+}
+
+void Library::displayBooks() const {
+  if (books.empty()) {
+    cout << "The library has no books." << endl;
+    return;
+  }
+
+  cout << "Books in the Library:" << endl;
+  for (BookStore::const_iterator it = books.begin(); it != books.end(); ++it) {
+    it->display();
+  }
+}
+
+// Display book counts per genre (counted from the store's genre and availability columns)
+void Library::displayInventory() const {
+  cout << "Inventory Summary:" << endl;
+  for (map<genreType, string>::const_iterator it = genreNames.begin(); it != genreNames.end(); ++it) {
+    size_t total = books.countGenre(it->first);
+    size_t available = books.countAvailable(it->first);
+    cout << it->second << ": " << total << " total, " << available << " available, " << total - available << " borrowed" << endl;
+  }
+  cout << "All genres: " << books.size() << " total, " << books.countAvailable() << " available, "
+      << books.size() - books.countAvailable() << " borrowed" << endl;
+}
+
+void Library::displayAvailableBooks(genreType genre) const {
+  vector<BookHandle> found = books.findAvailable(genre);
+  if (found.empty()) {
+    cout << "No " << genreNames.at(genre) << " books are available." << endl;
+    return;
+  }
+
+  cout << "Available " << genreNames.at(genre) << " Books:" << endl;
+  for (size_t i = 0; i < found.size(); ++i) {
+    books.get(found[i])->display();
+  }
+}
+
+bool Library::hasBook(const Isbn &isbn) const {
+  return bookIndex.count(isbn) != 0;
+}
+
+const Book* Library::findBook(const Isbn &isbn) const {
+  unordered_map<Isbn, BookHandle>::const_iterator it = bookIndex.find(isbn);
+  return it != bookIndex.end() ? books.get(it->second) : nullptr;
+}
+
+void Library::borrowBook(const Isbn &isbn, const int &memberID) {
+  unordered_map<Isbn, BookHandle>::const_iterator found = bookIndex.find(isbn);
+  if (found == bookIndex.end()) {
+    cout << "Book not found." << endl;
+    return;
+  }
+  const Book &book = *books.get(found->second);
+
+  // Check if book is already borrowed
+  if (book.getIsBorrowed()) {
+    cout << "Book is already borrowed." << endl;
+    return;
+  }
+
+  // Check if the book is reserved (only the first member in line can borrow it)
+  int nextInLine = holds.getNextInLine(isbn);
+  if (nextInLine != -1) {
+    if (nextInLine == memberID) {
+      // Book is reserved by the borrowing member: the reservation cancel and the borrow are
+      // journaled together
+      Transaction transaction = makeBorrow(isbn, memberID, time(nullptr));
+      vector<JournalEntry> entries;
+      entries.push_back(JournalEntry(JOURNAL_CANCEL_RESERVATION).putString(isbn.toString()).putInt(memberID));
+      entries.push_back(borrowEntry(transaction));
+      if (!journalChange(entries)) {
+        return;
+      }
+      applyCancelReservation(isbn, memberID);
+      cout << "Reservation cancelled successfully." << endl;
+
+      // Borrow the book
+      processBorrow(found->second, transaction);
+    } else {
+      // Book is reserved by another member
+      cout << "This book is reserved by another member." << endl;
+    }
+  } else {
+    // Book is not reserved; borrow it directly
+    Transaction transaction = makeBorrow(isbn, memberID, time(nullptr));
+    if (journalChange(borrowEntry(transaction))) {
+      processBorrow(found->second, transaction);
+    }
+  }
+}
+
+// Lend the book for a new borrow and add it to the history
+void Library::processBorrow(BookHandle handle, const Transaction &transaction) {
+  books.setBorrowed(handle, true, transaction.dueDay);
+  loans.openLoan(transaction.isbn, transaction.memberID);
+  cout << "Book borrowed successfully. Due date: " << transaction.getDueDateText() << endl;
+  transactions.push_back(transaction);
+  checkpoint.books.insert(transaction.isbn);
+  rollHistory();
+}
+
+void Library::returnBook(const Isbn &isbn, const int &memberID) {
+  // Find the book with the given ISBN
+  unordered_map<Isbn, BookHandle>::const_iterator found = bookIndex.find(isbn);
+  if (found == bookIndex.end()) {
+    cout << "Book not found." << endl;
+    return;
+  }
+  const Book &book = *books.get(found->second);
+
+  // Check if the book is currently borrowed
+  if (!book.getIsBorrowed()) {
+    cout << "Book is not currently borrowed." << endl;
+    return;
+  }
+
+  // Check if the member ID matches the one who borrowed the book
+  if (!loans.isOnLoan(isbn) || loans.getBorrower(isbn) != memberID) {
+    cout << "Member with ID " << memberID << " is not the one who borrowed this book." << endl;
+    return;
+  }
+
+  // Create a return transaction
+  Transaction transaction = makeReturn(isbn, memberID, time(nullptr));
+  if (!journalChange(JournalEntry(JOURNAL_RETURN).putString(isbn.toString()).putInt(memberID).putInt(transaction.transactionDate))) {
+    return;
+  }
+  books.setBorrowed(found->second, false, NO_DUE_DATE);
+  loans.closeLoan(isbn);
+  cout << "Book returned successfully." << endl;
+  if (holds.isHeld(isbn)) { // The first member in line can now pick it up
+    cout << "Book is ready for pickup by Member ID: " << holds.getNextInLine(isbn) << "." << endl;
+  }
+  transactions.push_back(transaction);
+  checkpoint.books.insert(isbn);
+  rollHistory();
+}
+
+void Library::searchBook(const string &query, const string &searchType) const {
+  bool found = false;
+
+  // Display full search query
+  cout << "Searching " << query << " by " << searchType << ":" << endl;
+
+  // ISBNs are unique, so an ISBN search is a single index lookup (either form of the ISBN finds the book)
+  Isbn isbn;
+  bool isISBN = Isbn::parseSaved(query.c_str(), isbn);
+  if (searchType == "isbn") {
+    unordered_map<Isbn, BookHandle>::const_iterator it = isISBN ? bookIndex.find(isbn) : bookIndex.end();
+    if (it != bookIndex.end()) {
+      books.get(it->second)->display();
+    } else {
+      cout << "No book matching the query was found." << endl;
+    }
+    return;
+  }
+
+  // Fuzzy searches tolerate a few typos per word ("Tolkein" finds Tolkien), best matches first
+  if (searchType == "fuzzy") {
+    vector<SearchResult> results = textIndex.fuzzySearch(query, ALL_FIELDS, 10);
+    for (size_t i = 0; i < results.size(); ++i) {
+      books.get(results[i].book)->display();
+    }
+    if (results.empty()) {
+      cout << "No book matching the query was found." << endl;
+    }
+    return;
+  }
+
+  // Title, author and any searches match words (case-insensitive, prefixes allowed) through the word index
+  if (searchType == "title" || searchType == "author" || searchType == "any") {
+    unsigned char fields = searchType == "title" ? TITLE_FIELD : searchType == "author" ? AUTHOR_FIELD : ALL_FIELDS;
+
+    // An exact ISBN match comes first for "any" searches
+    const Book* byISBN = searchType == "any" && isISBN ? findBook(isbn) : nullptr;
+    if (byISBN) {
+      byISBN->display();
+    }
+
+    vector<SearchResult> results = textIndex.search(query, fields, books.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+      if (!byISBN || books.get(results[i].book) != byISBN) {
+        books.get(results[i].book)->display();
+      }
+    }
+
+    if (!byISBN && results.empty()) {
+      cout << "No book matching the query was found." << endl;
+
+      // Suggest indexed words that complete what was typed
+      vector<string> suggestions = textIndex.complete(query, 5);
+      if (!suggestions.empty() && !SearchIndex::tokenize(query).empty()) {
+        cout << "Did you mean:";
+        for (size_t i = 0; i < suggestions.size(); ++i) {
+          cout << (i == 0 ? " " : ", ") << suggestions[i];
+        }
+        cout << endl;
+      }
+
+      // Suggest books whose words are a few typos away from the query
+      vector<SearchResult> closest = textIndex.fuzzySearch(query, fields, 5);
+      if (!closest.empty()) {
+        cout << "Closest matches:" << endl;
+        for (size_t i = 0; i < closest.size(); ++i) {
+          const Book* book = books.get(closest[i].book);
+          cout << "  " << book->getTitle() << " by " << book->getAuthor() << " (ISBN: " << book->getISBN() << ")" << endl;
+        }
+      }
+    }
+    return;
+  }
+
+  // Genre and publication date searches read only the matching entries of the ordered filter index
+  vector<BookHandle> matches;
+  if (searchType == "genre") {
+    genreType genre;
+    if (parseGenreName(query, genre)) {
+      matches = filterIndex.findByGenre(genre);
+    }
+  } else if (searchType == "pubdate") {
+    int fromYear, toYear;
+    if (parseYearRange(query, fromYear, toYear)) {
+      matches = filterIndex.findByPubDate(fromYear, toYear);
+    }
+  } else if (searchType == "callnumber") {
+    for (BookStore::const_iterator it = books.begin(); it != books.end(); ++it) {
+      if (it->getCallNum() == query) {
+        matches.push_back(it.handle());
+      }
+    }
+  }
+
+  for (size_t i = 0; i < matches.size(); ++i) {
+    books.get(matches[i])->display();
+    found = true;
+  }
+
+  if (!found) {
+      cout << "No book matching the query was found." << endl;
+  }
+}
+
+void Library::searchBookByGenreAndDate(genreType genre, int fromYear, int toYear) const {
+  cout << "Searching " << genreNames.at(genre) << " published " << fromYear << "-" << toYear << ":" << endl;
+
+  vector<BookHandle> matches = filterIndex.findByGenre(genre, fromYear, toYear);
+  for (size_t i = 0; i < matches.size(); ++i) {
+    books.get(matches[i])->display();
+  }
+
+  if (matches.empty()) {
+    cout << "No book matching the query was found." << endl;
+  }
+}
+
+/* (Library) Member Methods */
+Member Library::makeMember(const string &name, int id, const string &phone, const string &email, const string &address) {
+  return Member(textPool, name, id, phone, email, address);
+}
+
+void Library::registerMember(const Member &newMember) {
+  Member member = ownsText(newMember) ? newMember : pooledCopy(newMember);
+  loadDeferredMembers();
+  if (memberIndex.count(member.getMemberID())) { // Member IDs must stay unique for the index
+    cout << "A member with this ID already exists." << endl;
+    return;
+  }
+  JournalEntry entry(JOURNAL_REGISTER_MEMBER);
+  putMember(entry, member);
+  if (!journalChange(entry)) {
+    return;
+  }
+  applyRegisterMember(member);
+  cout << "Member registered successfully." << endl;
+}
+
+void Library::editMember(int id, const Member &editedMember) {
+  Member updatedMember = ownsText(editedMember) ? editedMember : pooledCopy(editedMember);
+  loadDeferredMembers();
+  unordered_map<int, size_t>::iterator it = memberIndex.find(id);
+  if (it == memberIndex.end()) {
+    cout << "Member not found." << endl;
+    return;
+  }
+
+  // The ID can only change to one that is not already taken
+  if (updatedMember.getMemberID() != id && memberIndex.count(updatedMember.getMemberID())) {
+    cout << "A member with this ID already exists." << endl;
+    return;
+  }
+
+  JournalEntry entry(JOURNAL_EDIT_MEMBER);
+  entry.putInt(id);
+  putMember(entry, updatedMember);
+  if (!journalChange(entry)) {
+    return;
+  }
+  applyEditMember(id, updatedMember);
+  cout << "Member edited successfully." << endl;
+}
+
+void Library::deleteMember(int id) {
+  loadDeferredMembers();
+
+  // Check if user is currently borrowing anything
+  if (loans.hasLoans(id)) {
+    cout << "Cannot delete member with ID " << id << " because they have at least one book borrowed." << endl;
+    return;
+  }
+
+  // Check if user is currently reserving anything
+  if (holds.hasHolds(id)) {
+    cout << "Cannot delete member with ID " << id << " because they have at least one reservation." << endl;
+    return;
+  }
+
+  // If no active borrowings or reservations, proceed with deletion
+  if (!memberIndex.count(id)) {
+    cout << "Member not found." << endl;
+    return;
+  }
+
+  if (!journalChange(JournalEntry(JOURNAL_DELETE_MEMBER).putInt(id))) {
+    return;
+  }
+  applyDeleteMember(id);
+  cout << "Member deleted successfully." << endl;
+}
+
+void Library::displayMembers() const {
+  loadDeferredMembers();
+  if (members.empty()) {
+    cout << "There are no members in the library." << endl;
+    return;
+  }
+
+  cout << "Members in the Library:" << endl;
+  for (vector<Member>::const_iterator it = members.begin(); it != members.end(); ++it) {
+    it->display();
+  }
+}
+
+bool Library::hasMember(int id) const {
+  loadDeferredMembers();
+  return memberIndex.count(id) != 0;
+}
+
+const Member* Library::findMember(int id) const {
+  loadDeferredMembers();
+  unordered_map<int, size_t>::const_iterator it = memberIndex.find(id);
+  return it != memberIndex.end() ? &members[it->second] : nullptr;
+}
+
+/* Reservation Methods*/
+void Library::reserveBook(const Isbn &isbn, const int &memberID) {
+  unordered_map<Isbn, BookHandle>::const_iterator found = bookIndex.find(isbn);
+  if (found == bookIndex.end()) {
+    cout << "Book not found." << endl;
+    return;
+  }
+
+  // Members can join the queue while the book is out or already waiting for someone else
+  if (books.get(found->second)->getIsBorrowed() || holds.isHeld(isbn)) {
+    if (holds.hasHold(isbn, memberID)) { // Already in line
+      cout << "Book is already reserved by this member." << endl;
+    } else if (journalChange(JournalEntry(JOURNAL_RESERVE).putString(isbn.toString()).putInt(memberID))) { // Join the back of the queue
+      applyReserve(isbn, memberID);
+      cout << "Book reserved successfully. Position in queue: " << holds.getQueueLength(isbn) << endl;
+    }
+  } else { // Book is not borrowed, no need to reserve
+      cout << "Book is available, no need to reserve." << endl;
+  }
+}
+
+void Library::cancelReservation(const Isbn &isbn, const int &memberID) {
+  if (holds.hasHold(isbn, memberID)) {
+    // Reservation found for the memberID
+    if (!journalChange(JournalEntry(JOURNAL_CANCEL_RESERVATION).putString(isbn.toString()).putInt(memberID))) {
+      return;
+    }
+    applyCancelReservation(isbn, memberID);
+    cout << "Reservation cancelled successfully." << endl;
+  } else {
+    // Reservation not found or memberID does not match
+    cout << "Reservation not found or you are not the one who reserved it." << endl;
+  }
+}
+
+// Display each book's queue in order. The first member in line for a book that is back on the
+// shelf can pick it up.
+void Library::displayReservations() const {
+  if (holds.size() == 0) {
+    cout << "No books are currently reserved." << endl;
+    return;
+  }
+
+  cout << "Current Reservations:" << endl;
+  vector<Isbn> isbns = holds.getHeldBooks();
+  for (size_t i = 0; i < isbns.size(); ++i) {
+    const Book* book = findBook(isbns[i]);
+    bool onShelf = book && !book->getIsBorrowed();
+    vector<int> queue = holds.getQueue(isbns[i]);
+    for (size_t position = 0; position < queue.size(); ++position) {
+      cout << "ISBN: " << isbns[i] << ", Reserved by Member ID: " << queue[position]
+          << ", Position: " << position + 1
+          << ", Status: " << (position == 0 && onShelf ? "Ready for pickup" : "Waiting") << endl;
+    }
+  }
+}
+
+/* Transaction Methods */
+void Library::displayTransactions() const {
+  if (getTransactionCount() == 0) {
+    cout << "There are no transactions yet." << endl;
+    return;
+  }
+  cout << "Transaction History:" << endl;
+  forEachTransaction([](const Transaction &transaction) { transaction.display(); });
+}
+
+// Display the transactions made between two times (inclusive)
+void Library::displayTransactionsBetween(time_t from, time_t to) const {
+  loadDeferredHistory();
+  bool found = false;
+  auto show = [&found](const Transaction &transaction) {
+    if (!found) {
+      cout << "Transaction History:" << endl;
+      found = true;
+    }
+    transaction.display();
+  };
+  archive.forEach(from, to, [&show](const HistoryRecord &record) { show(fromHistoryRecord(record)); });
+  for (size_t i = 0; i < transactions.size(); ++i) {
+    if (transactions[i].transactionDate >= from && transactions[i].transactionDate <= to) {
+      show(transactions[i]);
+    }
+  }
+  if (!found) {
+    cout << "No transactions were made in that period." << endl;
+  }
+}
+
+void Library::deleteTransactionHistory() {
+  if (!journalChange(JournalEntry(JOURNAL_CLEAR_HISTORY))) {
+    return;
+  }
+  applyClearHistory();
+  cout << "Transaction history deleted successfully." << endl;
+}
+
+/* Due Date Methods */
+// Display the books past their due date and what their borrowers owe so far
+void Library::displayOverdueLoans() const {
+  int32_t today = currentEpochDay();
+  vector<BookHandle> overdue = books.findDue(NO_DUE_DATE + 1, today - 1); // Every day before today
+  if (overdue.empty()) {
+    cout << "No books are overdue." << endl;
+    return;
+  }
+
+  long long totalFines = 0;
+  cout << "Overdue Books:" << endl;
+  for (size_t i = 0; i < overdue.size(); ++i) {
+    const Book &book = *books.get(overdue[i]);
+    int daysOverdue = today - book.getDueDay();
+    long long fine = static_cast<long long>(daysOverdue) * FINE_CENTS_PER_DAY;
+    totalFines += fine;
+    cout << "ISBN: " << book.getISBN() << ", Title: " << book.getTitle()
+        << ", Member ID: " << loans.getBorrower(book.getISBN()) << ", Due Date: " << book.getDueDate()
+        << ", Days Overdue: " << daysOverdue << ", Fine: " << formatCents(fine) << endl;
+  }
+  cout << overdue.size() << " books are overdue, with " << formatCents(totalFines) << " in fines owed." << endl;
+}
+
+// Display the books due back from today through a number of days from now
+void Library::displayLoansDueWithin(int days) const {
+  // Due dates have four-digit years, so a longer period stops at the last one (which also
+  // keeps a huge number of days from overflowing)
+  int32_t today = currentEpochDay();
+  int32_t lastDay = epochDayFromDate(9999, 12, 31);
+  int32_t until = days > lastDay - today ? lastDay : today + days;
+  vector<BookHandle> due = books.findDue(today, until);
+  if (due.empty()) {
+    cout << "No books are due in that period." << endl;
+    return;
+  }
+
+  cout << "Books Due by " << formatEpochDay(until) << ":" << endl;
+  for (size_t i = 0; i < due.size(); ++i) {
+    const Book &book = *books.get(due[i]);
+    cout << "ISBN: " << book.getISBN() << ", Title: " << book.getTitle()
+        << ", Member ID: " << loans.getBorrower(book.getISBN()) << ", Due Date: " << book.getDueDate() << endl;
+  }
+  cout << due.size() << " books are due." << endl;
+}
+
+/* Memory Methods */
+// Display how much the pooled text fields save compared to one std::string per field
+void Library::displayMemoryReport() const {
+  const char* names[] = { "Book title", "Book author", "Book call number",
+                          "Member name", "Member phone", "Member email", "Member address" };
+  const bool interned[] = { false, true, false, false, false, false, false };
+  TextUsage usage[7];
+  loadDeferredMembers();
+
+  for (BookStore::const_iterator it = books.begin(); it != books.end(); ++it) {
+    usage[0].add(it->getTitle(), interned[0]);
+    usage[1].add(it->getAuthor(), interned[1]);
+    usage[2].add(it->getCallNum(), interned[2]);
+  }
+  for (vector<Member>::const_iterator it = members.begin(); it != members.end(); ++it) {
+    usage[3].add(it->getName(), interned[3]);
+    usage[4].add(it->getPhone(), interned[4]);
+    usage[5].add(it->getEmail(), interned[5]);
+    usage[6].add(it->getAddress(), interned[6]);
+  }
+
+  size_t totalStrings = 0, totalPooled = 0;
+  cout << "Text Memory Report:" << endl;
+  for (size_t i = 0; i < 7; ++i) {
+    cout << names[i] << ": " << usage[i].values << " values, " << usage[i].stringBytes << " bytes as strings, "
+        << usage[i].pooledBytes << " bytes pooled, "
+        << static_cast<long>(usage[i].stringBytes) - static_cast<long>(usage[i].pooledBytes) << " bytes saved" << endl;
+    totalStrings += usage[i].stringBytes;
+    totalPooled += usage[i].pooledBytes;
+  }
+  cout << "All fields: " << totalStrings << " bytes as strings, " << totalPooled << " bytes pooled, "
+      << static_cast<long>(totalStrings) - static_cast<long>(totalPooled) << " bytes saved" << endl;
+  cout << "Arena blocks allocated: " << textPool.bytesAllocated() << " bytes ("
+      << textPool.internedCount() << " interned values)" << endl;
+  if (textPool.bytesMapped() > 0) {
+    cout << "Snapshot mapped in place: " << textPool.bytesMapped() << " bytes" << endl;
+  }
+  cout << "Transaction archive: " << archive.size() << " transactions in " << archive.segmentCount() << " segments, "
+      << archive.bytes() << " bytes (" << historySize() << " recent transactions kept as " << sizeof(Transaction)
+      << "-byte records in " << transactions.bytesAllocated() << " bytes of blocks)" << endl;
+}
+
+/* Export Methods */
+void Library::beginBookExport(ExportWriter &out) {
+  const char* columns[] = { "isbn", "title", "author", "pub_date", "call_number", "genre", "borrowed", "due_date" };
+  out.begin(vector<string>(columns, columns + 8));
+}
+
+void Library::exportBook(ExportWriter &out, const Book &book) {
+  out.addText(book.getISBN().toString());
+  out.addText(book.getTitle());
+  out.addText(book.getAuthor());
+  out.addNumber(book.getPubDate());
+  out.addText(book.getCallNum());
+  out.addText(genreToString(book.getGenre()));
+  out.addBool(book.getIsBorrowed());
+  out.addText(book.getIsBorrowed() ? book.getDueDate() : string()); // Returned books keep "None"
+  out.endRecord();
+}
+
+void Library::beginMemberExport(ExportWriter &out) {
+  const char* columns[] = { "member_id", "name", "phone", "email", "address" };
+  out.begin(vector<string>(columns, columns + 5));
+}
+
+void Library::exportMember(ExportWriter &out, const Member &member) {
+  out.addNumber(member.getMemberID());
+  out.addText(member.getName());
+  out.addText(member.getPhone());
+  out.addText(member.getEmail());
+  out.addText(member.getAddress());
+  out.endRecord();
+}
+
+void Library::beginLoanExport(ExportWriter &out) {
+  const char* columns[] = { "isbn", "title", "member_id", "member_name", "due_date" };
+  out.begin(vector<string>(columns, columns + 5));
+}
+
+void Library::exportLoan(ExportWriter &out, const LoanRecord &loan) {
+  out.addText(loan.book->getISBN().toString());
+  out.addText(loan.book->getTitle());
+  out.addNumber(loan.memberID);
+  out.addText(loan.member ? loan.member->getName() : "");
+  out.addText(loan.book->getDueDate());
+  out.endRecord();
+}
+
+void Library::beginHistoryExport(ExportWriter &out) {
+  const char* columns[] = { "type", "isbn", "member_id", "date", "due_date" };
+  out.begin(vector<string>(columns, columns + 5));
+}
+
+void Library::exportHistoryRecord(ExportWriter &out, const HistoryRecord &record) {
+  char isbn[Isbn::TEXT_SIZE];
+  parseSavedIsbn(record.isbn).toChars(isbn); // Archived text is as it was loaded, so write it the way books are
+  out.addText(record.isBorrow ? "borrow" : "return");
+  out.addText(isbn);
+  out.addNumber(record.memberID);
+  out.addTime(record.transactionDate);
+  out.addText(record.isBorrow ? record.dueDate : "");
+  out.endRecord();
+}
+
+// Describe a recent transaction the way the archive does (so both export the same way)
+HistoryRecord Library::makeHistoryRecord(const Transaction &transaction, HistoryText &text) {
+  transaction.isbn.toChars(text.isbn);
+  text.dueDate = transaction.getDueDateText();
+  HistoryRecord record = { transaction.isBorrow(), text.isbn, transaction.memberID, transaction.transactionDate,
+      transaction.isBorrow() ? text.dueDate.c_str() : nullptr };
+  return record;
+}
+
+// Turn an archived or loaded record back into a transaction (nothing points into the record)
+Transaction Library::fromHistoryRecord(const HistoryRecord &record) {
+  Isbn isbn = parseSavedIsbn(record.isbn);
+  if (!record.isBorrow) {
+    return makeReturn(isbn, record.memberID, record.transactionDate);
+  }
+  Transaction transaction = makeBorrow(isbn, record.memberID, record.transactionDate);
+  if (!parseEpochDay(record.dueDate, transaction.dueDay)) {
+    throw runtime_error(string("Invalid due date: ") + record.dueDate);
+  }
+  return transaction;
+}
+
+/* File Methods */
+// Save library data to file (separated by newlines)
+bool Library::saveToFile(const string &filename) {
+  if (hasSnapshotExtension(filename)) {
+    return saveSnapshot(filename);
+  }
+  waitForBackgroundSave(); // It may be writing the same file
+
+  try {
+    writeTextFile(filename);
+    journal.truncate(); // Every journaled change is in the file now
+  }
+  catch (const exception &e) {
+    cerr << "An error occurred while saving data: " << e.what() << endl;
+    return false;
+  }
+
+  cout << "Library data saved successfully." << endl;
+  return true;
+}
+
+// Write library data as text, to a temporary file that then replaces the old one
+void Library::writeTextFile(const string &filename) const {
+  loadDeferredMembers(); // The text format is always written whole
+  loadDeferredHistory();
+
+  string tempName = temporaryName(filename);
+  ofstream file(tempName);
+  if (!file) { // Check for file errors
+    throw runtime_error("Error opening file for writing: " + filename);
+  }
+
+  try {
+    // Save books
+    file << books.size() << endl;                   // Write number of books
+    for (BookStore::const_iterator it = books.begin(); it != books.end(); ++it) {
+      const Book& book = *it; // Dereference iterator to get books
+      file << book.getTitle() << endl               // Write title
+          << book.getAuthor() << endl               // Write author
+          << book.getISBN() << endl                 // Write ISBN
+          << book.getPubDate() << endl              // Write publication date
+          << book.getCallNum() << endl              // Write call number
+          << genreToString(book.getGenre()) << endl // Write genre (as string)
+          << book.getIsBorrowed() << endl           // Write borrowed status
+          << book.getDueDate() << endl;             // Write due date
+    }
+
+    // Save members
+    file << members.size() << endl;         // Write size of members vector
+    for (vector<Member>::const_iterator it = members.begin(); it != members.end(); ++it) {
+      const Member& member = *it; // Dereference iterator to get members
+      file << member.getName() << endl      // Write name
+          << member.getMemberID() << endl   // Write id
+          << member.getPhone() << endl      // Write phone number
+          << member.getEmail() << endl      // Write email
+          << member.getAddress() << endl;   // Write address
+    }
+
+    // Save transactions (the archived ones first, written out in full)
+    file << archive.size() + transactions.size() << endl;       // Write number of transactions
+    archive.forEach([&file](const HistoryRecord &record) {
+      char isbn[Isbn::TEXT_SIZE];
+      parseSavedIsbn(record.isbn).toChars(isbn);                 // Archived text is as it was loaded, so write it the way books are
+      file << (record.isBorrow ? "borrow" : "return") << endl    // Write type of transaction
+          << isbn << endl                                        // Write ISBN of the book
+          << record.memberID << endl                             // Write ID of the member
+          << record.transactionDate << endl;                     // Write date of transaction (UNIX)
+      if (record.isBorrow) {
+        file << record.dueDate << endl;                          // Write due date of book
+      }
+    });
+    for (TransactionPool::const_iterator it = transactions.begin(); it != transactions.end(); ++it) {
+      switch (it->type) {
+        case BORROW_TRANSACTION:
+          file << "borrow" << endl;                              // Write "borrow" to indicate borrow type transaction
+          file << it->isbn << endl                               // Write ISBN of borrowed book
+              << it->memberID << endl                            // Write ID of borrowing member
+              << it->transactionDate << endl                     // Write date of transaction (UNIX)
+              << it->getDueDateText() << endl;                   // Write due date of book
+          break;
+        case RETURN_TRANSACTION:
+          file << "return" << endl;                              // Write "return" to indicate return type transaction
+          file << it->isbn << endl                               // Write ISBN of returned book
+              << it->memberID << endl                            // Write ID of member returning the book
+              << it->transactionDate << endl;                    // Write date of transaction (UNIX)
+          break;
+      }
+    }
+      
+    // Save reservations (one per hold, each book's queue in order)
+    file << holds.size() << endl;           // Write number of holds
+    vector<Isbn> heldBooks = holds.getHeldBooks();
+    for (size_t i = 0; i < heldBooks.size(); ++i) {
+      vector<int> queue = holds.getQueue(heldBooks[i]);
+      for (size_t j = 0; j < queue.size(); ++j) {
+        file << heldBooks[i] << endl        // Write book ISBN
+            << queue[j] << endl;            // Write member ID
+      }
+    }
+
+    // Save the last journal record this file includes (so replay skips the ones up to it)
+    file << journal.getLastSequence() << endl;
+
+    file.close();
+    if (!file) {
+      throw runtime_error("Error writing file");
+    }
+    replaceFile(tempName, filename);
+  }
+  catch (...) {
+    remove(tempName.c_str()); // Leave the old file as it was
+    throw;
+  }
+}
+
+// Load library data from file. The whole file is read into one buffer that book and member
+// text then points into; the sections are parsed in parallel once their first lines are found.
+bool Library::loadFromFile(const string &filename) {
+  if (MappedSnapshot::isSnapshotFile(filename)) {
+    return loadSnapshot(filename);
+  }
+
+  bool opened = false;
+  bool cleared = false;
+  vector<string> skippedBooks; // Reported once the rest of the file has loaded
+  try {
+    LineFile file(filename);
+    opened = true;
+
+    // Find where each section starts. Books and members have a fixed number of lines each;
+    // transactions are walked by type because borrows have one more line than returns.
+    size_t line = 0;
+    size_t bookCount = parseCount(file, line++);   // Read number of books
+    size_t firstBook = line;
+    line += 8 * bookCount;
+    size_t memberCount = parseCount(file, line++); // Read number of members
+    size_t firstMember = line;
+    line += 5 * memberCount;
+    size_t transactionCount = parseCount(file, line++); // Read number of transactions
+    size_t firstTransaction = line;
+    for (size_t i = 0; i < transactionCount; ++i) {
+      const char* type = line < file.lineCount() ? file.line(line) : "";
+      if (strcmp(type, "borrow") == 0) {
+        line += 5;
+      } else if (strcmp(type, "return") == 0) {
+        line += 4;
+      } else if (line >= file.lineCount()) {
+        break; // Reported below
+      } else {
+        throw errorAtLine(line, runtime_error(string("Unknown transaction type: ") + type));
+      }
+    }
+    if (line > file.lineCount()) {
+      throw errorAtLine(file.lineCount(), runtime_error("Unexpected end of file")); // A section is cut short
+    }
+    size_t reservationCount = parseCount(file, line++); // Read number of reservations
+    size_t firstReservation = line;
+    const char* memberText = memberCount > 0 ? file.line(firstMember) : nullptr;
+    const char* historyText = transactionCount > 0 ? file.line(firstTransaction) : nullptr;
+
+    // Parse books, members and transactions at the same time (a lazy load parses members and
+    // transactions too, so a bad file is still rejected as a whole)
+    vector<ParsedBook> parsedBooks;
+    vector<ParsedMember> parsedMembers;
+    vector<HistoryRecord> parsedTransactions;
+    exception_ptr bookError, memberError, transactionError;
+    thread memberParser = startTask([&]() { parseMembers(LineCursor(memberText, firstMember), memberCount, parsedMembers); }, memberError);
+    thread transactionParser = startTask([&]() { parseTransactions(LineCursor(historyText, firstTransaction), transactionCount, parsedTransactions); }, transactionError);
+    try {
+      parseBooks(file, firstBook, bookCount, parsedBooks, skippedBooks);
+    } catch (...) {
+      bookError = current_exception();
+    }
+    memberParser.join();
+    transactionParser.join();
+    rethrowTaskError(bookError);
+    rethrowTaskError(memberError);
+    rethrowTaskError(transactionError);
+
+    clearLibrary(); // Clear existing books, members, transactions and reservations
+    cleared = true;
+    size_t bufferSize;
+    textPool.adoptBuffer(file.release(bufferSize), bufferSize); // Book and member text stays in the file buffer
+
+    // Load books (into the store first, then every index at once), skipping any whose ISBN could
+    // not be read or would hide an earlier book
+    books.reserve(parsedBooks.size());
+    vector<BookHandle> bookHandles(parsedBooks.size());
+    for (size_t i = 0; i < parsedBooks.size(); ++i) {
+      const ParsedBook &parsed = parsedBooks[i];
+      if (!parsed.isbn.isNull()) {
+        bookHandles[i] = books.insert(Book::fromPooledText(parsed.title, textPool.adopt(parsed.author), parsed.isbn,
+            parsed.pubDate, parsed.callNum, parsed.genre, parsed.isBorrowed, parsed.dueDay));
+      }
+    }
+    rebuildBookIndex();
+    if (bookIndex.size() != books.size()) {
+      vector<size_t> duplicates = duplicateIsbnBooks(firstBook, parsedBooks, skippedBooks);
+      for (size_t i = 0; i < duplicates.size(); ++i) {
+        books.erase(bookHandles[duplicates[i]]);
+      }
+      rebuildBookIndex();
+    }
+
+    // Replay the transactions onto the open loans (needed up front even when the history is not built)
+    for (size_t i = 0; i < parsedTransactions.size(); ++i) {
+      const HistoryRecord &parsed = parsedTransactions[i];
+      if (parsed.isBorrow) {
+        loans.openLoan(parseSavedIsbn(parsed.isbn), parsed.memberID);
+      } else {
+        loans.closeLoan(parseSavedIsbn(parsed.isbn));
+      }
+    }
+
+    // Load members and transactions, or leave them in the file buffer until they are first used
+    if (lazyLoading) {
+      deferred.members = true;
+      deferred.memberText = memberText;
+      deferred.memberCount = memberCount;
+      deferred.history = transactionCount;
+      deferred.historyText = historyText;
+    } else {
+      addParsedMembers(parsedMembers, members, memberIndex);
+      addHistory(parsedTransactions); // The older ones go straight into the archive
+    }
+
+    // Load reservations (in queue order)
+    size_t reservationLine = firstReservation;
+    try {
+      for (size_t i = 0; i < reservationCount; ++i) {
+        Isbn isbn = parseSavedIsbn(file.line(reservationLine));                                      // Read book ISBN
+        holds.enqueue(isbn, static_cast<int>(parseInteger(file.line(++reservationLine))));          // Read member id
+        ++reservationLine;
+      }
+    } catch (const exception &e) {
+      throw errorAtLine(reservationLine, e);
+    }
+    journal.startAfter(parseCount(file, firstReservation + 2 * reservationCount)); // Read last journal record (none in older files)
+  }
+  catch (const exception &e) {
+    if (!opened) { // Check for file errors
+      cerr << "Error opening file for reading: " << filename << endl;
+      return false;
+    }
+    if (cleared) {
+      clearLibrary(); // Don't keep a half-loaded library
+    }
+    cerr << "An error occurred while loading data: " << e.what() << endl;
+    return false;
+  }
+
+  for (size_t i = 0; i < skippedBooks.size(); ++i) {
+    cerr << filename << ", " << skippedBooks[i] << " (book skipped)" << endl;
+  }
+  cout << "Library data loaded successfully." << endl;
+  return true;
+}
+
+// Save library data as a binary snapshot (fixed-width records plus a string heap). Saving to the
+// snapshot that was last saved or loaded only appends what changed since then as a delta segment;
+// once the deltas reach half the size of the full segment the file is compacted (rewritten whole).
+bool Library::saveSnapshot(const string &filename) {
+  waitForBackgroundSave(); // It may be writing the same file
+  try {
+    bool append = canAppendSnapshot(filename);
+    uint64_t written = writeSnapshot(filename, append);
+    if (append) {
+      checkpoint.deltaBytes += written;
+    } else {
+      checkpoint.baseBytes = written;
+      checkpoint.deltaBytes = 0;
+      checkpoint.filename = filename;
+      checkpoint.stale = false;
+    }
+    resetCheckpointChanges();
+    journal.truncate(); // Every journaled change is in the snapshot now
+  }
+  catch (const exception &e) {
+    cerr << "An error occurred while saving data: " << e.what() << endl;
+    return false;
+  }
+  cout << "Library data saved successfully." << endl;
+  return true;
+}
+
+// Whether saving to a snapshot can append a delta instead of rewriting the whole file
+bool Library::canAppendSnapshot(const string &filename) const {
+  struct stat info;
+  return !checkpoint.stale && checkpoint.filename == filename
+      && checkpoint.deltaBytes < checkpoint.baseBytes / 2
+      && stat(filename.c_str(), &info) == 0 // The file must still be the one the changes are relative to
+      && static_cast<uint64_t>(info.st_size) == checkpoint.baseBytes + checkpoint.deltaBytes
+      && info.st_size % 8 == 0; // Appended segments must start aligned
+}
+
+// Write a full snapshot in place of the file, or append the changes since the checkpoint as a
+// delta segment. Returns the number of bytes written.
+uint64_t Library::writeSnapshot(const string &filename, bool append) const {
+  SnapshotWriter writer;
+  if (!append) {
+    addFullSections(writer);
+    return writer.write(filename);
+  }
+  if (!hasCheckpointChanges()) {
+    return 0;
+  }
+  addDeltaSections(writer);
+  return writer.write(filename, true);
+}
+
+/* Background Save Methods */
+// Start a save in a child process and return straight away. fork() gives the child a
+// copy-on-write view of the library as it is now, so nothing has to be copied up front and
+// changes made while it writes simply go in the next save.
+bool Library::startBackgroundSave(const string &filename) {
+  waitForBackgroundSave(); // One at a time
+  bool snapshot = hasSnapshotExtension(filename);
+  bool append = snapshot && canAppendSnapshot(filename);
+  try {
+    journal.rotate(); // The journal keeps only the changes this save will not include
+  }
+  catch (const exception &e) {
+    cerr << "An error occurred while saving data: " << e.what() << endl;
+    return false;
+  }
+
+  cout.flush(); // Otherwise the child would write out the same buffered output again
+  cerr.flush();
+  pid_t pid = fork();
+  if (pid < 0) {
+    cerr << "An error occurred while saving data: " << strerror(errno) << endl;
+    return false; // The rotated changes are replayed or saved later, so nothing is lost
+  }
+  if (pid == 0) {
+    int status = 0;
+    try {
+      if (snapshot) {
+        writeSnapshot(filename, append);
+      } else {
+        writeTextFile(filename);
+      }
+      journal.dropRotated();
+    }
+    catch (const exception &e) {
+      cerr << "An error occurred while saving data in the background: " << e.what() << endl;
+      status = 1;
+    }
+    _exit(status); // Skip destructors, which would close the parent's journal and free its mappings
+  }
+
+  saver.pid = pid;
+  saver.filename = filename;
+  saver.snapshot = snapshot;
+  saver.append = append;
+  if (snapshot) { // Track later changes against the snapshot being written
+    if (!append) {
+      checkpoint.filename = filename;
+      checkpoint.stale = false;
+    }
+    resetCheckpointChanges();
+  }
+  cout << "Saving to " << filename << " in the background." << endl;
+  return true;
+}
+
+void Library::pollBackgroundSave() {
+  reapBackgroundSave(false);
+}
+
+void Library::waitForBackgroundSave() {
+  reapBackgroundSave(true);
+}
+
+// Collect a background save that has finished and record how it went
+void Library::reapBackgroundSave(bool wait) {
+  if (saver.pid < 0) {
+    return;
+  }
+  int status = 0;
+  pid_t done;
+  do {
+    done = waitpid(saver.pid, &status, wait ? 0 : WNOHANG);
+  } while (done < 0 && errno == EINTR);
+  if (done == 0) {
+    return; // Still writing
+  }
+
+  bool saved = done == saver.pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+  if (saver.snapshot) {
+    struct stat info;
+    if (saved && stat(saver.filename.c_str(), &info) == 0) {
+      if (saver.append) {
+        checkpoint.deltaBytes = static_cast<uint64_t>(info.st_size) - checkpoint.baseBytes;
+      } else {
+        checkpoint.baseBytes = static_cast<uint64_t>(info.st_size);
+        checkpoint.deltaBytes = 0;
+      }
+    } else {
+      checkpoint.stale = true; // The next save rewrites the file whatever state it was left in
+    }
+  }
+  if (saved) {
+    cout << "Background save to " << saver.filename << " finished." << endl;
+  } else {
+    cout << "Background save to " << saver.filename << " failed; its changes are still in the journal." << endl;
+  }
+  saver = BackgroundSave();
+}
+
+// Add every book, member, transaction, open loan and reservation
+void Library::addFullSections(SnapshotWriter &writer) const {
+  loadDeferredMembers();
+  loadDeferredHistory();
+
+  // Books
+  vector<BookRecord> bookRecords;
+  bookRecords.reserve(books.size());
+  for (BookStore::const_iterator it = books.begin(); it != books.end(); ++it) {
+    bookRecords.push_back(makeBookRecord(writer, *it));
+  }
+  writer.addSection(BOOK_SECTION, bookRecords);
+  addCatalogSections(writer);
+
+  // Members
+  vector<MemberRecord> memberRecords;
+  memberRecords.reserve(members.size());
+  for (vector<Member>::const_iterator it = members.begin(); it != members.end(); ++it) {
+    memberRecords.push_back(makeMemberRecord(writer, *it));
+  }
+  writer.addSection(MEMBER_SECTION, memberRecords);
+
+  // Transactions (the archive's segments are saved as they are)
+  addArchiveSections(writer, 0);
+  vector<TransactionRecord> transactionRecords;
+  transactionRecords.reserve(transactions.size());
+  for (TransactionPool::const_iterator it = transactions.begin(); it != transactions.end(); ++it) {
+    transactionRecords.push_back(makeTransactionRecord(writer, *it));
+  }
+  writer.addSection(TRANSACTION_SECTION, transactionRecords);
+
+  // Open loans (stored so loading does not have to replay the history, which may have been deleted)
+  vector<ReservationRecord> loanRecords;
+  loanRecords.reserve(loans.size());
+  const unordered_map<Isbn, int> &borrowers = loans.getBorrowers();
+  for (unordered_map<Isbn, int>::const_iterator it = borrowers.begin(); it != borrowers.end(); ++it) {
+    loanRecords.push_back(makeKeyRecord(writer, it->first, it->second));
+  }
+  writer.addSection(LOAN_SECTION, loanRecords);
+
+  // Reservations
+  vector<ReservationRecord> reservationRecords;
+  reservationRecords.reserve(holds.size());
+  vector<Isbn> heldBooks = holds.getHeldBooks();
+  for (size_t i = 0; i < heldBooks.size(); ++i) {
+    addHoldRecords(writer, holds, heldBooks[i], reservationRecords);
+  }
+  writer.addSection(RESERVATION_SECTION, reservationRecords);
+  writer.addSection(JOURNAL_SEQUENCE_SECTION, vector<uint64_t>(1, journal.getLastSequence()));
+}
+
+// Add the catalog index read by CatalogView. Books are numbered in store order, the order the
+// book section lists them in, so the search index's postings (in slot order) stay sorted.
+void Library::addCatalogSections(SnapshotWriter &writer) const {
+  if (books.size() >= (1u << 30)) {
+    throw runtime_error("Too many books for the catalog index"); // Postings keep the fields in the low two bits
+  }
+  vector<const Book*> numbered;
+  vector<uint32_t> numberOfSlot;
+  numbered.reserve(books.size());
+  for (BookStore::const_iterator it = books.begin(); it != books.end(); ++it) {
+    uint32_t slot = it.handle().index;
+    if (slot >= numberOfSlot.size()) {
+      numberOfSlot.resize(slot + 1);
+    }
+    numberOfSlot[slot] = static_cast<uint32_t>(numbered.size());
+    numbered.push_back(&*it);
+  }
+
+  // Words and their postings
+  vector<CatalogWordRecord> words;
+  vector<uint32_t> postings;
+  vector<pair<uint32_t, uint32_t> > wordTrigrams; // (trigram, word number)
+  textIndex.forEachWord([&](const string &word, const vector<pair<BookHandle, unsigned char> > &found) {
+    CatalogWordRecord record = { writer.addString(word), static_cast<uint32_t>(postings.size()), static_cast<uint32_t>(found.size()) };
+    for (size_t i = 0; i < found.size(); ++i) {
+      postings.push_back(numberOfSlot[found[i].first.index] * 4 + found[i].second);
+    }
+    vector<uint32_t> grams = TrigramIndex::trigrams(word);
+    for (size_t i = 0; i < grams.size(); ++i) {
+      wordTrigrams.push_back(make_pair(grams[i], static_cast<uint32_t>(words.size())));
+    }
+    words.push_back(record);
+  });
+  if (postings.size() > UINT32_MAX || wordTrigrams.size() > UINT32_MAX) {
+    throw runtime_error("Catalog index is too large");
+  }
+  writer.addSection(CATALOG_WORD_SECTION, words);
+  writer.addSection(CATALOG_POSTING_SECTION, postings);
+
+  // Trigrams of the words (for fuzzy searches)
+  sort(wordTrigrams.begin(), wordTrigrams.end());
+  vector<CatalogTrigramRecord> trigrams;
+  vector<uint32_t> trigramWords;
+  trigramWords.reserve(wordTrigrams.size());
+  for (size_t i = 0; i < wordTrigrams.size(); ++i) {
+    if (trigrams.empty() || trigrams.back().trigram != wordTrigrams[i].first) {
+      CatalogTrigramRecord record = { wordTrigrams[i].first, static_cast<uint32_t>(i), 0 };
+      trigrams.push_back(record);
+    }
+    ++trigrams.back().wordCount;
+    trigramWords.push_back(wordTrigrams[i].second);
+  }
+  writer.addSection(CATALOG_TRIGRAM_SECTION, trigrams);
+  writer.addSection(CATALOG_TRIGRAM_WORD_SECTION, trigramWords);
+
+  // Books by ISBN and by publication date (ties stay in book order)
+  vector<uint32_t> order(numbered.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = static_cast<uint32_t>(i);
+  }
+  sort(order.begin(), order.end(), [&numbered](uint32_t a, uint32_t b) { return numbered[a]->getISBN() < numbered[b]->getISBN(); });
+  writer.addSection(CATALOG_ISBN_ORDER_SECTION, order);
+  sort(order.begin(), order.end(), [&numbered](uint32_t a, uint32_t b) {
+    return numbered[a]->getPubDate() != numbered[b]->getPubDate() ? numbered[a]->getPubDate() < numbered[b]->getPubDate() : a < b;
+  });
+  writer.addSection(CATALOG_DATE_ORDER_SECTION, order);
+}
+
+// Add only what changed since the last checkpoint (the current state of every changed key)
+void Library::addDeltaSections(SnapshotWriter &writer) const {
+  // Books and their loans
+  vector<BookRecord> bookRecords;
+  vector<uint32_t> deletedBooks;
+  vector<ReservationRecord> loanRecords;
+  vector<uint32_t> closedLoans;
+  for (unordered_set<Isbn>::const_iterator it = checkpoint.books.begin(); it != checkpoint.books.end(); ++it) {
+    const Book* book = findBook(*it);
+    if (book) {
+      bookRecords.push_back(makeBookRecord(writer, *book));
+    } else {
+      deletedBooks.push_back(writer.addString(it->toString()));
+    }
+    if (loans.isOnLoan(*it)) {
+      loanRecords.push_back(makeKeyRecord(writer, *it, loans.getBorrower(*it)));
+    } else {
+      closedLoans.push_back(writer.addString(it->toString()));
+    }
+  }
+  writer.addSection(DELETED_BOOK_SECTION, deletedBooks);
+  writer.addSection(BOOK_SECTION, bookRecords);
+  writer.addSection(CLOSED_LOAN_SECTION, closedLoans);
+  writer.addSection(LOAN_SECTION, loanRecords);
+
+  // Members
+  vector<MemberRecord> memberRecords;
+  vector<int32_t> deletedMembers;
+  for (unordered_set<int>::const_iterator it = checkpoint.members.begin(); it != checkpoint.members.end(); ++it) {
+    const Member* member = findMember(*it);
+    if (member) {
+      memberRecords.push_back(makeMemberRecord(writer, *member));
+    } else {
+      deletedMembers.push_back(*it);
+    }
+  }
+  writer.addSection(DELETED_MEMBER_SECTION, deletedMembers);
+  writer.addSection(MEMBER_SECTION, memberRecords);
+
+  // Transactions made since the checkpoint (after dropping the saved ones if the history was
+  // deleted, or the saved recent ones that have been archived since)
+  if (checkpoint.historyCleared) {
+    writer.addSection(CLEARED_HISTORY_SECTION, vector<uint8_t>(1, 1));
+  }
+  if (checkpoint.archivedTransactions > 0) {
+    writer.addSection(ARCHIVED_TRANSACTIONS_SECTION, vector<uint64_t>(1, checkpoint.archivedTransactions));
+  }
+  addArchiveSections(writer, checkpoint.archiveSegments);
+  vector<TransactionRecord> transactionRecords;
+  for (size_t i = checkpoint.transactions - deferred.history; i < transactions.size(); ++i) { // Deferred ones are all saved
+    transactionRecords.push_back(makeTransactionRecord(writer, transactions[i]));
+  }
+  writer.addSection(TRANSACTION_SECTION, transactionRecords);
+
+  // Reservations
+  vector<ReservationRecord> reservationRecords;
+  vector<uint32_t> cancelledReservations;
+  for (unordered_set<Isbn>::const_iterator it = checkpoint.reservations.begin(); it != checkpoint.reservations.end(); ++it) {
+    if (holds.isHeld(*it)) {
+      addHoldRecords(writer, holds, *it, reservationRecords);
+    } else {
+      cancelledReservations.push_back(writer.addString(it->toString()));
+    }
+  }
+  writer.addSection(CANCELLED_RESERVATION_SECTION, cancelledReservations);
+  writer.addSection(RESERVATION_SECTION, reservationRecords);
+  writer.addSection(JOURNAL_SEQUENCE_SECTION, vector<uint64_t>(1, journal.getLastSequence()));
+}
+
+// Add the archive's segments from one on (an index of their time ranges, then their bytes)
+void Library::addArchiveSections(SnapshotWriter &writer, size_t firstSegment) const {
+  vector<ArchiveIndexRecord> indexRecords;
+  vector<uint8_t> data;
+  for (size_t segment = firstSegment; segment < archive.segmentCount(); ++segment) {
+    const HistoryArchive::SegmentInfo &info = archive.getInfo(segment);
+    size_t size;
+    const uint8_t* bytes = archive.getData(segment, size);
+    ArchiveIndexRecord record = ArchiveIndexRecord();
+    record.minTime = info.minTime;
+    record.maxTime = info.maxTime;
+    record.offset = data.size();
+    record.count = info.count;
+    record.size = static_cast<uint32_t>(size);
+    indexRecords.push_back(record);
+    data.insert(data.end(), bytes, bytes + size);
+  }
+  writer.addSection(ARCHIVE_INDEX_SECTION, indexRecords);
+  writer.addSection(ARCHIVE_DATA_SECTION, data);
+}
+
+bool Library::hasCheckpointChanges() const {
+  return !checkpoint.books.empty() || !checkpoint.members.empty() || !checkpoint.reservations.empty()
+      || checkpoint.historyCleared || checkpoint.transactions != historySize()
+      || checkpoint.archivedTransactions > 0 || checkpoint.archiveSegments != archive.segmentCount();
+}
+
+// Start tracking changes from the current state
+void Library::resetCheckpointChanges() {
+  checkpoint.books.clear();
+  checkpoint.members.clear();
+  checkpoint.reservations.clear();
+  checkpoint.transactions = historySize();
+  checkpoint.archiveSegments = archive.segmentCount();
+  checkpoint.archivedTransactions = 0;
+  checkpoint.historyCleared = false;
+}
+
+void Library::setLazyLoading(bool lazy) {
+  lazyLoading = lazy;
+}
+
+// Replay the changes a crash left in the journal, then keep logging to it. Records the loaded
+// file already includes (a crash after saving but before the journal was emptied) are skipped.
+void Library::openJournal(const string &filename) {
+  try {
+    uint64_t saved = journal.getLastSequence();
+    vector<JournalEntry> entries = journal.open(filename);
+    size_t replayed = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+      if (entries[i].getSequence() == 0 || entries[i].getSequence() > saved) {
+        replayEntry(entries[i]);
+        ++replayed;
+      }
+    }
+    if (replayed > 0) {
+      cout << "Recovered " << replayed << " unsaved change(s) from " << filename << "." << endl;
+    }
+  }
+  catch (const exception &e) {
+    cerr << "An error occurred while replaying the journal: " << e.what() << endl;
+  }
+}
+
+// Load library data from a binary snapshot. The file is memory mapped and book and member
+// text is used in place (the mapping is handed to textPool, which unmaps it on the next load).
+bool Library::loadSnapshot(const string &filename) {
+  bool cleared = false;
+  try {
+    MappedSnapshot* snapshot = new MappedSnapshot(filename); // Throws before anything is cleared if the file is bad
+    clearLibrary();
+    cleared = true;
+    deferred.snapshot = snapshot; // Freed once its members and history are built (or by clearLibrary)
+
+    // Keep the mapping alive for as long as the books and members point into it
+    void* address;
+    size_t length;
+    snapshot->release(address, length);
+    textPool.adoptMapping(address, length);
+
+    // The full checkpoint first, then each delta saved after it. Members and the recent history
+    // are only counted here; they are built below, or on first use after a lazy load. The
+    // archive's segments are used in place.
+    deferred.members = true;
+    for (size_t segment = 0; segment < snapshot->segmentCount(); ++segment) {
+      applySnapshotBooks(*snapshot, segment);
+      applySnapshotArchive(*snapshot, segment);
+
+      size_t count;
+      snapshot->records<uint8_t>(segment, CLEARED_HISTORY_SECTION, count);
+      if (count > 0) {
+        deferred.history = 0;
+      }
+      const uint64_t* archived = snapshot->records<uint64_t>(segment, ARCHIVED_TRANSACTIONS_SECTION, count);
+      if (count > 0) {
+        if (archived[0] > deferred.history) {
+          throw runtime_error("Snapshot archives more transactions than it holds");
+        }
+        deferred.history -= static_cast<size_t>(archived[0]);
+      }
+      snapshot->records<TransactionRecord>(segment, TRANSACTION_SECTION, count);
+      deferred.history += count;
+      const uint64_t* sequence = snapshot->records<uint64_t>(segment, JOURNAL_SEQUENCE_SECTION, count);
+      if (count > 0) {
+        journal.startAfter(sequence[0]);
+      }
+    }
+
+    // Later saves to this file only need to append what changes from here
+    checkpoint.filename = filename;
+    checkpoint.stale = false;
+    checkpoint.baseBytes = snapshot->segmentSize(0);
+    checkpoint.deltaBytes = 0;
+    for (size_t segment = 1; segment < snapshot->segmentCount(); ++segment) {
+      checkpoint.deltaBytes += snapshot->segmentSize(segment);
+    }
+    resetCheckpointChanges();
+
+    if (!lazyLoading) {
+      buildDeferredMembers();
+      buildDeferredHistory();
+      releaseDeferredSnapshot();
+    }
+  }
+  catch (const exception &e) {
+    if (cleared) {
+      clearLibrary(); // Nothing may keep pointing into a snapshot that failed to load
+    }
+    cerr << "An error occurred while loading data: " << e.what() << endl;
+    return false;
+  }
+  cout << "Library data loaded successfully." << endl;
+  return true;
+}
+
+// Apply one segment of a snapshot on top of what is already loaded. Books, open loans and
+// reservations are always loaded together; members and history can be deferred by a lazy load.
+void Library::applySnapshotBooks(const MappedSnapshot &snapshot, size_t segment) {
+  size_t count;
+
+  // Books (deleted ones first, then new and changed ones)
+  const uint32_t* deletedBooks = snapshot.records<uint32_t>(segment, DELETED_BOOK_SECTION, count);
+  for (size_t i = 0; i < count; ++i) {
+    applyDeleteBook(parseSavedIsbn(snapshot.text(segment, deletedBooks[i])));
+  }
+  const BookRecord* bookRecords = snapshot.records<BookRecord>(segment, BOOK_SECTION, count);
+  books.reserve(books.size() + count);
+  bookIndex.reserve(bookIndex.size() + count);
+  for (size_t i = 0; i < count; ++i) {
+    const BookRecord &record = bookRecords[i];
+    if (record.genre > SCIENCE_FICTION) {
+      throw runtime_error("Unknown genre in snapshot");
+    }
+    Book book = Book::fromPooledText(snapshot.text(segment, record.title), textPool.adopt(snapshot.text(segment, record.author)),
+        parseSavedIsbn(snapshot.text(segment, record.isbn)), record.pubDate, snapshot.text(segment, record.callNum),
+        static_cast<genreType>(record.genre), record.isBorrowed != 0, parseBookDueDate(snapshot.text(segment, record.dueDate)));
+    if (bookIndex.count(book.getISBN())) {
+      applyEditBook(book.getISBN(), book);
+    } else {
+      applyAddBook(book);
+    }
+  }
+
+  // Open loans
+  const uint32_t* closedLoans = snapshot.records<uint32_t>(segment, CLOSED_LOAN_SECTION, count);
+  for (size_t i = 0; i < count; ++i) {
+    loans.closeLoan(parseSavedIsbn(snapshot.text(segment, closedLoans[i])));
+  }
+  const ReservationRecord* loanRecords = snapshot.records<ReservationRecord>(segment, LOAN_SECTION, count);
+  for (size_t i = 0; i < count; ++i) {
+    loans.openLoan(parseSavedIsbn(snapshot.text(segment, loanRecords[i].isbn)), loanRecords[i].memberID);
+  }
+
+  // Reservations (a book's records replace its whole queue, in order)
+  const uint32_t* cancelledReservations = snapshot.records<uint32_t>(segment, CANCELLED_RESERVATION_SECTION, count);
+  for (size_t i = 0; i < count; ++i) {
+    holds.cancelAll(parseSavedIsbn(snapshot.text(segment, cancelledReservations[i])));
+  }
+  const ReservationRecord* reservationRecords = snapshot.records<ReservationRecord>(segment, RESERVATION_SECTION, count);
+  unordered_set<Isbn> replaced;
+  for (size_t i = 0; i < count; ++i) {
+    Isbn isbn = parseSavedIsbn(snapshot.text(segment, reservationRecords[i].isbn));
+    if (replaced.insert(isbn).second) {
+      holds.cancelAll(isbn);
+    }
+    holds.enqueue(isbn, reservationRecords[i].memberID);
+  }
+}
+
+void Library::applySnapshotMembers(const MappedSnapshot &snapshot, size_t segment) {
+  size_t count;
+
+  const int32_t* deletedMembers = snapshot.records<int32_t>(segment, DELETED_MEMBER_SECTION, count);
+  for (size_t i = 0; i < count; ++i) {
+    applyDeleteMember(deletedMembers[i]);
+  }
+  const MemberRecord* memberRecords = snapshot.records<MemberRecord>(segment, MEMBER_SECTION, count);
+  members.reserve(members.size() + count);
+  memberIndex.reserve(memberIndex.size() + count);
+  for (size_t i = 0; i < count; ++i) {
+    const MemberRecord &record = memberRecords[i];
+    Member member = Member::fromPooledText(snapshot.text(segment, record.name), record.memberID,
+        snapshot.text(segment, record.phone), snapshot.text(segment, record.email), snapshot.text(segment, record.address));
+    if (memberIndex.count(record.memberID)) {
+      applyEditMember(record.memberID, member);
+    } else {
+      applyRegisterMember(member);
+    }
+  }
+}
+
+// Add a segment's archived history segments to the archive (their bytes stay in the mapping)
+void Library::applySnapshotArchive(const MappedSnapshot &snapshot, size_t segment) {
+  size_t count, size;
+
+  // A delta saved after the history was deleted drops everything before it
+  snapshot.records<uint8_t>(segment, CLEARED_HISTORY_SECTION, count);
+  if (count > 0) {
+    archive.clear();
+  }
+  const uint8_t* data = snapshot.records<uint8_t>(segment, ARCHIVE_DATA_SECTION, size);
+  const ArchiveIndexRecord* indexRecords = snapshot.records<ArchiveIndexRecord>(segment, ARCHIVE_INDEX_SECTION, count);
+  for (size_t i = 0; i < count; ++i) {
+    const ArchiveIndexRecord &record = indexRecords[i];
+    if (record.offset > size || record.size > size - record.offset) {
+      throw runtime_error("Archived history segment is outside the snapshot");
+    }
+    HistoryArchive::SegmentInfo info = { record.minTime, record.maxTime, record.count };
+    archive.adopt(info, data + record.offset, record.size);
+  }
+}
+
+// Add a segment's recent transactions to history (their text points into the snapshot)
+void Library::applySnapshotHistory(const MappedSnapshot &snapshot, size_t segment, vector<HistoryRecord> &history) const {
+  size_t count;
+
+  // A delta saved after the history was deleted drops everything before it, and one saved
+  // after the oldest recent transactions were archived drops those
+  snapshot.records<uint8_t>(segment, CLEARED_HISTORY_SECTION, count);
+  if (count > 0) {
+    history.clear();
+  }
+  const uint64_t* archived = snapshot.records<uint64_t>(segment, ARCHIVED_TRANSACTIONS_SECTION, count);
+  if (count > 0) {
+    history.erase(history.begin(), history.begin() + min(static_cast<size_t>(archived[0]), history.size()));
+  }
+  const TransactionRecord* transactionRecords = snapshot.records<TransactionRecord>(segment, TRANSACTION_SECTION, count);
+  history.reserve(history.size() + count);
+  for (size_t i = 0; i < count; ++i) {
+    const TransactionRecord &record = transactionRecords[i];
+    if (record.type != BORROW_RECORD && record.type != RETURN_RECORD) {
+      throw runtime_error("Unknown transaction type in snapshot");
+    }
+    HistoryRecord transaction = { record.type == BORROW_RECORD, snapshot.text(segment, record.isbn), record.memberID,
+        static_cast<time_t>(record.transactionDate), nullptr };
+    if (transaction.isBorrow) {
+      transaction.dueDate = snapshot.text(segment, record.dueDate);
+    }
+    history.push_back(transaction);
+  }
+}
+
+// Getters
+const BookStore& Library::getBooks() const { return books; }
+const vector<Member>& Library::getMembers() const {
+  loadDeferredMembers();
+  return members;
+}
+const HoldTable& Library::getHolds() const { return holds; }
+const TransactionPool& Library::getTransactions() const {
+  loadDeferredHistory();
+  return transactions;
+}
+size_t Library::getTransactionCount() const { return archive.size() + historySize(); }
+
+// Setters
+void Library::setBooks(const vector<Book> &books) {
+  this->books.clear();
+  this->books.reserve(books.size());
+  for (size_t i = 0; i < books.size(); ++i) {
+    this->books.insert(pooledCopy(books[i]));
+  }
+  rebuildBookIndex();
+  checkpoint.stale = true;
+}
+void Library::setMembers(const vector<Member> &members) {
+  deferred.members = false; // Replaced, so there is nothing left to build
+  releaseDeferredSnapshot();
+  this->members.clear();
+  this->members.reserve(members.size());
+  for (size_t i = 0; i < members.size(); ++i) {
+    this->members.push_back(pooledCopy(members[i]));
+  }
+  rebuildMemberIndex();
+  checkpoint.stale = true;
+}
+void Library::setHolds(const HoldTable &holds) {
+  this->holds = holds;
+  checkpoint.stale = true;
+}
+void Library::setTransactions(const TransactionPool &transactions) {
+  deferred.history = 0; // Replaced, so there is nothing left to build
+  releaseDeferredSnapshot();
+  archive.clear();
+  this->transactions = transactions;
+  rebuildLoans();
+  checkpoint.stale = true;
+}
+
+// Constructor
+Library::Library() : lazyLoading(false) {}
 
 // Destructor
 Library::~Library() {
-  // Deallocate memory for transactions
-  for (size_t i = 0; i < transactions.size(); ++i) {
-    delete transactions[i];
-  }
+  delete deferred.snapshot;
 }
@@ -0,0 +1,128 @@
+/* Program name: LineFile.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the line file class methods
+*/
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "LineFile.h"
+
+using namespace std;
+
+namespace {
+    const size_t MIN_CHUNK = 1 << 20; // Smaller files are split on one thread
+
+    // Turn each '\n' in [begin, end) into a NUL and record where the following line starts
+    void splitLines(char* begin, char* end, vector<const char*> &starts) {
+        char* p = begin;
+        while (p < end) {
+            char* newline = static_cast<char*>(memchr(p, '\n', end - p));
+            if (!newline) {
+                break;
+            }
+            *newline = '\0';
+            starts.push_back(newline + 1);
+            p = newline + 1;
+        }
+    }
+}
+
+// Read the file and find every line, splitting large files across threads
+LineFile::LineFile(const string &filename) : buffer(nullptr), size(0) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("Unable to open file for reading");
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw runtime_error("Unable to read file");
+    }
+    size = static_cast<size_t>(info.st_size);
+    buffer = new char[size + 1];
+    size_t done = 0;
+    while (done < size) {
+        ssize_t count = read(fd, buffer + done, size - done);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            close(fd);
+            delete[] buffer;
+            throw runtime_error("Unable to read file");
+        }
+        done += static_cast<size_t>(count);
+    }
+    close(fd);
+    buffer[size] = '\0'; // So the last line is terminated even without a final newline
+
+    // Each thread splits one chunk; the chunks' line starts are then joined in order
+    size_t threads = thread::hardware_concurrency();
+    if (threads == 0) {
+        threads = 1;
+    }
+    if (threads > size / MIN_CHUNK + 1) {
+        threads = size / MIN_CHUNK + 1;
+    }
+    vector<vector<const char*> > starts(threads);
+    vector<thread> workers;
+    size_t chunk = size / threads + 1;
+    for (size_t i = 0; i < threads; ++i) {
+        char* begin = buffer + (i * chunk < size ? i * chunk : size);
+        char* end = buffer + ((i + 1) * chunk < size ? (i + 1) * chunk : size);
+        if (i + 1 < threads) {
+            workers.push_back(thread(splitLines, begin, end, ref(starts[i])));
+        } else {
+            splitLines(begin, end, starts[i]);
+        }
+    }
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+
+    size_t total = 1;
+    for (size_t i = 0; i < threads; ++i) {
+        total += starts[i].size();
+    }
+    lines.reserve(total);
+    if (size > 0) {
+        lines.push_back(buffer);
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        lines.insert(lines.end(), starts[i].begin(), starts[i].end());
+    }
+    if (!lines.empty() && lines.back() == buffer + size) {
+        lines.pop_back(); // A final newline does not start another line
+    }
+}
+
+LineFile::~LineFile() {
+    delete[] buffer;
+}
+
+size_t LineFile::lineCount() const { return lines.size(); }
+
+const char* LineFile::line(size_t index) const {
+    if (index >= lines.size()) {
+        throw runtime_error("Unexpected end of file");
+    }
+    return lines[index];
+}
+
+char* LineFile::release(size_t &size) {
+    char* released = buffer;
+    size = this->size + 1;
+    buffer = nullptr;
+    return released;
+}
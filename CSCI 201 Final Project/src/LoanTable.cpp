@@ -0,0 +1,62 @@
+/* Program name: LoanTable.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the loan table class methods
+*/
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "LoanTable.h"
+
+using namespace std;
+
+// Open and close loans
+void LoanTable::openLoan(const Isbn &ISBN, int memberID) {
+    closeLoan(ISBN); // A book can only be out to one member at a time
+    borrowerByISBN[ISBN] = memberID;
+    loansByMember[memberID].insert(ISBN);
+}
+
+void LoanTable::closeLoan(const Isbn &ISBN) {
+    unordered_map<Isbn, int>::iterator it = borrowerByISBN.find(ISBN);
+    if (it == borrowerByISBN.end()) {
+        return;
+    }
+
+    // Remove the ISBN from the member's set, dropping the set once it is empty
+    unordered_map<int, unordered_set<Isbn> >::iterator member = loansByMember.find(it->second);
+    if (member != loansByMember.end()) {
+        member->second.erase(ISBN);
+        if (member->second.empty()) {
+            loansByMember.erase(member);
+        }
+    }
+    borrowerByISBN.erase(it);
+}
+
+void LoanTable::clear() {
+    borrowerByISBN.clear();
+    loansByMember.clear();
+}
+
+// Queries
+bool LoanTable::isOnLoan(const Isbn &ISBN) const { return borrowerByISBN.count(ISBN) != 0; }
+
+int LoanTable::getBorrower(const Isbn &ISBN) const {
+    unordered_map<Isbn, int>::const_iterator it = borrowerByISBN.find(ISBN);
+    return it != borrowerByISBN.end() ? it->second : -1;
+}
+
+bool LoanTable::hasLoans(int memberID) const { return loansByMember.count(memberID) != 0; }
+
+const unordered_set<Isbn>& LoanTable::getLoans(int memberID) const {
+    static const unordered_set<Isbn> none;
+    unordered_map<int, unordered_set<Isbn> >::const_iterator it = loansByMember.find(memberID);
+    return it != loansByMember.end() ? it->second : none;
+}
+
+const unordered_map<Isbn, int>& LoanTable::getBorrowers() const { return borrowerByISBN; }
+
+size_t LoanTable::size() const { return borrowerByISBN.size(); }
@@ -1,6 +1,6 @@
 /* Program name: Member.cpp
 * Author: Joshua Yin
-* Date last updated: 7/24/2024
+* Date last updated: 10/17/2026
 * Purpose: Implement the member class methods
 */
 
@@ -12,22 +12,30 @@
 using namespace std;
 
 // Constructor
-Member::Member(string n, int i, string p, string e, string a)
+Member::Member(TextPool &text, string n, int i, string p, string e, string a)
+    : name(text.store(n)), memberID(i), phone(text.store(p)),
+      email(text.store(e)), address(text.store(a)) {}
+
+Member::Member(const char* n, int i, const char* p, const char* e, const char* a)
     : name(n), memberID(i), phone(p), email(e), address(a) {}
 
+Member Member::fromPooledText(const char* n, int i, const char* p, const char* e, const char* a) {
+    return Member(n, i, p, e, a);
+}
+
 // Getters
-string Member::getName() const { return name; }
+const char* Member::getName() const { return name; }
 int Member::getMemberID() const { return memberID; }
-string Member::getPhone() const { return phone; }
-string Member::getEmail() const { return email; }
-string Member::getAddress() const { return address; }
+const char* Member::getPhone() const { return phone; }
+const char* Member::getEmail() const { return email; }
+const char* Member::getAddress() const { return address; }
 
 // Setters
-void Member::setName(const string &n) { name = n; }
+void Member::setName(TextPool &text, const string &n) { name = text.store(n); }
 void Member::setMemberID(int i) { memberID = i; }
-void Member::setPhone(const string &p) { phone = p; }
-void Member::setEmail(const string &e) { email = e; }
-void Member::setAddress(const string &a) { address = a; }
+void Member::setPhone(TextPool &text, const string &p) { phone = text.store(p); }
+void Member::setEmail(TextPool &text, const string &e) { email = text.store(e); }
+void Member::setAddress(TextPool &text, const string &a) { address = text.store(a); }
 
 // Display member details
 void Member::display() const {
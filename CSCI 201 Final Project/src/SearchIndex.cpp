@@ -0,0 +1,249 @@
+/* Program name: SearchIndex.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the search index class methods
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SearchIndex.h"
+
+using namespace std;
+
+/* Helper Functions */
+namespace {
+    bool resultBefore(const SearchResult &a, const SearchResult &b) {
+        if (a.score != b.score) {
+            return a.score > b.score; // Higher scores first
+        }
+        return a.book.index < b.book.index; // Then catalog order
+    }
+
+    // Check if word starts with prefix
+    bool hasPrefix(const string &word, const string &prefix) {
+        return word.compare(0, prefix.size(), prefix) == 0;
+    }
+}
+
+// Order postings by slot so lists can be searched with lower_bound
+bool SearchIndex::postingBefore(const Posting &posting, uint32_t slot) {
+    return posting.book.index < slot;
+}
+
+// Split text into lowercase words. Apostrophes and periods are dropped without
+// splitting ("Ender's" -> "enders"), any other punctuation or space splits words.
+vector<string> SearchIndex::tokenize(const string &text) {
+    vector<string> words;
+    string word;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (isalnum(c) || c >= 0x80) { // Keep non-ASCII bytes so UTF-8 letters stay in words
+            word += static_cast<char>(tolower(c));
+        } else if (c != '\'' && c != '.') {
+            if (!word.empty()) {
+                words.push_back(word);
+                word.clear();
+            }
+        }
+    }
+    if (!word.empty()) {
+        words.push_back(word);
+    }
+    return words;
+}
+
+void SearchIndex::addWords(BookHandle book, const string &text, unsigned char field) {
+    vector<string> words = tokenize(text);
+    for (size_t i = 0; i < words.size(); ++i) {
+        vector<Posting> &list = postings[words[i]];
+        if (list.empty()) {
+            vocabulary.add(words[i]); // First book with this word
+        }
+        vector<Posting>::iterator it = lower_bound(list.begin(), list.end(), book.index, postingBefore);
+        if (it != list.end() && it->book.index == book.index) {
+            it->fields |= field; // Word already seen for this book (repeated word or other field)
+        } else {
+            Posting posting = { book, field };
+            list.insert(it, posting);
+        }
+    }
+}
+
+void SearchIndex::removeWords(BookHandle book, const string &text, unsigned char field) {
+    vector<string> words = tokenize(text);
+    for (size_t i = 0; i < words.size(); ++i) {
+        map<string, vector<Posting> >::iterator entry = postings.find(words[i]);
+        if (entry == postings.end()) {
+            continue;
+        }
+        vector<Posting> &list = entry->second;
+        vector<Posting>::iterator it = lower_bound(list.begin(), list.end(), book.index, postingBefore);
+        if (it == list.end() || it->book != book) {
+            continue;
+        }
+        it->fields &= ~field;
+        if (it->fields == 0) {
+            list.erase(it);
+            if (list.empty()) {
+                vocabulary.remove(entry->first);
+                postings.erase(entry);
+            }
+        }
+    }
+}
+
+// Keep the index in sync with the catalog
+void SearchIndex::add(BookHandle book, const Book &data) {
+    addWords(book, data.getTitle(), TITLE_FIELD);
+    addWords(book, data.getAuthor(), AUTHOR_FIELD);
+}
+
+void SearchIndex::remove(BookHandle book, const Book &data) {
+    removeWords(book, data.getTitle(), TITLE_FIELD);
+    removeWords(book, data.getAuthor(), AUTHOR_FIELD);
+}
+
+void SearchIndex::clear() {
+    postings.clear();
+    vocabulary.clear();
+}
+
+// Fold one query word into the candidates. Each match is a posting list of an indexed
+// word and how well that word matches; title hits count double. Only books that already
+// matched the earlier words are kept, so the candidate set can only shrink.
+void SearchIndex::mergeWord(CandidateMap &candidates, const vector<WordMatch> &matches, unsigned char fields, bool firstWord) {
+    unordered_map<uint32_t, int> best; // Slot -> best score for this word
+    for (size_t m = 0; m < matches.size(); ++m) {
+        const vector<Posting> &list = *matches[m].list;
+        for (vector<Posting>::const_iterator p = list.begin(); p != list.end(); ++p) {
+            unsigned char matched = p->fields & fields;
+            if (matched == 0 || (!firstWord && !candidates.count(p->book.index))) {
+                continue;
+            }
+            int score = matches[m].weight * ((matched & TITLE_FIELD) ? 2 : 1);
+            int &current = best[p->book.index];
+            if (score > current) {
+                current = score;
+            }
+            if (firstWord && !candidates.count(p->book.index)) {
+                SearchResult result = { p->book, 0 };
+                candidates[p->book.index] = result;
+            }
+        }
+    }
+
+    // Keep only books that matched this word too
+    for (CandidateMap::iterator c = candidates.begin(); c != candidates.end();) {
+        unordered_map<uint32_t, int>::const_iterator hit = best.find(c->first);
+        if (hit == best.end()) {
+            c = candidates.erase(c);
+        } else {
+            c->second.score += hit->second;
+            ++c;
+        }
+    }
+}
+
+// Best limit candidates, highest score first
+vector<SearchResult> SearchIndex::rank(const CandidateMap &candidates, size_t limit) {
+    vector<SearchResult> results;
+    results.reserve(candidates.size());
+    for (CandidateMap::const_iterator c = candidates.begin(); c != candidates.end(); ++c) {
+        results.push_back(c->second);
+    }
+    size_t count = min(limit, results.size());
+    partial_sort(results.begin(), results.begin() + count, results.end(), resultBefore);
+    results.resize(count);
+    return results;
+}
+
+// Find books containing every query word. Each query word matches indexed words
+// it is a prefix of; exact words and title words score higher than prefixes and authors.
+vector<SearchResult> SearchIndex::search(const string &query, unsigned char fields, size_t limit) const {
+    vector<string> words = tokenize(query);
+    if (words.empty()) {
+        return vector<SearchResult>();
+    }
+
+    // Start from the query word with the fewest postings so the candidate set stays small
+    vector<pair<size_t, string> > ordered;
+    for (size_t i = 0; i < words.size(); ++i) {
+        size_t volume = 0;
+        map<string, vector<Posting> >::const_iterator it = postings.lower_bound(words[i]);
+        for (; it != postings.end() && hasPrefix(it->first, words[i]); ++it) {
+            volume += it->second.size();
+        }
+        if (volume == 0) {
+            return vector<SearchResult>(); // A word with no matches means no book matches them all
+        }
+        ordered.push_back(make_pair(volume, words[i]));
+    }
+    sort(ordered.begin(), ordered.end());
+
+    CandidateMap candidates;
+    for (size_t w = 0; w < ordered.size() && (w == 0 || !candidates.empty()); ++w) {
+        const string &word = ordered[w].second;
+        vector<WordMatch> matches;
+        map<string, vector<Posting> >::const_iterator it = postings.lower_bound(word);
+        for (; it != postings.end() && hasPrefix(it->first, word); ++it) {
+            WordMatch match = { &it->second, it->first.size() == word.size() ? 2 : 1 }; // Exact words beat prefixes
+            matches.push_back(match);
+        }
+        mergeWord(candidates, matches, fields, w == 0);
+    }
+    return rank(candidates, limit);
+}
+
+// Find books containing, for every query word, an indexed word within a few typos of it.
+// Only the vocabulary is compared against the query; books come from the matched words' postings.
+vector<SearchResult> SearchIndex::fuzzySearch(const string &query, unsigned char fields, size_t limit) const {
+    vector<string> words = tokenize(query);
+    if (words.empty()) {
+        return vector<SearchResult>();
+    }
+
+    CandidateMap candidates;
+    for (size_t w = 0; w < words.size() && (w == 0 || !candidates.empty()); ++w) {
+        int maxDistance = TrigramIndex::maxTypos(words[w].size());
+        vector<pair<string, int> > similar = vocabulary.similarWords(words[w], maxDistance, 32);
+
+        vector<WordMatch> matches;
+        for (size_t i = 0; i < similar.size(); ++i) {
+            WordMatch match = { &postings.find(similar[i].first)->second, maxDistance + 1 - similar[i].second }; // Fewer typos score higher
+            matches.push_back(match);
+        }
+        mergeWord(candidates, matches, fields, w == 0);
+    }
+    return rank(candidates, limit);
+}
+
+// Indexed words starting with prefix, most common first
+vector<string> SearchIndex::complete(const string &prefix, size_t limit) const {
+    vector<pair<size_t, string> > matches;
+    vector<string> words = tokenize(prefix);
+    string normalized = words.empty() ? "" : words.back(); // Complete the last word being typed
+
+    map<string, vector<Posting> >::const_iterator it = postings.lower_bound(normalized);
+    for (; it != postings.end() && hasPrefix(it->first, normalized); ++it) {
+        matches.push_back(make_pair(it->second.size(), it->first));
+    }
+
+    // Most books first, then alphabetical
+    size_t count = min(limit, matches.size());
+    partial_sort(matches.begin(), matches.begin() + count, matches.end(),
+        [](const pair<size_t, string> &a, const pair<size_t, string> &b) {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        });
+
+    vector<string> completions;
+    for (size_t i = 0; i < count; ++i) {
+        completions.push_back(matches[i].second);
+    }
+    return completions;
+}
@@ -0,0 +1,39 @@
+/* Program name: SearchQuery.cpp
+* Author: Joshua Yin
+* Date last updated: 10/18/2026
+* Purpose: Implement the search query parsers
+*/
+
+#include <map>
+#include <sstream>
+#include <string>
+
+#include "SearchQuery.h"
+
+using namespace std;
+
+bool parseGenreName(const string &name, genreType &genre) {
+    for (map<genreType, string>::const_iterator it = genreNames.begin(); it != genreNames.end(); ++it) {
+        if (it->second == name) {
+            genre = it->first;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseYearRange(const string &query, int &fromYear, int &toYear) {
+    stringstream ss(query);
+    char dash;
+    if (!(ss >> fromYear)) {
+        return false;
+    }
+    toYear = fromYear;
+    if (ss >> dash) {
+        if (dash != '-' || !(ss >> toYear)) {
+            return false;
+        }
+    }
+    ss >> ws;
+    return ss.eof();
+}
@@ -0,0 +1,250 @@
+/* Program name: Snapshot.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the snapshot writer and mapped snapshot reader
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "DurableFile.h"
+#include "Snapshot.h"
+
+using namespace std;
+
+// Record layouts are part of the file format, so catch accidental changes at compile time
+static_assert(sizeof(SnapshotHeader) == 24, "SnapshotHeader layout changed");
+static_assert(sizeof(SnapshotSection) == 24, "SnapshotSection layout changed");
+static_assert(sizeof(BookRecord) == 28, "BookRecord layout changed");
+static_assert(sizeof(MemberRecord) == 20, "MemberRecord layout changed");
+static_assert(sizeof(TransactionRecord) == 24, "TransactionRecord layout changed");
+static_assert(sizeof(ReservationRecord) == 8, "ReservationRecord layout changed");
+static_assert(sizeof(CatalogWordRecord) == 12, "CatalogWordRecord layout changed");
+static_assert(sizeof(CatalogTrigramRecord) == 12, "CatalogTrigramRecord layout changed");
+
+namespace {
+    uint64_t alignTo8(uint64_t offset) { return (offset + 7) & ~static_cast<uint64_t>(7); }
+}
+
+SnapshotWriter::SnapshotWriter() {
+    addString(""); // Offset 0 is always the empty string
+}
+
+// Add text to the string heap, reusing the offset if it was added before
+uint32_t SnapshotWriter::addString(const string &text) {
+    unordered_map<string, uint32_t>::const_iterator it = stringOffsets.find(text);
+    if (it != stringOffsets.end()) {
+        return it->second;
+    }
+    if (strings.size() + text.size() + 1 > UINT32_MAX) {
+        throw runtime_error("Snapshot string heap is full");
+    }
+    uint32_t offset = static_cast<uint32_t>(strings.size());
+    strings.insert(strings.end(), text.begin(), text.end());
+    strings.push_back('\0');
+    stringOffsets[text] = offset;
+    return offset;
+}
+
+// Lay out the header, section table, sections and string heap in one buffer and write it
+uint64_t SnapshotWriter::write(const string &filename, bool append) const {
+    uint32_t sectionCount = static_cast<uint32_t>(sections.size() + 1); // Plus the string section
+    vector<SnapshotSection> table(sectionCount);
+
+    uint64_t offset = alignTo8(sizeof(SnapshotHeader) + sectionCount * sizeof(SnapshotSection));
+    for (size_t i = 0; i < sections.size(); ++i) {
+        table[i].type = sections[i].type;
+        table[i].recordSize = sections[i].recordSize;
+        table[i].offset = offset;
+        table[i].count = sections[i].count;
+        offset = alignTo8(offset + sections[i].data.size());
+    }
+    table.back().type = STRING_SECTION;
+    table.back().recordSize = 1;
+    table.back().offset = offset;
+    table.back().count = strings.size();
+    offset = alignTo8(offset + strings.size()); // So a segment appended after this one stays aligned
+
+    SnapshotHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.sectionCount = sectionCount;
+    header.segmentSize = offset;
+
+    vector<char> buffer(offset, '\0');
+    memcpy(&buffer[0], &header, sizeof(header));
+    memcpy(&buffer[sizeof(header)], table.data(), sectionCount * sizeof(SnapshotSection));
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (!sections[i].data.empty()) {
+            memcpy(&buffer[table[i].offset], sections[i].data.data(), sections[i].data.size());
+        }
+    }
+    if (!strings.empty()) {
+        memcpy(&buffer[table.back().offset], strings.data(), strings.size());
+    }
+
+    string target = append ? filename : temporaryName(filename);
+    ofstream file(target.c_str(), ios::binary | (append ? ios::app : ios::trunc));
+    if (!file) {
+        throw runtime_error("Unable to open file for writing");
+    }
+    file.write(&buffer[0], buffer.size());
+    file.close();
+    try {
+        if (!file) {
+            throw runtime_error("Error writing snapshot");
+        }
+        if (append) {
+            syncFile(filename);
+        } else {
+            replaceFile(target, filename);
+        }
+    } catch (...) {
+        if (!append) {
+            remove(target.c_str());
+        }
+        throw;
+    }
+    return buffer.size();
+}
+
+// Map the file and check every segment
+MappedSnapshot::MappedSnapshot(const string &filename) : data(nullptr), length(0) {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("Unable to open file for reading");
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+        close(fd);
+        throw runtime_error("Snapshot is too short");
+    }
+    length = static_cast<size_t>(info.st_size);
+    void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file contents alive
+    if (address == MAP_FAILED) {
+        throw runtime_error("Unable to map snapshot");
+    }
+    data = static_cast<char*>(address);
+
+    try {
+        size_t offset = 0;
+        while (offset < length) {
+            // A delta cut short by a crash while it was being appended is ignored (the library
+            // sees the file no longer matches its checkpoint, so the next save rewrites it)
+            const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(data + offset);
+            if (offset > 0 && (length - offset < sizeof(SnapshotHeader) || header->segmentSize > length - offset)) {
+                break;
+            }
+            validateSegment(offset);
+            offset = static_cast<size_t>(alignTo8(offset + reinterpret_cast<const SnapshotHeader*>(data + offset)->segmentSize));
+        }
+    } catch (...) {
+        munmap(data, length);
+        throw;
+    }
+}
+
+MappedSnapshot::~MappedSnapshot() {
+    if (data) {
+        munmap(data, length);
+    }
+}
+
+// Check that a segment's header and every section fit inside the file, then remember it
+void MappedSnapshot::validateSegment(size_t offset) {
+    if (length - offset < sizeof(SnapshotHeader)) {
+        throw runtime_error("Snapshot is truncated");
+    }
+    const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(data + offset);
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0) {
+        throw runtime_error("Not a library snapshot");
+    }
+    if (header->version != SNAPSHOT_VERSION) {
+        throw runtime_error("Unsupported snapshot version");
+    }
+    uint64_t tableEnd = sizeof(SnapshotHeader) + static_cast<uint64_t>(header->sectionCount) * sizeof(SnapshotSection);
+    if (header->segmentSize > length - offset || tableEnd > header->segmentSize) {
+        throw runtime_error("Snapshot is truncated");
+    }
+
+    Segment segment;
+    segment.start = data + offset;
+    segment.strings = nullptr;
+    segment.stringsSize = 0;
+    const SnapshotSection* table = reinterpret_cast<const SnapshotSection*>(segment.start + sizeof(SnapshotHeader));
+    for (uint32_t i = 0; i < header->sectionCount; ++i) {
+        uint64_t size = table[i].count * table[i].recordSize;
+        if (table[i].offset % 8 != 0 || table[i].offset > header->segmentSize
+            || (table[i].recordSize != 0 && table[i].count > header->segmentSize / table[i].recordSize)
+            || size > header->segmentSize - table[i].offset) {
+            throw runtime_error("Snapshot section is out of range");
+        }
+        if (table[i].type == STRING_SECTION) {
+            segment.strings = segment.start + table[i].offset;
+            segment.stringsSize = static_cast<size_t>(table[i].count);
+        }
+    }
+    if (segment.stringsSize == 0 || segment.strings[segment.stringsSize - 1] != '\0') {
+        throw runtime_error("Snapshot string heap is malformed");
+    }
+    segments.push_back(segment);
+}
+
+size_t MappedSnapshot::segmentCount() const { return segments.size(); }
+
+size_t MappedSnapshot::segmentSize(size_t segment) const {
+    return static_cast<size_t>(reinterpret_cast<const SnapshotHeader*>(segments[segment].start)->segmentSize);
+}
+
+// Find a section by type, checking that its records have the expected size
+const void* MappedSnapshot::section(size_t segment, snapshotSectionType type, size_t recordSize, size_t &count) const {
+    const char* start = segments[segment].start;
+    const SnapshotHeader* header = reinterpret_cast<const SnapshotHeader*>(start);
+    const SnapshotSection* table = reinterpret_cast<const SnapshotSection*>(start + sizeof(SnapshotHeader));
+    for (uint32_t i = 0; i < header->sectionCount; ++i) {
+        if (table[i].type == static_cast<uint32_t>(type)) {
+            if (table[i].recordSize != recordSize) {
+                throw runtime_error("Snapshot record size does not match");
+            }
+            count = static_cast<size_t>(table[i].count);
+            return start + table[i].offset;
+        }
+    }
+    count = 0;
+    return nullptr;
+}
+
+// String at an offset into a segment's string heap (the heap always ends with a NUL)
+const char* MappedSnapshot::text(size_t segment, uint32_t offset) const {
+    if (offset >= segments[segment].stringsSize) {
+        throw runtime_error("Snapshot string offset is out of range");
+    }
+    return segments[segment].strings + offset;
+}
+
+void MappedSnapshot::release(void* &address, size_t &size) {
+    address = data;
+    size = length;
+    data = nullptr;
+    length = 0;
+}
+
+// Checks the magic number without mapping the whole file
+bool MappedSnapshot::isSnapshotFile(const string &filename) {
+    ifstream file(filename.c_str(), ios::binary);
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    return file.read(magic, sizeof(magic)) && memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0;
+}
@@ -0,0 +1,126 @@
+/* Program name: TextPool.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the text pool class methods
+*/
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <sys/mman.h>
+
+#include "TextPool.h"
+
+using namespace std;
+
+namespace {
+    const size_t BLOCK_SIZE = 64 * 1024;
+}
+
+// FNV-1a hash of a NUL-terminated string
+size_t TextPool::TextHash::operator()(const char* text) const {
+    size_t hash = 14695981039346656037ULL;
+    for (; *text; ++text) {
+        hash ^= static_cast<unsigned char>(*text);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+TextPool::TextPool() : blockUsed(0), blockSize(0), totalBytes(0), mappedBytes(0) {}
+
+TextPool::~TextPool() {
+    reset();
+}
+
+// Reserve length + 1 bytes, starting a new block when the current one is full
+char* TextPool::allocate(size_t length) {
+    size_t needed = length + 1;
+    if (blocks.empty() || blockUsed + needed > blockSize) {
+        blockSize = needed > BLOCK_SIZE ? needed : BLOCK_SIZE; // Oversized text gets a block of its own
+        blocks.push_back(new char[blockSize]);
+        blockSizes.push_back(blockSize);
+        blockUsed = 0;
+        totalBytes += blockSize;
+    }
+    char* text = blocks.back() + blockUsed;
+    blockUsed += needed;
+    return text;
+}
+
+// Copy text into the arena
+const char* TextPool::store(const string &text) {
+    char* copy = allocate(text.size());
+    memcpy(copy, text.c_str(), text.size() + 1);
+    return copy;
+}
+
+// Return the pooled copy of text, adding it the first time it is seen
+const char* TextPool::intern(const string &text) {
+    unordered_set<const char*, TextHash, TextEqual>::const_iterator it = interned.find(text.c_str());
+    if (it != interned.end()) {
+        return *it;
+    }
+    const char* copy = store(text);
+    interned.insert(copy);
+    return copy;
+}
+
+// Take ownership of a memory map whose strings are used in place
+void TextPool::adoptMapping(void* address, size_t length) {
+    mappings.push_back(make_pair(address, length));
+    mappedBytes += length;
+}
+
+void TextPool::adoptBuffer(char* buffer, size_t size) {
+    blocks.insert(blocks.begin(), buffer); // The last block stays the one being filled
+    blockSizes.insert(blockSizes.begin(), size);
+    totalBytes += size;
+}
+
+// Make text that already lives in adopted memory the interned copy of its value
+const char* TextPool::adopt(const char* text) {
+    return *interned.insert(text).first; // Keeps the existing copy if the value was already interned
+}
+
+// Whether text points into one of the pool's blocks or adopted mappings
+bool TextPool::owns(const char* text) const {
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (text >= blocks[i] && text < blocks[i] + blockSizes[i]) {
+            return true;
+        }
+    }
+    for (size_t i = 0; i < mappings.size(); ++i) {
+        const char* start = static_cast<const char*>(mappings[i].first);
+        if (text >= start && text < start + mappings[i].second) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Free every block and unmap every adopted mapping at once
+void TextPool::reset() {
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        delete[] blocks[i];
+    }
+    for (size_t i = 0; i < mappings.size(); ++i) {
+        munmap(mappings[i].first, mappings[i].second);
+    }
+    blocks.clear();
+    blockSizes.clear();
+    mappings.clear();
+    interned.clear();
+    blockUsed = 0;
+    blockSize = 0;
+    totalBytes = 0;
+    mappedBytes = 0;
+}
+
+size_t TextPool::bytesAllocated() const { return totalBytes; }
+size_t TextPool::bytesMapped() const { return mappedBytes; }
+size_t TextPool::internedCount() const { return interned.size(); }
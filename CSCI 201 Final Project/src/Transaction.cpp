@@ -1,50 +1,61 @@
 /* Program name: Transaction.cpp
 * Author: Joshua Yin
-* Date last updated: 7/24/2024
-* Purpose: Implement the transaction class methods
+* Date last updated: 10/17/2026
+* Purpose: Implement the transaction record functions
 */
 
 #include <ctime>
 #include <iostream>
-#include <stdexcept>
 #include <string>
 
 #include "Transaction.h"
 
 using namespace std;
 
-Transaction::Transaction(const string &ISBN, const int &memberID)
-    : ISBN(ISBN), memberID(memberID) {
-    transactionDate = time(nullptr); // Current time
-}
-
-// Getters
-int Transaction::getMemberID() const { return memberID; }
-time_t Transaction::getTransactionDate() const { return transactionDate; }
-
-// Setters
-void Transaction::setTransactionDate(const string &transactionDateStr) {
-    // Convert the string to a time_t value
-    try {
-        this->transactionDate = static_cast<time_t>(stoll(transactionDateStr));
-    } catch (const invalid_argument &e) {
-        throw invalid_argument("Failed to parse date string.");
+// Due date as YYYY-MM-DD
+string Transaction::getDueDateText() const {
+    if (!isBorrow()) {
+        return string();
     }
+    return formatEpochDay(dueDay);
 }
 
-// Display transaction details (overriden by borrow and return classes)
+// Display transaction details (borrows also show the due date)
 void Transaction::display() const {
     // Convert transactionDate to a string using ctime
     string dateStr = ctime(&transactionDate);
-    
+
     // Remove the newline character from the end of the date string
     if (!dateStr.empty() && dateStr.back() == '\n') {
         dateStr.pop_back();
     }
 
-    cout << "ISBN: " << ISBN
+    cout << (isBorrow() ? "Type: Borrow, " : "Type: Return, ")
+        << "ISBN: " << isbn
         << ", Member ID: " << memberID
         << ", Transaction Date: " << dateStr;
+    if (isBorrow()) {
+        cout << ", Due Date: " << getDueDateText();
+    }
+    cout << endl;
 }
 
-Transaction::~Transaction() {}
+Transaction makeBorrow(const Isbn &isbn, int memberID, time_t transactionDate) {
+    Transaction transaction = Transaction(); // Zero the padding too
+    transaction.transactionDate = transactionDate;
+    transaction.isbn = isbn;
+    transaction.dueDay = localEpochDay(transactionDate) + 14; // 14-day borrowing period
+    transaction.memberID = memberID;
+    transaction.type = BORROW_TRANSACTION;
+    return transaction;
+}
+
+Transaction makeReturn(const Isbn &isbn, int memberID, time_t transactionDate) {
+    Transaction transaction = Transaction();
+    transaction.transactionDate = transactionDate;
+    transaction.isbn = isbn;
+    transaction.dueDay = NO_DUE_DATE;
+    transaction.memberID = memberID;
+    transaction.type = RETURN_TRANSACTION;
+    return transaction;
+}
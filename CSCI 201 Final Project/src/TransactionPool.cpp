@@ -0,0 +1,71 @@
+/* Program name: TransactionPool.cpp
+* Author: Joshua Yin
+* Date last updated: 10/18/2026
+* Purpose: Implement the transaction pool class methods
+*/
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "TransactionPool.h"
+
+using namespace std;
+
+TransactionPool::TransactionPool() : first(0), count(0) {}
+
+TransactionPool::TransactionPool(const TransactionPool &other) : first(0), count(0) {
+    for (const_iterator it = other.begin(); it != other.end(); ++it) {
+        push_back(*it);
+    }
+}
+
+TransactionPool& TransactionPool::operator=(const TransactionPool &other) {
+    if (this != &other) {
+        TransactionPool copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+// Start a new block once the last one is full
+void TransactionPool::push_back(const Transaction &transaction) {
+    if (blocks.empty() || blocks.back().size() == BLOCK_RECORDS) {
+        blocks.push_back(vector<Transaction>());
+        blocks.back().reserve(BLOCK_RECORDS);
+    }
+    blocks.back().push_back(transaction);
+    ++count;
+}
+
+// Whole blocks are freed as soon as every transaction in them is dropped
+void TransactionPool::dropFront(size_t dropped) {
+    if (dropped >= count) {
+        clear();
+        return;
+    }
+    first += dropped;
+    count -= dropped;
+    size_t emptied = first / BLOCK_RECORDS;
+    blocks.erase(blocks.begin(), blocks.begin() + emptied);
+    first -= emptied * BLOCK_RECORDS;
+}
+
+void TransactionPool::clear() {
+    vector<vector<Transaction> >().swap(blocks); // Release the blocks, not just empty them
+    first = 0;
+    count = 0;
+}
+
+void TransactionPool::swap(TransactionPool &other) {
+    blocks.swap(other.blocks);
+    std::swap(first, other.first);
+    std::swap(count, other.count);
+}
+
+size_t TransactionPool::size() const { return count; }
+bool TransactionPool::empty() const { return count == 0; }
+size_t TransactionPool::bytesAllocated() const { return blocks.size() * BLOCK_RECORDS * sizeof(Transaction); }
+
+TransactionPool::const_iterator TransactionPool::begin() const { return const_iterator(this, 0); }
+TransactionPool::const_iterator TransactionPool::end() const { return const_iterator(this, count); }
@@ -0,0 +1,235 @@
+/* Program name: TrigramIndex.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Implement the trigram index class methods
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "TrigramIndex.h"
+
+using namespace std;
+
+/* Helper Functions */
+namespace {
+    // Precomputed pattern for the bit-parallel (Myers/Hyyro) edit distance. Each column of the
+    // dynamic programming table is processed as one 64-bit word instead of one cell at a time.
+    class EditPattern {
+    private:
+        string pattern;
+        uint64_t peq[256]; // Character -> bit mask of its positions in the pattern
+
+    public:
+        explicit EditPattern(const string &p) : pattern(p) {
+            memset(peq, 0, sizeof(peq));
+            for (size_t i = 0; i < p.size() && i < 64; ++i) {
+                peq[static_cast<unsigned char>(p[i])] |= uint64_t(1) << i;
+            }
+        }
+
+        int distance(const string &text, int bound) const {
+            size_t m = pattern.size();
+            if (m == 0 || text.empty()) {
+                int length = static_cast<int>(max(m, text.size()));
+                return length <= bound ? length : bound + 1;
+            }
+            if (m > 64) {
+                return bandedDistance(text, bound);
+            }
+
+            uint64_t highBit = uint64_t(1) << (m - 1);
+            uint64_t pv = ~uint64_t(0);
+            uint64_t mv = 0;
+            int score = static_cast<int>(m);
+            int remaining = static_cast<int>(text.size());
+
+            for (size_t j = 0; j < text.size(); ++j) {
+                uint64_t eq = peq[static_cast<unsigned char>(text[j])];
+                uint64_t xv = eq | mv;
+                uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+                uint64_t ph = mv | ~(xh | pv);
+                uint64_t mh = pv & xh;
+                if (ph & highBit) {
+                    ++score;
+                } else if (mh & highBit) {
+                    --score;
+                }
+                ph = (ph << 1) | 1; // Top row of the table grows by one per text character
+                mh <<= 1;
+                pv = mh | ~(xv | ph);
+                mv = ph & xv;
+
+                // The score drops by at most one per remaining character
+                --remaining;
+                if (score - remaining > bound) {
+                    return bound + 1;
+                }
+            }
+            return score <= bound ? score : bound + 1;
+        }
+
+        // Fallback for patterns longer than one machine word: only cells within bound of the diagonal
+        int bandedDistance(const string &text, int bound) const {
+            int m = static_cast<int>(pattern.size());
+            int n = static_cast<int>(text.size());
+            if (abs(m - n) > bound) {
+                return bound + 1;
+            }
+            const int outside = bound + 1;
+            vector<int> previous(n + 1), current(n + 1);
+            for (int j = 0; j <= n; ++j) {
+                previous[j] = j <= bound ? j : outside;
+            }
+            for (int i = 1; i <= m; ++i) {
+                int from = max(1, i - bound), to = min(n, i + bound);
+                current[0] = i <= bound ? i : outside;
+                if (from > 1) {
+                    current[from - 1] = outside;
+                }
+                int rowBest = current[0];
+                for (int j = from; j <= to; ++j) {
+                    int cost = pattern[i - 1] == text[j - 1] ? 0 : 1;
+                    int best = min(previous[j - 1] + cost, min(previous[j] + 1, current[j - 1] + 1));
+                    current[j] = min(best, outside);
+                    rowBest = min(rowBest, current[j]);
+                }
+                if (to < n) {
+                    current[to + 1] = outside;
+                }
+                if (rowBest > bound) {
+                    return bound + 1;
+                }
+                previous.swap(current);
+            }
+            return previous[n] <= bound ? previous[n] : bound + 1;
+        }
+    };
+
+    bool closerMatch(const pair<string, int> &a, const pair<string, int> &b) {
+        return a.second != b.second ? a.second < b.second : a.first < b.first;
+    }
+}
+
+// Pack the trigrams of a word, padded so the first and last letters get their own trigrams
+vector<uint32_t> TrigramIndex::trigrams(const string &word) {
+    string padded = "\x01\x01" + word + "\x01\x01";
+    vector<uint32_t> grams;
+    for (size_t i = 0; i + 2 < padded.size(); ++i) {
+        grams.push_back((static_cast<uint32_t>(static_cast<unsigned char>(padded[i])) << 16) |
+                        (static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8) |
+                        static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 2])));
+    }
+    sort(grams.begin(), grams.end());
+    grams.erase(unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+// Short words tolerate fewer typos, otherwise everything would match them
+int TrigramIndex::maxTypos(size_t length) {
+    if (length <= 2) {
+        return 0;
+    }
+    return length <= 4 ? 1 : 2;
+}
+
+int TrigramIndex::boundedEditDistance(const string &a, const string &b, int bound) {
+    return EditPattern(a).distance(b, bound);
+}
+
+// Keep the vocabulary in sync
+void TrigramIndex::add(const string &word) {
+    if (wordIds.count(word)) {
+        return;
+    }
+
+    uint32_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+        words[id] = word;
+    } else {
+        id = static_cast<uint32_t>(words.size());
+        words.push_back(word);
+    }
+    wordIds[word] = id;
+
+    vector<uint32_t> grams = trigrams(word);
+    for (size_t i = 0; i < grams.size(); ++i) {
+        postings[grams[i]].push_back(id);
+    }
+}
+
+void TrigramIndex::remove(const string &word) {
+    unordered_map<string, uint32_t>::iterator it = wordIds.find(word);
+    if (it == wordIds.end()) {
+        return;
+    }
+    uint32_t id = it->second;
+
+    vector<uint32_t> grams = trigrams(word);
+    for (size_t i = 0; i < grams.size(); ++i) {
+        vector<uint32_t> &list = postings[grams[i]];
+        vector<uint32_t>::iterator found = find(list.begin(), list.end(), id);
+        if (found != list.end()) {
+            *found = list.back(); // Order within a posting list does not matter
+            list.pop_back();
+        }
+        if (list.empty()) {
+            postings.erase(grams[i]);
+        }
+    }
+
+    words[id].clear();
+    freeIds.push_back(id);
+    wordIds.erase(it);
+}
+
+void TrigramIndex::clear() {
+    words.clear();
+    freeIds.clear();
+    wordIds.clear();
+    postings.clear();
+}
+
+// Find indexed words within maxDistance edits of word. Words that cannot share enough
+// trigrams to be that close are never compared (each edit destroys at most three trigrams).
+vector<pair<string, int> > TrigramIndex::similarWords(const string &word, int maxDistance, size_t limit) const {
+    vector<pair<string, int> > matches;
+    vector<uint32_t> grams = trigrams(word);
+
+    unordered_map<uint32_t, int> shared; // Word ID -> trigrams shared with the query
+    for (size_t i = 0; i < grams.size(); ++i) {
+        unordered_map<uint32_t, vector<uint32_t> >::const_iterator list = postings.find(grams[i]);
+        if (list == postings.end()) {
+            continue;
+        }
+        for (size_t j = 0; j < list->second.size(); ++j) {
+            ++shared[list->second[j]];
+        }
+    }
+
+    int needed = static_cast<int>(word.size()) + 2 - 3 * maxDistance;
+    EditPattern pattern(word);
+    for (unordered_map<uint32_t, int>::const_iterator it = shared.begin(); it != shared.end(); ++it) {
+        const string &candidate = words[it->first];
+        if (it->second < needed || abs(static_cast<int>(candidate.size()) - static_cast<int>(word.size())) > maxDistance) {
+            continue;
+        }
+        int distance = pattern.distance(candidate, maxDistance);
+        if (distance <= maxDistance) {
+            matches.push_back(make_pair(candidate, distance));
+        }
+    }
+
+    size_t count = min(limit, matches.size());
+    partial_sort(matches.begin(), matches.begin() + count, matches.end(), closerMatch);
+    matches.resize(count);
+    return matches;
+}
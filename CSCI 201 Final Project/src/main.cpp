@@ -1,11 +1,13 @@
 /* Program name: main.cpp
 * Author: Joshua Yin
-* Date last updated: 7/24/2024
+* Date last updated: 10/17/2026
 * Purpose: See project proposal. Allow the user to navigate menus and
 * select options and manipulate the components of the library.
 */
 
 #include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <ctime>
 #include <fstream>
 #include <iostream>
@@ -16,12 +18,12 @@
 #include <string>
 #include <vector>
 
+#include "CatalogView.h"
 #include "Library.h"
 #include "Member.h"
 #include "Book.h"
+#include "Isbn.h"
 #include "Transaction.h"
-#include "Borrow.h"
-#include "Return.h"
 
 using namespace std;
 
@@ -42,6 +44,8 @@ void displayMainMenu() {
     cout << "5. Search Book\n";
     cout << "6. Manage Reservations\n";
     cout << "7. Manage Transactions\n";
+    cout << "8. Display Memory Report\n";
+    cout << "9. Save Now (in the Background)\n";
     cout << "0. Exit Library\n";
     cout << "-------------------------" << endl;
     cout << "Choose an option: ";
@@ -57,6 +61,9 @@ void displayBookMenu() {
     cout << "2. Edit Book\n";
     cout << "3. Delete Book\n";
     cout << "4. Display Books\n";
+    cout << "5. Display Inventory Summary\n";
+    cout << "6. Display Available Books by Genre\n";
+    cout << "7. Import Books from File\n";
     cout << "0. Back to Main Menu\n";
     cout << "--------------------" << endl;
     cout << "Choose an option: ";
@@ -99,6 +106,9 @@ void displayTransactionMenu() {
     cout << "-------------------\n";
     cout << "1. Display Transactions\n";
     cout << "2. Delete Transaction History\n";
+    cout << "3. Display Transactions by Date Range\n";
+    cout << "4. Display Overdue Books\n";
+    cout << "5. Display Books Due Soon\n";
     cout << "0. Back to Main Menu\n";
     cout << "-------------------" << endl;
     cout << "Choose an option: ";
@@ -115,8 +125,10 @@ void displaySearchMenu() {
     cout << "3. Search by ISBN\n";
     cout << "4. Search by Call Number\n";
     cout << "5. Search by Genre\n";
-    cout << "6. Search by Publication Date\n";
+    cout << "6. Search by Publication Date (Year or Range, e.g. 1960-1980)\n";
     cout << "7. Search by Any (Title, Author, ISBN)\n";
+    cout << "8. Search by Genre and Publication Date Range\n";
+    cout << "9. Fuzzy Search (Title, Author; tolerates typos)\n";
     cout << "------------" << endl;
     cout << "Enter your choice: ";
 }
@@ -139,30 +151,25 @@ void displayGenreMenu() {
     cout << "-----------" << endl;
 }
 
+// Function to display the read-only catalog menu (kiosk mode)
+void displayKioskMenu() {
+    cout << endl; // Add line break for clarity
+    cout << "-------------------------\n";
+    cout << "Library Catalog\n";
+    cout << "-------------------------\n";
+    cout << "1. Search Book\n";
+    cout << "2. Display Books\n";
+    cout << "3. Display Inventory Summary\n";
+    cout << "4. Display Available Books by Genre\n";
+    cout << "0. Exit Catalog\n";
+    cout << "-------------------------" << endl;
+    cout << "Choose an option: ";
+}
+
 /*==================*/
 /* Helper Functions */
 /*==================*/
 
-// Function to check if an ISBN exists in the library
-bool isbnExists(const vector<Book> &books, const string &isbn) {
-    for (vector<Book>::const_iterator it = books.begin(); it != books.end(); ++it) {
-        if (it->getISBN() == isbn) {
-            return true;
-        }
-    }
-    return false;
-}
-
-// Function to check if a member ID exists in the library
-bool memberIdExists(const vector<Member> &members, int id) {
-    for (vector<Member>::const_iterator it = members.begin(); it != members.end(); ++it) {
-        if (it->getMemberID() == id) {
-            return true;
-        }
-    }
-    return false;
-}
-
 // Function to get string inputs
 string getStrInput(const string& prompt) {
     string input;
@@ -204,6 +211,72 @@ int getIdInput(const string& prompt) {
     }
 }
 
+// Function to get ISBN inputs (ISBN-10 or ISBN-13; hyphens and spaces are ignored). A new ISBN
+// must have a valid check digit, but one that is only looked up just needs its digits, so books
+// saved before ISBNs were checked can still be found.
+Isbn getIsbnInput(const string& prompt, bool isNew) {
+    string line;
+    while (true) {
+        cout << prompt;
+        getline(cin, line);
+
+        Isbn isbn;
+        if (isNew ? Isbn::parse(line, isbn) : Isbn::parseSaved(line.c_str(), isbn)) {
+            return isbn;
+        }
+        cout << "Invalid ISBN. Please check the digits and try again." << endl;
+    }
+}
+
+// Function to get genre inputs (shows the genre menu first)
+genreType getGenreInput() {
+    int genre;
+    displayGenreMenu();
+    while (true) {
+        cout << "Enter genre choice: ";
+        if (cin >> genre && genre >= 1 && genre <= static_cast<int>(genreType::SCIENCE_FICTION) + 1) {
+            cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Ignore rest of input (newline character)
+            return static_cast<genreType>(genre - 1);
+        }
+        cout << "Invalid genre. Please enter a number between 1 and 9." << endl;
+        cin.clear(); // Clear error state
+        cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Ignore rest of input
+    }
+}
+
+// Function to read a date as YYYY-MM-DD (midnight, local time); false if it is not a real date
+bool parseDate(const string& text, time_t& time) {
+    int year, month, day;
+    char firstDash, secondDash;
+    stringstream ss(text);
+    if (ss >> year >> firstDash >> month >> secondDash >> day && firstDash == '-' && secondDash == '-'
+        && (ss >> ws).eof() && month >= 1 && month <= 12 && day >= 1 && day <= 31) {
+        tm date = tm();
+        date.tm_year = year - 1900;
+        date.tm_mon = month - 1;
+        date.tm_mday = day;
+        date.tm_isdst = -1; // Let mktime work out daylight saving time
+        time = mktime(&date);
+        return time != -1 && date.tm_mday == day; // mktime moves days past the end of the month into the next one
+    }
+    return false;
+}
+
+// Function to get date inputs (YYYY-MM-DD, returned as the start of that day in local time)
+time_t getDateInput(const string& prompt) {
+    string line;
+    while (true) {
+        cout << prompt;
+        getline(cin, line);
+
+        time_t time;
+        if (parseDate(line, time)) {
+            return time;
+        }
+        cout << "Invalid date. Please enter a date as YYYY-MM-DD." << endl;
+    }
+}
+
 // Function to get menu choices
 int getMenuChoice(void (*menuFunction)()) {
     string input;
@@ -222,6 +295,350 @@ int getMenuChoice(void (*menuFunction)()) {
     } while (true);
 }
 
+/*========================*/
+/* Command Line Functions */
+/*========================*/
+
+// Function to display command line usage
+void displayUsage(const char* program) {
+    cout << "Usage: " << program << " [--data FILE]\n"
+        << "       " << program << " --convert INPUT OUTPUT\n"
+        << "       " << program << " [--data FILE] --kiosk\n"
+        << "       " << program << " --time-load FILE...\n"
+        << "       " << program << " --time-history FILE...\n"
+        << "       " << program << " --time-lookup FILE...\n"
+        << "       " << program << " --time-access FILE...\n"
+        << "       " << program << " --import INPUT FILE\n"
+        << "       " << program << " [--data FILE] --export books|members|loans|history OUTPUT\n"
+        << "                 [--genre GENRE] [--from YYYY-MM-DD] [--to YYYY-MM-DD]\n"
+        << "Files ending in .snap are saved as binary snapshots; anything else uses the text format.\n"
+        << "Changes are journaled to FILE.journal until the next save and replayed after a crash.\n"
+        << "Saves write a temporary file and rename it over FILE; option 9 saves in the background.\n"
+        << "Members and the transaction history are only built from FILE when first needed.\n"
+        << "--import adds the books in a CSV (or .tsv) file of title, author, ISBN, publication date,\n"
+        << "call number and genre to FILE (created if missing), skipping ISBNs FILE already has.\n"
+        << "--export writes OUTPUT as JSON Lines if it ends in .jsonl or .json, otherwise as CSV\n"
+        << "(\"-\" writes to standard output). --genre filters books; --from and --to filter loans by\n"
+        << "due date and history by transaction date.\n"
+        << "--kiosk only searches and displays books, read in place from a .snap FILE (shared by every\n"
+        << "kiosk on the machine); saves made elsewhere are picked up at the next menu choice." << endl;
+}
+
+// Function to convert a data file between the text and snapshot formats
+int convertDataFile(const string& input, const string& output) {
+    Library library;
+    if (!library.loadFromFile(input)) {
+        cerr << "Nothing was converted, so " << output << " was not written." << endl;
+        return 1;
+    }
+    return library.saveToFile(output) ? 0 : 1;
+}
+
+// Function to import a catalog file into a data file without going through the menus
+int importCatalog(const string& input, const string& filename) {
+    Library library;
+    if (ifstream(filename).good() && !library.loadFromFile(filename)) {
+        return 1; // Saving now would replace the data file with just the imported books
+    }
+    if (!library.importBooks(input)) {
+        return 1;
+    }
+    return library.saveToFile(filename) ? 0 : 1;
+}
+
+// Command line export options (dates are midnight at the start of the day given)
+struct ExportOptions {
+    string kind;
+    string output;
+    string genre;
+    bool hasFrom;
+    bool hasTo;
+    time_t from;
+    time_t to;
+
+    ExportOptions() : hasFrom(false), hasTo(false), from(0), to(0) {}
+};
+
+// Function to export part of a data file without going through the menus
+int exportData(const string& filename, const ExportOptions& options) {
+    if ((!options.genre.empty() && options.kind != "books")
+        || ((options.hasFrom || options.hasTo) && options.kind != "loans" && options.kind != "history")) {
+        cerr << "--genre only filters books, and --from and --to only filter loans and history." << endl;
+        return 1;
+    }
+    genreType genre = FANTASY;
+    if (!options.genre.empty()) {
+        bool found = false;
+        for (map<genreType, string>::const_iterator it = genreNames.begin(); it != genreNames.end(); ++it) {
+            string name = it->second;
+            if (name.size() == options.genre.size()
+                && equal(name.begin(), name.end(), options.genre.begin(), [](char a, char b) { return tolower(static_cast<unsigned char>(a)) == tolower(static_cast<unsigned char>(b)); })) {
+                genre = it->first;
+                found = true;
+            }
+        }
+        if (!found) {
+            cerr << "Unknown genre: " << options.genre << endl;
+            return 1;
+        }
+    }
+
+    Library library;
+    library.setLazyLoading(true); // Only what is exported gets built
+    streambuf* original = cout.rdbuf(nullptr); // Keep the load message out of an export to standard output
+    bool loaded = library.loadFromFile(filename);
+    cout.rdbuf(original);
+    cout.clear();
+    if (!loaded) {
+        return 1;
+    }
+
+    time_t from = options.hasFrom ? options.from : numeric_limits<time_t>::min();
+    time_t to = options.hasTo ? options.to + 24 * 60 * 60 - 1 : numeric_limits<time_t>::max(); // Through the end of the last day
+    size_t count = 0;
+    try {
+        ExportWriter out(options.output, ExportWriter::formatFor(options.output));
+        if (options.kind == "books") {
+            bool byGenre = !options.genre.empty();
+            count = library.exportBooks(out, [byGenre, genre](const Book& book) { return !byGenre || book.getGenre() == genre; });
+        } else if (options.kind == "members") {
+            count = library.exportMembers(out, ExportAll());
+        } else if (options.kind == "loans") {
+            int32_t firstDue = options.hasFrom ? localEpochDay(options.from) : NO_DUE_DATE;
+            int32_t lastDue = options.hasTo ? localEpochDay(options.to) : numeric_limits<int32_t>::max();
+            count = library.exportLoans(out, [firstDue, lastDue](const LoanRecord& loan) {
+                int32_t due = loan.book->getDueDay(); // Epoch days, so dates compare as numbers
+                return due >= firstDue && due <= lastDue;
+            });
+        } else {
+            count = library.exportHistory(out, from, to, ExportAll());
+        }
+        out.finish();
+    }
+    catch (const exception &e) {
+        cerr << "An error occurred while exporting: " << e.what() << endl;
+        return 1;
+    }
+
+    if (options.output != "-") {
+        cout << "Exported " << count << " records to " << options.output << "." << endl;
+    }
+    return 0;
+}
+
+// Function to time loading data files (compares the text and snapshot formats, and a full load
+// with the lazy load used at startup)
+int timeLoad(const vector<string>& filenames) {
+    const int runs = 5;
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        for (int mode = 0; mode < 2; ++mode) {
+            bool lazy = mode == 1;
+            double total = 0, best = 0;
+            for (int run = 0; run < runs; ++run) {
+                Library library;
+                library.setLazyLoading(lazy);
+                streambuf* original = cout.rdbuf(nullptr); // Silence the load messages while timing
+                chrono::steady_clock::time_point start = chrono::steady_clock::now();
+                library.loadFromFile(filenames[i]);
+                chrono::steady_clock::time_point end = chrono::steady_clock::now();
+                cout.rdbuf(original);
+                cout.clear();
+
+                double ms = chrono::duration<double, milli>(end - start).count();
+                total += ms;
+                if (run == 0 || ms < best) {
+                    best = ms;
+                }
+                if (run == runs - 1) {
+                    cout << filenames[i] << (lazy ? " (lazy)" : "") << ": " << library.getBooks().size() << " books, "
+                        << library.getMembers().size() << " members, " << library.getTransactionCount()
+                        << " transactions; best " << best << " ms, average " << total / runs << " ms" << endl;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// Function to time finding books by ISBN through the index, against the scan of every book it
+// replaced (run on catalogs of different sizes: the index stays flat while the scan grows)
+int timeLookup(const vector<string>& filenames) {
+    const size_t lookups = 1000000;
+    const size_t scans = 200;
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        Library library;
+        library.setLazyLoading(true); // Only the books are needed
+        streambuf* original = cout.rdbuf(nullptr); // Silence the load message while timing
+        bool loaded = library.loadFromFile(filenames[i]);
+        cout.rdbuf(original);
+        cout.clear();
+        const BookStore& books = library.getBooks();
+        if (!loaded || books.size() == 0) {
+            cerr << filenames[i] << ": needs a library with books" << endl;
+            continue;
+        }
+
+        // Look up ISBNs spread across the whole catalog, plus one that is not in it
+        vector<Isbn> isbns;
+        size_t step = books.size() / 1000 + 1, n = 0;
+        for (BookStore::const_iterator it = books.begin(); it != books.end(); ++it, ++n) {
+            if (n % step == 0) {
+                isbns.push_back(it->getISBN());
+            }
+        }
+        Isbn missing;
+        Isbn::parse("9790000000001", missing);
+        isbns.push_back(missing);
+
+        size_t found = 0;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (size_t lookup = 0; lookup < lookups; ++lookup) {
+            if (library.findBook(isbns[lookup % isbns.size()])) {
+                ++found;
+            }
+        }
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+        double indexed = chrono::duration<double, nano>(end - start).count() / lookups;
+
+        size_t scanned = 0;
+        start = chrono::steady_clock::now();
+        for (size_t scan = 0; scan < scans; ++scan) {
+            const Isbn& isbn = isbns[scan * isbns.size() / scans]; // The same spread as the index lookups
+            for (BookStore::const_iterator it = books.begin(); it != books.end(); ++it) {
+                if (it->getISBN() == isbn) {
+                    ++scanned;
+                    break;
+                }
+            }
+        }
+        end = chrono::steady_clock::now();
+        double linear = chrono::duration<double, nano>(end - start).count() / scans;
+
+        cout << filenames[i] << ": " << books.size() << " books; index " << indexed << " ns per lookup ("
+            << found << " of " << lookups << " found), scan " << linear / 1000 << " us per lookup ("
+            << scanned << " of " << scans << " found)" << endl;
+    }
+    return 0;
+}
+
+// Function to time the checks a menu prompt makes (does the book and the member exist) through the
+// const-reference accessors, against copying the catalog and members as the by-value getters did
+int timeAccess(const vector<string>& filenames) {
+    const size_t prompts = 1000000;
+    const size_t copies = 20;
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        Library library;
+        streambuf* original = cout.rdbuf(nullptr); // Silence the load message while timing
+        bool loaded = library.loadFromFile(filenames[i]);
+        cout.rdbuf(original);
+        cout.clear();
+        const BookStore& books = library.getBooks();
+        const vector<Member>& members = library.getMembers();
+        if (!loaded || books.empty() || members.empty()) {
+            cerr << filenames[i] << ": needs a library with books and members" << endl;
+            continue;
+        }
+        Isbn isbn = books.begin()->getISBN();
+        int memberID = members.back().getMemberID();
+
+        size_t found = 0;
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (size_t prompt = 0; prompt < prompts; ++prompt) {
+            if (library.hasBook(isbn) && library.hasMember(memberID)) {
+                ++found;
+            }
+        }
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+        double byReference = chrono::duration<double, nano>(end - start).count() / prompts;
+
+        size_t copied = 0;
+        start = chrono::steady_clock::now();
+        for (size_t copy = 0; copy < copies; ++copy) {
+            BookStore bookCopy(books);
+            vector<Member> memberCopy(members);
+            copied += bookCopy.size() + memberCopy.size();
+        }
+        end = chrono::steady_clock::now();
+        double byValue = chrono::duration<double, milli>(end - start).count() / copies;
+
+        cout << filenames[i] << ": " << books.size() << " books, " << members.size() << " members; by reference "
+            << byReference << " ns per prompt (" << found << " of " << prompts << " found), by value "
+            << byValue << " ms per prompt (" << copied / copies << " records copied)" << endl;
+    }
+    return 0;
+}
+
+// Function to time borrowing and returning books and scanning the recent history (nothing is saved)
+int timeHistory(const vector<string>& filenames) {
+    const size_t cycles = 100000; // Each is a borrow and a return
+    const int scans = 20;
+    for (size_t i = 0; i < filenames.size(); ++i) {
+        Library library;
+        streambuf* original = cout.rdbuf(nullptr); // Silence the load and borrow messages while timing
+        bool loaded = library.loadFromFile(filenames[i]);
+        cout.rdbuf(original);
+        cout.clear();
+        if (!loaded || library.getMembers().empty()) {
+            cerr << filenames[i] << ": needs a library with books and members" << endl;
+            continue;
+        }
+
+        // Borrow books nobody has out or reserved, so every borrow and return goes through
+        vector<Isbn> isbns;
+        const HoldTable& holds = library.getHolds();
+        for (BookStore::const_iterator it = library.getBooks().begin(); it != library.getBooks().end() && isbns.size() < 1000; ++it) {
+            if (!it->getIsBorrowed() && !holds.isHeld(it->getISBN())) {
+                isbns.push_back(it->getISBN());
+            }
+        }
+        if (isbns.empty()) {
+            cerr << filenames[i] << ": every book is borrowed or reserved" << endl;
+            continue;
+        }
+        int memberID = library.getMembers().front().getMemberID();
+
+        original = cout.rdbuf(nullptr);
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (size_t cycle = 0; cycle < cycles; ++cycle) {
+            const Isbn& isbn = isbns[cycle % isbns.size()];
+            library.borrowBook(isbn, memberID);
+            library.returnBook(isbn, memberID);
+        }
+        chrono::steady_clock::time_point end = chrono::steady_clock::now();
+        cout.rdbuf(original);
+        cout.clear();
+        cout << filenames[i] << ": " << 2 * cycles << " transactions in "
+            << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+
+        // Scan the recent history the way the date range display does, and count the borrows
+        const TransactionPool& history = library.getTransactions();
+        time_t from = time(nullptr) - 60 * 60;
+        double total = 0, best = 0;
+        size_t matched = 0, borrows = 0;
+        for (int scan = 0; scan < scans; ++scan) {
+            matched = borrows = 0;
+            start = chrono::steady_clock::now();
+            for (size_t j = 0; j < history.size(); ++j) {
+                if (history[j].transactionDate >= from) {
+                    ++matched;
+                }
+                if (history[j].isBorrow()) {
+                    ++borrows;
+                }
+            }
+            end = chrono::steady_clock::now();
+            double us = chrono::duration<double, micro>(end - start).count();
+            total += us;
+            if (scan == 0 || us < best) {
+                best = us;
+            }
+        }
+        cout << filenames[i] << ": scanned " << history.size() << " recent transactions (" << matched << " in the last hour, "
+            << borrows << " borrows); best " << best << " us, average " << total / scans << " us" << endl;
+    }
+    return 0;
+}
+
 
 /*=================================*/
 /* Library Functionality Functions */
@@ -238,7 +655,8 @@ void manageBooks(Library& library) {
                 return;
             }
             case 1: { // Add book
-                string title, author, isbn, callNum;
+                string title, author, callNum;
+                Isbn isbn;
                 int pubDate, genre;
 
                 // Get title
@@ -248,10 +666,10 @@ void manageBooks(Library& library) {
                 author = getStrInput("Enter author: ");
 
                 // Get ISBN
-                isbn = getStrInput("Enter ISBN: ");
+                isbn = getIsbnInput("Enter ISBN: ", true);
 
                 // Check if the ISBN already exists before continuing
-                if (isbnExists(library.getBooks(), isbn)) {
+                if (library.hasBook(isbn)) {
                     cout << "Error: A book with this ISBN already exists.\n";
                     cout << "Returning to book menu." << endl;
                     continue; // Return to book menu since title and author may need to be reentered
@@ -287,19 +705,20 @@ void manageBooks(Library& library) {
                     }
                 }
 
-                // Create a new book object and add it to the library
-                library.addBook(Book(title, author, isbn, pubDate, callNum, static_cast<genreType>(genre - 1)));
+                // Create a new book object and add it to the library (which copies the text into its own pool)
+                library.addBook(library.makeBook(title, author, isbn, pubDate, callNum, static_cast<genreType>(genre - 1)));
                 break;
             }
             case 2: { // Edit book
-                string title, author, isbn, callNum;
+                string title, author, callNum;
+                Isbn isbn;
                 int genre, pubDate;
 
                 // Get ISBN of book to edit
-                isbn = getStrInput("Enter ISBN of the book to edit: ");
+                isbn = getIsbnInput("Enter ISBN of the book to edit: ", false);
 
                 // Check if the ISBN exists before proceeding
-                if (!isbnExists(library.getBooks(), isbn)) {
+                if (!library.hasBook(isbn)) {
                     cout << "ISBN not found. Please try again.\n";
                     continue; // Return to book menu since there might be no books in the library
                 }
@@ -340,18 +759,18 @@ void manageBooks(Library& library) {
                     }
                 }
 
-                // Create a new book object and add it to the library
-                library.editBook(isbn, Book(title, author, isbn, pubDate, callNum, static_cast<genreType>(genre - 1)));
+                // Create the edited book object and replace the old one with it (the library copies the text)
+                library.editBook(isbn, library.makeBook(title, author, isbn, pubDate, callNum, static_cast<genreType>(genre - 1)));
                 break;
             }
             case 3: { // Delete book
-                string isbn;
+                Isbn isbn;
 
                 // Get ISBN of book to delete
-                isbn = getStrInput("Enter ISBN of the book to delete: ");
+                isbn = getIsbnInput("Enter ISBN of the book to delete: ", false);
 
                 // Check if the ISBN exists before proceeding
-                if (!isbnExists(library.getBooks(), isbn)) {
+                if (!library.hasBook(isbn)) {
                     cout << "ISBN not found. Please try again." << endl;
                     continue; // Return to book menu since there might be no books in the library to delete
                 }
@@ -363,6 +782,19 @@ void manageBooks(Library& library) {
                 library.displayBooks();
                 break;
             }
+            case 5: { // Display inventory summary
+                library.displayInventory();
+                break;
+            }
+            case 6: { // Display available books by genre
+                library.displayAvailableBooks(getGenreInput());
+                break;
+            }
+            case 7: { // Import books from a file
+                string importFile = getStrInput("Enter the file to import: ");
+                library.importBooks(importFile);
+                break;
+            }
             default: cout << "Invalid option. Please try again." << endl;
         }
     }
@@ -389,7 +821,7 @@ void manageMembers(Library& library) {
                 id = getIdInput("Enter member ID: ");
 
                 // Check if the member ID exists before proceeding
-                if (memberIdExists(library.getMembers(), id)) {
+                if (library.hasMember(id)) {
                     cout << "Member ID already exists. Please try again." << endl;
                     continue; // Return to member menu since name may need to be reentered
                 }
@@ -403,7 +835,8 @@ void manageMembers(Library& library) {
                 // Get home address
                 address = getStrInput("Enter address: ");
 
-                library.registerMember(Member(name, id, phone, email, address));
+                // Register the member (the library copies the text into its own pool)
+                library.registerMember(library.makeMember(name, id, phone, email, address));
                 break;
             }
             case 2: { // Edit member
@@ -414,7 +847,7 @@ void manageMembers(Library& library) {
                 id = getIdInput("Enter ID of member to edit: ");
 
                 // Check if the member ID exists before proceeding
-                if (!memberIdExists(library.getMembers(), id)) {
+                if (!library.hasMember(id)) {
                     cout << "Member ID not found. Please try again." << endl;
                     continue; // Return to member menu since there may not be any members in the library
                 }
@@ -431,7 +864,8 @@ void manageMembers(Library& library) {
                 // Get new home address
                 address = getStrInput("Enter new address: ");
 
-                library.editMember(id, Member(name, id, phone, email, address));
+                // Replace the member's details (the library copies the text into its own pool)
+                library.editMember(id, library.makeMember(name, id, phone, email, address));
                 break;
             }
             case 3: { // Delete member
@@ -441,7 +875,7 @@ void manageMembers(Library& library) {
                 id = getIdInput("Enter ID of member to delete: ");
 
                 // Check if the member ID exists before proceeding
-                if (!memberIdExists(library.getMembers(), id)) {
+                if (!library.hasMember(id)) {
                     cout << "Member ID not found. Please try again." << endl;
                     continue;
                 }
@@ -459,14 +893,14 @@ void manageMembers(Library& library) {
 }
 
 void doBorrow(Library& library) {
-    string isbn;
+    Isbn isbn;
     int memberID;
 
     // Get ISBN of book to borrow
-    isbn = getStrInput("Enter ISBN of the book to borrow: ");
+    isbn = getIsbnInput("Enter ISBN of the book to borrow: ", false);
 
     // Check if the ISBN exists before proceeding
-    if (!isbnExists(library.getBooks(), isbn)) {
+    if (!library.hasBook(isbn)) {
         cout << "ISBN not found. Please try again." << endl;
         return;
     }
@@ -475,7 +909,7 @@ void doBorrow(Library& library) {
     memberID = getIdInput("Enter member ID: ");
 
     // Check if member exists before proceeding
-    if (!memberIdExists(library.getMembers(), memberID)) {
+    if (!library.hasMember(memberID)) {
         cout << "Member not found. Please try again." << endl;
         return;
     }
@@ -484,14 +918,14 @@ void doBorrow(Library& library) {
 }
 
 void doReturn(Library& library) {
-    string isbn;
+    Isbn isbn;
     int memberID;
 
     // Get ISBN of book to return
-    isbn = getStrInput("Enter ISBN of the book to return: ");
+    isbn = getIsbnInput("Enter ISBN of the book to return: ", false);
 
     // Check if the ISBN exists before proceeding
-    if (!isbnExists(library.getBooks(), isbn)) {
+    if (!library.hasBook(isbn)) {
         cout << "ISBN not found. Please try again." << endl;
         return;
     }
@@ -500,7 +934,7 @@ void doReturn(Library& library) {
     memberID = getIdInput("Enter member ID: ");
 
     // Check if member exists before proceeding
-    if (!memberIdExists(library.getMembers(), memberID)) {
+    if (!library.hasMember(memberID)) {
         cout << "Member not found. Please try again." << endl;
         return;
     }
@@ -509,10 +943,22 @@ void doReturn(Library& library) {
 }
 
 // Function to allow user to search library for books
-void doSearch(Library& library) {
+template <typename Catalog> void doSearch(const Catalog& library) { // A Library or a read-only CatalogView
     // Get search menu choice (with input validation)
     int searchChoice = getMenuChoice(displaySearchMenu);
 
+    // Genre and date range search takes structured input instead of a query string
+    if (searchChoice == 8) {
+        genreType genre = getGenreInput();
+
+        // Get publication year range
+        int fromYear = getIdInput("Enter earliest publication year: ");
+        int toYear = getIdInput("Enter latest publication year: ");
+
+        library.searchBookByGenreAndDate(genre, fromYear, toYear);
+        return;
+    }
+
     // Get search query
     string query = getStrInput("Enter your search query: ");
 
@@ -539,8 +985,11 @@ void doSearch(Library& library) {
         case 7:
             library.searchBook(query, "any");
             break;
+        case 9:
+            library.searchBook(query, "fuzzy");
+            break;
         default:
-            cout << "Invalid option. Please select a number between 1 and 7." << endl;
+            cout << "Invalid option. Please select a number between 1 and 9." << endl;
             break;
     }
 }
@@ -556,14 +1005,14 @@ void manageReservations(Library& library) {
                 return;
             }
             case 1: { // Make reservation
-                string isbn;
+                Isbn isbn;
                 int memberID;
 
                 // Get ISBN of book to reserve
-                isbn = getStrInput("Enter ISBN of the book to reserve: ");
+                isbn = getIsbnInput("Enter ISBN of the book to reserve: ", false);
 
                 // Check if the ISBN exists before proceeding
-                if (!isbnExists(library.getBooks(), isbn)) {
+                if (!library.hasBook(isbn)) {
                     cout << "ISBN not found. Please try again." << endl;
                     continue;
                 }
@@ -572,7 +1021,7 @@ void manageReservations(Library& library) {
                 memberID = getIdInput("Enter member ID: ");
 
                 // Check if member exists before proceeding
-                if (!memberIdExists(library.getMembers(), memberID)) {
+                if (!library.hasMember(memberID)) {
                     cout << "Member not found. Please try again." << endl;
                     continue;
                 }
@@ -581,14 +1030,14 @@ void manageReservations(Library& library) {
                 break;
             }
             case 2: { // Cancel reservation
-                string isbn;
+                Isbn isbn;
                 int memberID;
 
                 // Get ISBN of book to cancel reservation for
-                isbn = getStrInput("Enter ISBN of the book to cancel reservation for: ");
+                isbn = getIsbnInput("Enter ISBN of the book to cancel reservation for: ", false);
 
                 // Check if the ISBN exists before proceeding
-                if (!isbnExists(library.getBooks(), isbn)) {
+                if (!library.hasBook(isbn)) {
                     cout << "ISBN not found. Please try again." << endl;
                     continue;
                 }
@@ -597,7 +1046,7 @@ void manageReservations(Library& library) {
                 memberID = getIdInput("Enter member ID to cancel reservation for: ");
 
                 // Check if member exists before proceeding
-                if (!memberIdExists(library.getMembers(), memberID)) {
+                if (!library.hasMember(memberID)) {
                     cout << "Member not found. Please try again." << endl;
                     continue;
                 }
@@ -633,31 +1082,159 @@ void manageTransactions(Library& library) {
             case 2: // Delete transaction history
                 library.deleteTransactionHistory();
                 break;
+            case 3: { // Display transactions in a date range
+                time_t from = getDateInput("Enter start date (YYYY-MM-DD): ");
+                time_t to = getDateInput("Enter end date (YYYY-MM-DD): ");
+                library.displayTransactionsBetween(from, to + 24 * 60 * 60 - 1); // Through the end of the last day
+                break;
+            }
+            case 4: // Display overdue books and their fines
+                library.displayOverdueLoans();
+                break;
+            case 5: { // Display books due in the next few days
+                int days = getIdInput("Enter number of days: ");
+                while (days < 0) {
+                    cout << "Number of days cannot be negative. Please try again." << endl;
+                    days = getIdInput("Enter number of days: ");
+                }
+                library.displayLoansDueWithin(days);
+                break;
+            }
             default: cout << "Invalid option. Please try again." << endl;
         }
     }
 }
 
-int main() {
+// Function to run a read-only catalog terminal over a snapshot
+int runKiosk(const string& filename) {
+    CatalogView* catalog = nullptr;
+    try {
+        catalog = new CatalogView(filename);
+    }
+    catch (const exception &e) {
+        cerr << "An error occurred while opening the catalog: " << e.what() << endl;
+        return 1;
+    }
+
+    while (true) {
+        int choice = getMenuChoice(displayKioskMenu);
+        if (choice == 0) {
+            break;
+        }
+
+        // Open the file again if it was saved since (opening only maps it, so this is cheap)
+        if (catalog->isStale()) {
+            try {
+                CatalogView* current = new CatalogView(filename);
+                delete catalog;
+                catalog = current;
+            }
+            catch (const exception &e) {
+                cerr << "An error occurred while reopening the catalog (showing the old one): " << e.what() << endl;
+            }
+        }
+
+        try {
+            switch (choice) {
+                case 1:
+                    doSearch(*catalog);
+                    break;
+                case 2:
+                    catalog->displayBooks();
+                    break;
+                case 3:
+                    catalog->displayInventory();
+                    break;
+                case 4:
+                    catalog->displayAvailableBooks(getGenreInput());
+                    break;
+                default: cout << "Invalid option. Please try again." << endl;
+            }
+        }
+        catch (const exception &e) {
+            cerr << "An error occurred while reading the catalog: " << e.what() << endl;
+        }
+    }
+    delete catalog;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
     Library library;
     bool running = true;
-    const string filename = "library_data.txt";
+    string filename = "library_data.txt";
+    ExportOptions exportOptions;
+    bool kiosk = false;
+
+    // Handle command line options
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "--data" && i + 1 < argc) {
+            filename = argv[++i];
+        } else if (option == "--convert" && i + 2 < argc) {
+            return convertDataFile(argv[i + 1], argv[i + 2]);
+        } else if (option == "--kiosk") {
+            kiosk = true;
+        } else if (option == "--export" && i + 2 < argc) {
+            exportOptions.kind = argv[++i];
+            exportOptions.output = argv[++i];
+        } else if (option == "--genre" && i + 1 < argc) {
+            exportOptions.genre = argv[++i];
+        } else if (option == "--from" && i + 1 < argc && parseDate(argv[i + 1], exportOptions.from)) {
+            exportOptions.hasFrom = true;
+            ++i;
+        } else if (option == "--to" && i + 1 < argc && parseDate(argv[i + 1], exportOptions.to)) {
+            exportOptions.hasTo = true;
+            ++i;
+        } else if (option == "--import" && i + 2 < argc) {
+            return importCatalog(argv[i + 1], argv[i + 2]);
+        } else if (option == "--time-load" && i + 1 < argc) {
+            return timeLoad(vector<string>(argv + i + 1, argv + argc));
+        } else if (option == "--time-history" && i + 1 < argc) {
+            return timeHistory(vector<string>(argv + i + 1, argv + argc));
+        } else if (option == "--time-lookup" && i + 1 < argc) {
+            return timeLookup(vector<string>(argv + i + 1, argv + argc));
+        } else if (option == "--time-access" && i + 1 < argc) {
+            return timeAccess(vector<string>(argv + i + 1, argv + argc));
+        } else {
+            displayUsage(argv[0]);
+            return 1;
+        }
+    }
 
-    // Check if the file exists
+    if (kiosk) {
+        return runKiosk(filename);
+    }
+
+    // Exports run against the saved file and exit (filters only make sense with one)
+    const string kinds[] = { "books", "members", "loans", "history" };
+    if (!exportOptions.kind.empty() && find(kinds, kinds + 4, exportOptions.kind) != kinds + 4) {
+        return exportData(filename, exportOptions);
+    } else if (!exportOptions.kind.empty() || !exportOptions.genre.empty() || exportOptions.hasFrom || exportOptions.hasTo) {
+        displayUsage(argv[0]);
+        return 1;
+    }
+
+    // Check if the file exists (members and history are only built once something needs them)
+    library.setLazyLoading(true);
     ifstream file(filename);
     if (file.good()) {
-        // Load data from file
-        try {
-            library.loadFromFile(filename);
-        }
-        catch (const exception &e) {
-            cout << "Error: " << e.what() << endl;
+        // Load data from file. If that fails, stop before the journal is opened: the exit save
+        // would otherwise replace the file with an empty library.
+        if (!library.loadFromFile(filename)) {
+            cerr << "Error: '" << filename << "' could not be loaded, so the library was not started. Fix or move the file and try again." << endl;
+            return 1;
         }
     } else {
         cout << "Error: File '" << filename << "' does not exist. It will be automatically created when the program exits." << endl;
     }
 
+    // Replay anything left in the journal by a crash, then log every change until the next save
+    library.openJournal(filename + ".journal");
+
     while (running) {
+        library.pollBackgroundSave(); // Say so if a background save has finished
+
         // Get main menu choice (with input validation)
         int mainMenuChoice = getMenuChoice(displayMainMenu);
 
@@ -694,6 +1271,12 @@ int main() {
             case 7: // Transactions sub-menu
                 manageTransactions(library);
                 break;
+            case 8: // Memory report
+                library.displayMemoryReport();
+                break;
+            case 9: // Save without waiting (circulation carries on while the file is written)
+                library.startBackgroundSave(filename);
+                break;
             default: cout << "Invalid option. Please try again." << endl;
         }
     }
@@ -0,0 +1,114 @@
+/* Program name: BookStoreTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test the book store's handles (slot reuse after a delete) and its columns
+*/
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "BookStore.h"
+#include "Check.h"
+
+using namespace std;
+
+int main() {
+    TextPool text;
+    BookStore books;
+
+    BookHandle dune = books.insert(makeBook(text, "Dune", "Frank Herbert", isbnOf("9780441172719")));
+    BookHandle hobbit = books.insert(makeBook(text, "The Hobbit", "J.R.R. Tolkien", isbnOf("9780261103573")));
+    BookHandle emma = books.insert(makeBook(text, "Emma", "Jane Austen", isbnOf("9780141439587")));
+    CHECK(books.size() == 3);
+    CHECK(strcmp(books.get(hobbit)->getTitle(), "The Hobbit") == 0);
+
+    // A deleted book's handle goes stale, and the other handles still work
+    CHECK(books.erase(hobbit));
+    CHECK(!books.contains(hobbit));
+    CHECK(books.get(hobbit) == nullptr);
+    CHECK(!books.erase(hobbit));
+    CHECK(books.size() == 2);
+    CHECK(strcmp(books.get(dune)->getTitle(), "Dune") == 0);
+    CHECK(strcmp(books.get(emma)->getTitle(), "Emma") == 0);
+
+    // The freed slot is reused under a new generation, so the old handle never finds the new book
+    BookHandle carrie = books.insert(makeBook(text, "Carrie", "Stephen King", isbnOf("9780307743664")));
+    CHECK(carrie.index == hobbit.index);
+    CHECK(carrie.generation != hobbit.generation);
+    CHECK(books.get(hobbit) == nullptr);
+    CHECK(!books.replace(hobbit, makeBook(text, "Stale", "Nobody", isbnOf("9780261103573"))));
+    CHECK(!books.setBorrowed(hobbit, true, 100));
+    CHECK(strcmp(books.get(carrie)->getTitle(), "Carrie") == 0);
+
+    // The columns follow the slot's new book
+    CHECK(books.countGenre(FICTION) == 3);
+    CHECK(books.replace(carrie, makeBook(text, "Carrie", "Stephen King", isbnOf("9780307743664"), 1974, HORROR)));
+    CHECK(books.countGenre(FICTION) == 2 && books.countGenre(HORROR) == 1);
+    CHECK(books.countAvailable() == 3);
+    CHECK(books.setBorrowed(carrie, true, 100));
+    CHECK(books.get(carrie)->getIsBorrowed() && books.get(carrie)->getDueDay() == 100);
+    CHECK(books.countAvailable() == 2 && books.countAvailable(HORROR) == 0);
+    CHECK(books.findAvailable(HORROR).empty());
+    vector<BookHandle> available = books.findAvailable(FICTION);
+    CHECK(available.size() == 2 && available[0] == dune && available[1] == emma);
+    vector<BookHandle> due = books.findDue(100, 100);
+    CHECK(due.size() == 1 && due[0] == carrie);
+
+    // Deleting a borrowed book also takes it out of the due date index
+    CHECK(books.erase(carrie));
+    CHECK(books.findDue(0, 1000).empty());
+
+    // Iteration skips freed slots
+    size_t seen = 0;
+    for (BookStore::const_iterator it = books.begin(); it != books.end(); ++it) {
+        CHECK(strcmp(it->getTitle(), "Dune") == 0 || strcmp(it->getTitle(), "Emma") == 0);
+        CHECK(books.get(it.handle()) == &*it);
+        ++seen;
+    }
+    CHECK(seen == 2);
+
+    // Clearing invalidates every handle
+    books.clear();
+    CHECK(books.empty());
+    CHECK(books.get(dune) == nullptr);
+    CHECK(books.get(books.insert(makeBook(text, "Dune", "Frank Herbert", isbnOf("9780441172719")))) != nullptr);
+    CHECK(books.countGenre(FICTION) == 1 && books.countAvailable() == 1);
+
+    // The column passes work a 64-slot block at a time, so check counts that span blocks
+    books.clear();
+    vector<BookHandle> handles;
+    for (int i = 0; i < 200; ++i) {
+        handles.push_back(books.insert(makeBook(text, "Book " + to_string(i), "Author", isbnOf(to_string(i)), 2000,
+                                                i % 3 == 0 ? MYSTERY : SCIENCE)));
+    }
+    for (int i = 0; i < 200; i += 5) {
+        books.setBorrowed(handles[i], true, 100 + i % 7);
+    }
+    books.erase(handles[199]);
+    CHECK(books.countGenre(MYSTERY) == 67 && books.countGenre(SCIENCE) == 132);
+    CHECK(books.countAvailable() == 159);
+    CHECK(books.countAvailable(MYSTERY) == 53); // 67 mysteries, 14 of them borrowed
+    CHECK(books.findAvailable(MYSTERY).size() == 53);
+
+    // The due date index lists loans by day, then in the order they were borrowed
+    due = books.findDue(100, 106);
+    CHECK(due.size() == 40); // Every fifth book
+    for (size_t i = 1; i < due.size(); ++i) {
+        int32_t previous = books.get(due[i - 1])->getDueDay(), day = books.get(due[i])->getDueDay();
+        CHECK(previous < day || (previous == day && due[i - 1].index < due[i].index));
+    }
+    CHECK(books.findDue(102, 102).size() == 5); // Books 30, 65, 100, 135 and 170
+    CHECK(books.findDue(107, 200).empty() && books.findDue(102, 101).empty());
+
+    // Returning, borrowing again and replacing move books between days
+    books.setBorrowed(handles[30], false, NO_DUE_DATE);
+    books.setBorrowed(handles[65], true, 150);
+    books.replace(handles[100], makeBook(text, "Book 100", "Author", isbnOf("100"), 2000, MYSTERY));
+    CHECK(books.findDue(102, 102).size() == 2);
+    due = books.findDue(150, 150);
+    CHECK(due.size() == 1 && due[0] == handles[65]);
+    CHECK(books.countAvailable() == 161);
+
+    return checkResult("BookStoreTest");
+}
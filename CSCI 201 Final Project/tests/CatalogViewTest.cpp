@@ -0,0 +1,144 @@
+/* Program name: CatalogViewTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test that the catalog view answers searches and displays from a mapped snapshot as the library does
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "CatalogView.h"
+#include "Check.h"
+#include "Library.h"
+
+using namespace std;
+
+namespace {
+    // What a display or search writes to cout
+    string output(const function<void()> &show) {
+        ostringstream captured;
+        streambuf* original = cout.rdbuf(captured.rdbuf());
+        show();
+        cout.rdbuf(original);
+        return captured.str();
+    }
+
+    // The same output with its lines sorted, for results that may tie in a different order
+    string sortedLines(const string &text) {
+        istringstream in(text);
+        vector<string> lines;
+        string line;
+        while (getline(in, line)) {
+            lines.push_back(line);
+        }
+        sort(lines.begin(), lines.end());
+        string sorted;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            sorted += lines[i] + "\n";
+        }
+        return sorted;
+    }
+
+    const char* const searches[][2] = {
+        { "dune", "title" }, { "herbert", "author" }, { "tolkien", "any" }, { "9780261103573", "any" },
+        { "9780441172719", "isbn" }, { "0000000000000", "isbn" }, { "tolkein", "fuzzy" }, { "hobit", "title" },
+        { "silm", "title" }, { "zzz", "any" }, { "Fantasy", "genre" }, { "Poetry", "genre" }, { "1960-1980", "pubdate" },
+        { "1815", "pubdate" }, { "19x5", "pubdate" }, { "PR6039", "callnumber" }
+    };
+    const size_t searchCount = sizeof(searches) / sizeof(searches[0]);
+
+    // Every search and display of the view against the library's; ties may differ once books changed
+    void checkMatches(const CatalogView &view, const Library &library, bool exactOrder) {
+        for (size_t i = 0; i < searchCount; ++i) {
+            string query = searches[i][0], type = searches[i][1];
+            string fromView = output([&] { view.searchBook(query, type); });
+            string fromLibrary = output([&] { library.searchBook(query, type); });
+            if (!exactOrder) {
+                fromView = sortedLines(fromView);
+                fromLibrary = sortedLines(fromLibrary);
+            }
+            if (fromView != fromLibrary) {
+                cerr << "search \"" << query << "\" by " << type << " differs" << endl;
+            }
+            CHECK(fromView == fromLibrary);
+        }
+        CHECK(sortedLines(output([&] { view.displayBooks(); })) == sortedLines(output([&] { library.displayBooks(); })));
+        CHECK(output([&] { view.displayInventory(); }) == output([&] { library.displayInventory(); }));
+        CHECK(sortedLines(output([&] { view.displayAvailableBooks(FANTASY); })) ==
+              sortedLines(output([&] { library.displayAvailableBooks(FANTASY); })));
+        CHECK(output([&] { view.displayAvailableBooks(MYSTERY); }) == output([&] { library.displayAvailableBooks(MYSTERY); }));
+        CHECK(output([&] { view.searchBookByGenreAndDate(FANTASY, 1930, 1970); }) ==
+              output([&] { library.searchBookByGenreAndDate(FANTASY, 1930, 1970); }));
+    }
+}
+
+int main() {
+    string dir = makeTestDirectory();
+    string path = dir + "/library.snap";
+    const Isbn dune = isbnOf("9780441172719"), messiah = isbnOf("9780441172696"), hobbit = isbnOf("9780261103573"),
+               silmarillion = isbnOf("9780261102736"), emma = isbnOf("9780141439587"), carrie = isbnOf("9780307743664"),
+               fellowship = isbnOf("9780261103252");
+
+    TextPool text;
+    Library library;
+    {
+        QuietOutput quiet;
+        library.addBook(makeBook(text, "Dune", "Frank Herbert", dune, 1965, SCIENCE_FICTION));
+        library.addBook(makeBook(text, "Dune Messiah", "Frank Herbert", messiah, 1969, SCIENCE_FICTION));
+        library.addBook(Book(text, "The Hobbit", "J.R.R. Tolkien", hobbit, 1937, "PR6039", FANTASY));
+        library.addBook(Book(text, "The Silmarillion", "J.R.R. Tolkien", silmarillion, 1977, "PR6039", FANTASY));
+        library.addBook(makeBook(text, "Emma", "Jane Austen", emma, 1815, ROMANCE));
+        library.addBook(makeBook(text, "Carrie", "Stephen King", carrie, 1974, HORROR));
+        library.registerMember(makeMember(text, 1, "Alice"));
+        library.borrowBook(hobbit, 1);
+        CHECK(library.saveSnapshot(path));
+    }
+
+    // Straight from the full segment: the same output in the same order
+    {
+        CatalogView view(path);
+        CHECK(view.size() == 6);
+        CHECK(!view.isStale());
+        checkMatches(view, library, true);
+    }
+
+    // Books changed by a delta segment are read into the overlay, and replace the catalog's copies
+    CatalogView before(path);
+    {
+        QuietOutput quiet;
+        library.editBook(silmarillion, Book(text, "The Silmarillion", "Christopher Tolkien", silmarillion, 1977, "PR6039", FANTASY));
+        library.deleteBook(emma);
+        library.addBook(Book(text, "The Fellowship of the Ring", "J.R.R. Tolkien", fellowship, 1954, "PR6039", FANTASY));
+        library.returnBook(hobbit, 1);
+        CHECK(library.saveSnapshot(path));
+    }
+    CHECK(before.isStale());
+    CHECK(before.size() == 6);
+    {
+        CatalogView view(path);
+        CHECK(view.size() == 6);
+        CHECK(!view.isStale());
+        checkMatches(view, library, false);
+    }
+
+    // Files that are not snapshots are refused
+    {
+        ofstream text((dir + "/library.txt").c_str());
+        text << "Not a snapshot\n";
+    }
+    bool refused = false;
+    try {
+        CatalogView view(dir + "/library.txt");
+    } catch (const runtime_error&) {
+        refused = true;
+    }
+    CHECK(refused);
+
+    removeTestDirectory(dir);
+    return checkResult("CatalogViewTest");
+}
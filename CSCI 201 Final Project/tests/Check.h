@@ -0,0 +1,107 @@
+/* Program name: Check.h
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Define the checks and fixtures shared by the test programs (run with "make test")
+*/
+
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include "Book.h"
+#include "Isbn.h"
+#include "Member.h"
+#include "TextPool.h"
+
+using namespace std;
+
+// Each test program is one file in tests/ with its own main(). A failed check is reported with
+// its line and the program carries on, then exits non-zero if any check failed.
+inline int& checkFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            cerr << __FILE__ << ":" << __LINE__ << ": check failed: " << #condition << endl; \
+            ++checkFailures(); \
+        } \
+    } while (0)
+
+inline int checkResult(const string &name) {
+    if (checkFailures() > 0) {
+        cerr << name << ": " << checkFailures() << " check(s) failed" << endl;
+        return 1;
+    }
+    cout << name << ": all checks passed" << endl;
+    return 0;
+}
+
+// Keeps the library's progress messages (or, given cerr, its expected errors) out of the test
+// output while in scope. Failed checks go to cerr, so only quiet cerr around code with no checks.
+class QuietOutput {
+private:
+    ostream &stream;
+    streambuf* original;
+
+public:
+    explicit QuietOutput(ostream &stream = cout) : stream(stream), original(stream.rdbuf(nullptr)) {}
+    QuietOutput(const QuietOutput&) = delete;
+    QuietOutput& operator=(const QuietOutput&) = delete;
+    ~QuietOutput() {
+        stream.rdbuf(original);
+        stream.clear();
+    }
+};
+
+// Scratch directory for tests that write files (removed, with its files, by removeTestDirectory)
+inline string makeTestDirectory() {
+    char path[] = "/tmp/librarytestXXXXXX";
+    if (!mkdtemp(path)) {
+        cerr << "Unable to create a test directory" << endl;
+        exit(1);
+    }
+    return path;
+}
+
+inline void removeTestDirectory(const string &path) {
+    DIR* dir = opendir(path.c_str());
+    if (dir) {
+        while (dirent* entry = readdir(dir)) {
+            string name = entry->d_name;
+            if (name != "." && name != "..") {
+                remove((path + "/" + name).c_str());
+            }
+        }
+        closedir(dir);
+    }
+    rmdir(path.c_str());
+}
+
+// The ISBN of checked text (a null ISBN if it does not parse)
+inline Isbn isbnOf(const string &text) {
+    Isbn isbn;
+    Isbn::parse(text, isbn);
+    return isbn;
+}
+
+// A book or member with only the fields a test cares about filled in (text is copied into text)
+inline Book makeBook(TextPool &text, const string &title, const string &author, const Isbn &isbn, int pubDate = 2000,
+                     genreType genre = FICTION) {
+    return Book(text, title, author, isbn, pubDate, "QA76", genre);
+}
+
+inline Member makeMember(TextPool &text, int id, const string &name) {
+    return Member(text, name, id, "555-0100", name + "@example.com", "1 Main St");
+}
+
+#endif
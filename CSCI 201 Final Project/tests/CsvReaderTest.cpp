@@ -0,0 +1,158 @@
+/* Program name: CsvReaderTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test CSV reading (quoting, escaped quotes and line breaks) and catalog imports (and their journaling)
+*/
+
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+#include "Check.h"
+#include "CsvReader.h"
+#include "Library.h"
+
+using namespace std;
+
+namespace {
+    void writeFile(const string &filename, const string &contents) {
+        ofstream out(filename.c_str(), ios::binary | ios::trunc);
+        out << contents;
+    }
+
+    vector<string> fieldsOf(const char* a, const char* b = nullptr, const char* c = nullptr) {
+        vector<string> fields(1, a);
+        if (b) {
+            fields.push_back(b);
+        }
+        if (c) {
+            fields.push_back(c);
+        }
+        return fields;
+    }
+}
+
+int main() {
+    string dir = makeTestDirectory();
+    string path = dir + "/rows.csv";
+    vector<string> fields;
+
+    // Quoted fields can hold the delimiter, "" for a quote, and line breaks (LF or CRLF); quotes
+    // only open a field at its start; CRs outside quotes are dropped
+    writeFile(path,
+        "plain,\"a, b\",\"say \"\"hi\"\"\"\n"
+        "\"two\nlines\",\"crlf\r\nkept\",x\"y\"\r\n"
+        ",,\n"
+        "\n"
+        "\"\",last");
+    {
+        CsvReader reader(path);
+        CHECK(reader.next(fields) && fields == fieldsOf("plain", "a, b", "say \"hi\""));
+        CHECK(reader.getLineNumber() == 1);
+        CHECK(reader.next(fields) && fields == fieldsOf("two\nlines", "crlf\r\nkept", "x\"y\""));
+        CHECK(reader.getLineNumber() == 2);
+        CHECK(reader.next(fields) && fields == fieldsOf("", "", ""));
+        CHECK(reader.getLineNumber() == 5); // The record above took lines 2 to 4
+        CHECK(reader.next(fields) && fields == fieldsOf(""));
+        CHECK(reader.next(fields) && fields == fieldsOf("", "last")); // No line break at the end
+        CHECK(!reader.next(fields));
+        CHECK(reader.getBytesRead() == reader.getFileSize());
+    }
+
+    // An unterminated quote runs to the end of the file
+    writeFile(path, "a,\"open\nstill open");
+    {
+        CsvReader reader(path);
+        CHECK(reader.next(fields) && fields == fieldsOf("a", "open\nstill open"));
+        CHECK(!reader.next(fields));
+    }
+
+    // Tab separated, with a quoted field longer than the reader's buffer
+    string longField(3 << 20, 'x');
+    longField[1000] = '\n';
+    longField[2000] = '\t';
+    writeFile(path, "\"" + longField + "\"\tend\nnext\n");
+    {
+        CsvReader reader(path, '\t');
+        CHECK(reader.next(fields) && fields.size() == 2 && fields[0] == longField && fields[1] == "end");
+        CHECK(reader.next(fields) && fields == fieldsOf("next"));
+        CHECK(reader.getLineNumber() == 3);
+    }
+
+    // Imports take quoted titles as written and ISBN-10s as their ISBN-13, and skip rows with a line
+    // break in a field (the text data file could not hold it), a bad ISBN check digit (Emma), a bad
+    // publication date (Persuasion) or an ISBN already in the library
+    string catalog = dir + "/catalog.csv";
+    writeFile(catalog,
+        "\xEF\xBB\xBFtitle,author,isbn,pub_date,call_number,genre\r\n"
+        "\"Dune, \"\"Deluxe\"\"\",Frank Herbert,978-0-441-17271-9,1965,PS3558,fiction\r\n"
+        "\"The\nHobbit\",J.R.R. Tolkien,9780261103573,1937,PR6039,Fantasy\r\n"
+        "Emma,Jane Austen,9780141439588,1815,PR4034,Romance\r\n"
+        "Persuasion,Jane Austen,9780141439686,18x7,PR4034,Romance\r\n"
+        "Carrie,Stephen King,0307743667,1974,PS3561,4\r\n"
+        "Dune,Frank Herbert,9780441172719,1965,PS3558,Fiction\r\n");
+    Library library;
+    {
+        QuietOutput quiet;
+        QuietOutput quietErrors(cerr); // The bad rows are reported
+        CHECK(library.importBooks(catalog));
+    }
+    CHECK(library.getBooks().size() == 2);
+    const Book* dune = library.findBook(isbnOf("9780441172719"));
+    CHECK(dune && strcmp(dune->getTitle(), "Dune, \"Deluxe\"") == 0 && dune->getGenre() == FICTION);
+    CHECK(!library.hasBook(isbnOf("9780261103573"))); // Line break in the title
+    CHECK(!library.hasBook(isbnOf("9780141439587")) && !library.hasBook(isbnOf("9780141439686")));
+    CHECK(library.findBook(isbnOf("9780307743664")) && library.findBook(isbnOf("9780307743664"))->getGenre() == HORROR);
+
+    // Imported books are saved like any other
+    string data = dir + "/library.txt";
+    {
+        QuietOutput quiet;
+        CHECK(library.saveToFile(data));
+        Library loaded;
+        CHECK(loaded.loadFromFile(data));
+        CHECK(loaded.getBooks().size() == 2 && loaded.hasBook(isbnOf("9780307743664")));
+    }
+
+    // Imports are journaled before the books are added, so they are replayed after a crash; if
+    // the journal cannot be written, the import fails and adds nothing
+    string journalName = dir + "/import.journal";
+    {
+        QuietOutput quiet;
+        QuietOutput quietErrors(cerr);
+        Library journaled;
+        journaled.openJournal(journalName);
+        CHECK(journaled.importBooks(catalog));
+    }
+    {
+        QuietOutput quiet;
+        Library replayed;
+        replayed.openJournal(journalName);
+        CHECK(replayed.getBooks().size() == 2 && replayed.hasBook(isbnOf("9780307743664")));
+
+        struct stat info;
+        CHECK(stat(journalName.c_str(), &info) == 0);
+        struct rlimit limit, small;
+        getrlimit(RLIMIT_FSIZE, &limit);
+        small = limit;
+        small.rlim_cur = static_cast<rlim_t>(info.st_size); // Writes past the journal's end fail
+        signal(SIGXFSZ, SIG_IGN);
+        setrlimit(RLIMIT_FSIZE, &small);
+        writeFile(catalog, "Emma,Jane Austen,9780141439587,1815,PR4034,Romance\n");
+        bool imported;
+        {
+            QuietOutput quietErrors(cerr);
+            imported = replayed.importBooks(catalog);
+        }
+        setrlimit(RLIMIT_FSIZE, &limit);
+        CHECK(!imported && !replayed.hasBook(isbnOf("9780141439587")));
+    }
+
+    removeTestDirectory(dir);
+    return checkResult("CsvReaderTest");
+}
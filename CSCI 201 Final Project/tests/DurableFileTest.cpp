@@ -0,0 +1,100 @@
+/* Program name: DurableFileTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test atomic file replacement and that failed or background saves never damage the data file
+*/
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+
+#include "Check.h"
+#include "DurableFile.h"
+#include "Library.h"
+
+using namespace std;
+
+namespace {
+    string readFile(const string &filename) {
+        ifstream in(filename.c_str(), ios::binary);
+        ostringstream contents;
+        contents << in.rdbuf();
+        return contents.str();
+    }
+
+    bool exists(const string &filename) {
+        struct stat info;
+        return stat(filename.c_str(), &info) == 0;
+    }
+}
+
+int main() {
+    string dir = makeTestDirectory();
+    string path = dir + "/library.txt";
+
+    // The new version replaces the old one and the temporary name is gone
+    ofstream(path.c_str()) << "old";
+    string temp = temporaryName(path);
+    CHECK(temp != path && temp.compare(0, dir.size(), dir) == 0); // Same directory, so the rename is atomic
+    ofstream(temp.c_str()) << "new";
+    replaceFile(temp, path);
+    CHECK(readFile(path) == "new" && !exists(temp));
+
+    // Replacing from a missing file throws and leaves the target alone
+    bool threw = false;
+    try {
+        replaceFile(temp, path);
+    } catch (const runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw && readFile(path) == "new");
+
+    // Deleting a missing file is not an error
+    removeFile(path);
+    CHECK(!exists(path));
+    removeFile(path);
+
+    const Isbn dune = isbnOf("9780441172719"), hobbit = isbnOf("9780261103573");
+    TextPool text;
+    Library library;
+    {
+        QuietOutput quiet;
+        library.addBook(makeBook(text, "Dune", "Frank Herbert", dune));
+        CHECK(library.saveToFile(path));
+    }
+    string saved = readFile(path);
+    CHECK(!exists(temp));
+
+    // A save that cannot write its temporary file fails and keeps the old file
+    mkdir(temp.c_str(), 0700);
+    {
+        QuietOutput quiet;
+        QuietOutput quietErrors(cerr);
+        library.addBook(makeBook(text, "The Hobbit", "J.R.R. Tolkien", hobbit));
+        CHECK(!library.saveToFile(path));
+    }
+    CHECK(readFile(path) == saved);
+    rmdir(temp.c_str());
+
+    // A background save writes the library as it was when the save started
+    string backgroundPath = dir + "/background.txt";
+    {
+        QuietOutput quiet;
+        CHECK(library.startBackgroundSave(backgroundPath));
+        library.deleteBook(dune);
+        library.waitForBackgroundSave();
+    }
+    CHECK(!library.hasBook(dune));
+    Library loaded;
+    {
+        QuietOutput quiet;
+        CHECK(loaded.loadFromFile(backgroundPath));
+    }
+    CHECK(loaded.hasBook(dune) && loaded.hasBook(hobbit));
+    CHECK(!exists(temporaryName(backgroundPath)));
+
+    removeTestDirectory(dir);
+    return checkResult("DurableFileTest");
+}
@@ -0,0 +1,118 @@
+/* Program name: EpochDayTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test the conversions between calendar dates, day numbers and due date text, and due-soon periods
+*/
+
+#include <climits>
+#include <ctime>
+#include <sstream>
+#include <string>
+
+#include "Check.h"
+#include "EpochDay.h"
+#include "Library.h"
+
+using namespace std;
+
+namespace {
+    bool roundTrips(int32_t epochDay) {
+        int year, month, day;
+        dateFromEpochDay(epochDay, year, month, day);
+        return epochDayFromDate(year, month, day) == epochDay;
+    }
+
+    bool parsesAs(const char* text, int32_t expected) {
+        int32_t epochDay = -1;
+        return parseEpochDay(text, epochDay) && epochDay == expected;
+    }
+}
+
+int main() {
+    // Known days
+    CHECK(epochDayFromDate(1970, 1, 1) == 0);
+    CHECK(epochDayFromDate(1969, 12, 31) == -1);
+    CHECK(epochDayFromDate(2000, 3, 1) == 11017);
+    CHECK(epochDayFromDate(2023, 11, 28) == 19689);
+    CHECK(epochDayFromDate(1600, 1, 1) == -135140);
+
+    // Every day from 1600 to 2400 converts back to itself, one day after the one before
+    int previousYear, previousMonth, previousDay;
+    dateFromEpochDay(epochDayFromDate(1600, 1, 1) - 1, previousYear, previousMonth, previousDay);
+    CHECK(previousYear == 1599 && previousMonth == 12 && previousDay == 31);
+    for (int32_t epochDay = epochDayFromDate(1600, 1, 1); epochDay <= epochDayFromDate(2400, 12, 31); ++epochDay) {
+        int year, month, day;
+        dateFromEpochDay(epochDay, year, month, day);
+        bool next = (year == previousYear && month == previousMonth && day == previousDay + 1) ||
+                    (year == previousYear && month == previousMonth + 1 && day == 1) ||
+                    (year == previousYear + 1 && month == 1 && day == 1 && previousMonth == 12 && previousDay == 31);
+        if (!next || epochDayFromDate(year, month, day) != epochDay) {
+            CHECK(next && epochDayFromDate(year, month, day) == epochDay);
+            break;
+        }
+        previousYear = year;
+        previousMonth = month;
+        previousDay = day;
+    }
+    CHECK(roundTrips(epochDayFromDate(9999, 12, 31)));
+
+    // Leap years: every fourth year, except centuries not divisible by 400
+    CHECK(epochDayFromDate(2024, 3, 1) - epochDayFromDate(2024, 2, 28) == 2);
+    CHECK(epochDayFromDate(2023, 3, 1) - epochDayFromDate(2023, 2, 28) == 1);
+    CHECK(epochDayFromDate(1900, 3, 1) - epochDayFromDate(1900, 2, 28) == 1);
+    CHECK(epochDayFromDate(2000, 3, 1) - epochDayFromDate(2000, 2, 28) == 2);
+
+    // Text is exactly YYYY-MM-DD and a real date
+    CHECK(parsesAs("1970-01-01", 0));
+    CHECK(parsesAs("2024-02-29", epochDayFromDate(2024, 2, 29)));
+    CHECK(parsesAs("9999-12-31", epochDayFromDate(9999, 12, 31)));
+    int32_t epochDay;
+    CHECK(!parseEpochDay("2023-02-29", epochDay));
+    CHECK(!parseEpochDay("1900-02-29", epochDay));
+    CHECK(!parseEpochDay("2023-04-31", epochDay));
+    CHECK(!parseEpochDay("2023-13-01", epochDay));
+    CHECK(!parseEpochDay("2023-00-10", epochDay));
+    CHECK(!parseEpochDay("2023-01-00", epochDay));
+    CHECK(!parseEpochDay("2023-1-01", epochDay));
+    CHECK(!parseEpochDay("2023-01-01 ", epochDay));
+    CHECK(!parseEpochDay("2023/01/01", epochDay));
+    CHECK(!parseEpochDay("+023-01-01", epochDay));
+    CHECK(!parseEpochDay("", epochDay));
+    CHECK(formatEpochDay(0) == "1970-01-01");
+    CHECK(formatEpochDay(epochDayFromDate(2023, 11, 28)) == "2023-11-28");
+    CHECK(formatEpochDay(epochDayFromDate(9999, 12, 31)) == "9999-12-31");
+
+    // A book's due date may also be "None"
+    CHECK(parseDueDate("None", epochDay) && epochDay == NO_DUE_DATE);
+    CHECK(parseDueDate("2023-11-28", epochDay) && epochDay == epochDayFromDate(2023, 11, 28));
+    CHECK(!parseDueDate("none", epochDay));
+    CHECK(formatDueDate(NO_DUE_DATE) == "None");
+    CHECK(formatDueDate(0) == "1970-01-01");
+
+    // Local days follow the local calendar
+    tm noon = tm();
+    noon.tm_year = 2023 - 1900;
+    noon.tm_mon = 10;
+    noon.tm_mday = 28;
+    noon.tm_hour = 12;
+    noon.tm_isdst = -1;
+    CHECK(localEpochDay(mktime(&noon)) == epochDayFromDate(2023, 11, 28));
+    CHECK(currentEpochDay() == localEpochDay(time(nullptr)));
+
+    // A due-soon period longer than four-digit years allow stops at the last due date
+    TextPool text;
+    Library library;
+    ostringstream shown;
+    {
+        QuietOutput quiet;
+        library.addBook(makeBook(text, "Dune", "Frank Herbert", isbnOf("9780441172719")));
+        library.registerMember(makeMember(text, 1, "Alice"));
+        library.borrowBook(isbnOf("9780441172719"), 1);
+        cout.rdbuf(shown.rdbuf());
+        library.displayLoansDueWithin(INT_MAX);
+    }
+    CHECK(shown.str().find("Books Due by 9999-12-31:") == 0);
+    CHECK(shown.str().find("9780441172719") != string::npos);
+
+    return checkResult("EpochDayTest");
+}
@@ -0,0 +1,115 @@
+/* Program name: ExportWriterTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test export escaping (CSV read back with CsvReader, JSON Lines checked as text)
+*/
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "Check.h"
+#include "CsvReader.h"
+#include "ExportWriter.h"
+
+using namespace std;
+
+namespace {
+    string readFile(const string &filename) {
+        ifstream in(filename.c_str(), ios::binary);
+        ostringstream contents;
+        contents << in.rdbuf();
+        return contents.str();
+    }
+
+    // Values that need every kind of escaping
+    const char* const awkward[] = { "plain", "a, b", "say \"hi\"", "two\nlines", "cr\r\nlf", "back\\slash\ttab\x01" };
+    const size_t awkwardCount = sizeof(awkward) / sizeof(awkward[0]);
+
+    void writeAwkward(ExportWriter &out) {
+        vector<string> columns;
+        columns.push_back("text");
+        columns.push_back("number");
+        columns.push_back("flag");
+        out.begin(columns);
+        for (size_t i = 0; i < awkwardCount; ++i) {
+            out.addText(awkward[i]);
+            out.addNumber(-static_cast<long long>(i));
+            out.addBool(i % 2 == 0);
+            out.endRecord();
+        }
+    }
+}
+
+int main() {
+    string dir = makeTestDirectory();
+
+    // CSV: every value reads back exactly as written
+    string csv = dir + "/out.csv";
+    CHECK(ExportWriter::formatFor(csv) == EXPORT_CSV);
+    {
+        ExportWriter out(csv, EXPORT_CSV);
+        writeAwkward(out);
+        CHECK(access(csv.c_str(), F_OK) != 0); // Written under a temporary name until finish()
+        out.finish();
+        CHECK(out.getRecordCount() == awkwardCount);
+    }
+    {
+        CsvReader reader(csv);
+        vector<string> fields;
+        CHECK(reader.next(fields) && fields.size() == 3 && fields[0] == "text" && fields[2] == "flag");
+        for (size_t i = 0; i < awkwardCount; ++i) {
+            CHECK(reader.next(fields) && fields.size() == 3);
+            CHECK(fields.size() == 3 && fields[0] == awkward[i]);
+            CHECK(fields.size() == 3 && fields[1] == (i == 0 ? "0" : "-" + to_string(i)));
+            CHECK(fields.size() == 3 && fields[2] == (i % 2 == 0 ? "true" : "false"));
+        }
+        CHECK(!reader.next(fields));
+    }
+    CHECK(readFile(csv).find("\"say \"\"hi\"\"\"") != string::npos);
+
+    // JSON Lines: one object per line, so line breaks and control characters are escaped
+    string jsonl = dir + "/out.jsonl";
+    CHECK(ExportWriter::formatFor(jsonl) == EXPORT_JSON_LINES);
+    {
+        ExportWriter out(jsonl, EXPORT_JSON_LINES);
+        writeAwkward(out);
+        out.finish();
+    }
+    string json = readFile(jsonl);
+    istringstream lines(json);
+    string line;
+    size_t count = 0;
+    while (getline(lines, line)) {
+        CHECK(line[0] == '{' && line[line.size() - 1] == '}');
+        ++count;
+    }
+    CHECK(count == awkwardCount);
+    CHECK(json.find("{\"text\":\"plain\",\"number\":0,\"flag\":true}\n") == 0);
+    CHECK(json.find("\"say \\\"hi\\\"\"") != string::npos);
+    CHECK(json.find("\"two\\nlines\"") != string::npos);
+    CHECK(json.find("\"cr\\u000d\\nlf\"") != string::npos);
+    CHECK(json.find("\"back\\\\slash\\ttab\\u0001\"") != string::npos);
+
+    // A record with the wrong number of values is refused
+    {
+        ExportWriter out(dir + "/bad.csv", EXPORT_CSV);
+        out.begin(vector<string>(2, "column"));
+        out.addText("one");
+        bool refused = false;
+        try {
+            out.endRecord();
+        } catch (const logic_error&) {
+            refused = true;
+        }
+        CHECK(refused);
+    }
+    CHECK(access((dir + "/bad.csv").c_str(), F_OK) != 0); // Never finished, so never moved into place
+
+    removeTestDirectory(dir);
+    return checkResult("ExportWriterTest");
+}
@@ -0,0 +1,57 @@
+/* Program name: FilterIndexTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test the publication date and per-genre indexes
+*/
+
+#include <string>
+#include <vector>
+
+#include "BookStore.h"
+#include "Check.h"
+#include "FilterIndex.h"
+
+using namespace std;
+
+int main() {
+    TextPool text;
+    BookStore books;
+    FilterIndex index;
+    BookHandle emma = books.insert(makeBook(text, "Emma", "Jane Austen", isbnOf("9780141439587"), 1815, ROMANCE));
+    BookHandle dune = books.insert(makeBook(text, "Dune", "Frank Herbert", isbnOf("9780441172719"), 1965, SCIENCE_FICTION));
+    BookHandle hobbit = books.insert(makeBook(text, "The Hobbit", "J.R.R. Tolkien", isbnOf("9780261103573"), 1937, FANTASY));
+    BookHandle rings = books.insert(makeBook(text, "The Fellowship of the Ring", "J.R.R. Tolkien", isbnOf("9780261103252"), 1954, FANTASY));
+    BookHandle silmarillion = books.insert(makeBook(text, "The Silmarillion", "J.R.R. Tolkien", isbnOf("9780261102736"), 1937, FANTASY)); // Not really, but the same year as the hobbit
+    BookHandle all[] = { emma, dune, hobbit, rings, silmarillion };
+    for (size_t i = 0; i < 5; ++i) {
+        index.add(all[i], *books.get(all[i]));
+    }
+
+    // Ranges are inclusive, oldest first, and books from the same year are all kept
+    vector<BookHandle> found = index.findByPubDate(1937, 1954);
+    CHECK(found.size() == 3 && found.back() == rings);
+    CHECK(index.findByPubDate(1937, 1937).size() == 2);
+    CHECK(index.findByPubDate(1816, 1936).empty());
+    CHECK(index.findByPubDate(1965, 1815).empty());
+    found = index.findByPubDate(INT_MIN, INT_MAX);
+    CHECK(found.size() == 5 && found.front() == emma && found.back() == dune);
+
+    // Genre buckets, optionally narrowed by date
+    CHECK(index.countGenre(FANTASY) == 3);
+    CHECK(index.countGenre(HISTORY) == 0);
+    CHECK(index.findByGenre(FANTASY).size() == 3);
+    found = index.findByGenre(FANTASY, 1940, 2000);
+    CHECK(found.size() == 1 && found[0] == rings);
+    CHECK(index.findByGenre(ROMANCE, 1900).empty());
+
+    // Removing one of two books from the same year leaves the other
+    index.remove(hobbit, *books.get(hobbit));
+    found = index.findByPubDate(1937, 1937);
+    CHECK(found.size() == 1 && found[0] == silmarillion);
+    CHECK(index.countGenre(FANTASY) == 2);
+
+    index.clear();
+    CHECK(index.findByPubDate(INT_MIN, INT_MAX).empty() && index.countGenre(FANTASY) == 0);
+
+    return checkResult("FilterIndexTest");
+}
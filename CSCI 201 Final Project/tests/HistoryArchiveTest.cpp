@@ -0,0 +1,120 @@
+/* Program name: HistoryArchiveTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test sealing, decoding, adopting and time-range queries of archived history
+*/
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "HistoryArchive.h"
+
+using namespace std;
+
+namespace {
+    const char* ISBNS[] = { "9780441172719", "9780804429573", "12345" };
+
+    // Transactions an hour apart from the start time, every third one a return
+    vector<HistoryRecord> makeRecords(time_t start, size_t count) {
+        vector<HistoryRecord> records(count);
+        for (size_t i = 0; i < count; ++i) {
+            HistoryRecord &record = records[i];
+            record.isBorrow = i % 3 != 2;
+            record.isbn = ISBNS[i % 3];
+            record.memberID = static_cast<int>(1000 + i % 7);
+            record.transactionDate = start + static_cast<time_t>(i) * 3600;
+            record.dueDate = record.isBorrow ? "2026-11-01" : 0;
+        }
+        return records;
+    }
+
+    bool sameRecord(const HistoryRecord &a, const HistoryRecord &b) {
+        return a.isBorrow == b.isBorrow && strcmp(a.isbn, b.isbn) == 0 && a.memberID == b.memberID
+            && a.transactionDate == b.transactionDate
+            && (!a.isBorrow || strcmp(a.dueDate, b.dueDate) == 0);
+    }
+
+    struct Collector {
+        vector<time_t>* dates;
+        void operator()(const HistoryRecord &record) const {
+            dates->push_back(record.transactionDate);
+        }
+    };
+
+    vector<time_t> datesBetween(const HistoryArchive &archive, time_t from, time_t to) {
+        vector<time_t> dates;
+        Collector collect = { &dates };
+        archive.forEach(from, to, collect);
+        return dates;
+    }
+}
+
+int main() {
+    const time_t start = 1760000000;
+    vector<HistoryRecord> first = makeRecords(start, 10);
+    vector<HistoryRecord> second = makeRecords(start + 10 * 3600, 5);
+
+    HistoryArchive archive;
+    archive.seal(&first[0], first.size());
+    archive.seal(&second[0], second.size());
+    CHECK(archive.segmentCount() == 2);
+    CHECK(archive.size() == 15);
+    CHECK(archive.getInfo(0).minTime == start && archive.getInfo(0).maxTime == start + 9 * 3600);
+    CHECK(archive.getInfo(1).count == 5);
+
+    // Each segment decodes back to exactly what was sealed
+    vector<HistoryRecord> decoded;
+    archive.decode(0, decoded);
+    CHECK(decoded.size() == first.size());
+    bool same = decoded.size() == first.size();
+    for (size_t i = 0; same && i < decoded.size(); ++i) {
+        same = sameRecord(decoded[i], first[i]);
+    }
+    CHECK(same);
+
+    // Time ranges are inclusive and may span segments
+    CHECK(datesBetween(archive, start, start).size() == 1);
+    vector<time_t> spanning = datesBetween(archive, start + 8 * 3600, start + 11 * 3600);
+    CHECK(spanning.size() == 4 && spanning.front() == start + 8 * 3600 && spanning.back() == start + 11 * 3600);
+    CHECK(datesBetween(archive, start + 10 * 3600, start + 100 * 3600).size() == 5); // Only the second segment
+    CHECK(datesBetween(archive, start - 100, start - 1).empty());
+    CHECK(datesBetween(archive, start + 15 * 3600, start + 16 * 3600).empty());
+
+    // A segment adopted from elsewhere (as a snapshot does) reads the same
+    HistoryArchive adopted;
+    size_t size = 0;
+    const uint8_t* data = archive.getData(1, size);
+    vector<uint8_t> copy(data, data + size);
+    adopted.adopt(archive.getInfo(1), &copy[0], copy.size());
+    adopted.decode(0, decoded);
+    CHECK(decoded.size() == second.size() && sameRecord(decoded.back(), second.back()));
+
+    // A description that cannot fit its data is refused, and so is data cut short
+    HistoryArchive::SegmentInfo tooMany = archive.getInfo(1);
+    tooMany.count = static_cast<uint32_t>(copy.size() + 1);
+    bool threw = false;
+    try {
+        adopted.adopt(tooMany, &copy[0], copy.size());
+    } catch (const runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    HistoryArchive truncated;
+    truncated.adopt(archive.getInfo(1), &copy[0], copy.size() / 2);
+    threw = false;
+    try {
+        truncated.decode(0, decoded);
+    } catch (const runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    adopted.clear();
+    CHECK(adopted.segmentCount() == 0 && adopted.size() == 0);
+
+    return checkResult("HistoryArchiveTest");
+}
@@ -0,0 +1,104 @@
+/* Program name: HoldTableTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test hold queues (first come, first served, with cancels from anywhere in line)
+*/
+
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "HoldTable.h"
+#include "Library.h"
+
+using namespace std;
+
+namespace {
+    vector<int> queueOf(int a, int b = -1, int c = -1) {
+        vector<int> queue(1, a);
+        if (b != -1) {
+            queue.push_back(b);
+        }
+        if (c != -1) {
+            queue.push_back(c);
+        }
+        return queue;
+    }
+}
+
+int main() {
+    const Isbn dune = isbnOf("9780441172719"), hobbit = isbnOf("9780261103573");
+
+    HoldTable holds;
+    CHECK(!holds.isHeld(dune));
+    CHECK(holds.getNextInLine(dune) == -1);
+
+    // Members are served in the order they joined
+    CHECK(holds.enqueue(dune, 1) == 1);
+    CHECK(holds.enqueue(dune, 2) == 2);
+    CHECK(holds.enqueue(dune, 3) == 3);
+    CHECK(holds.enqueue(dune, 2) == 0); // Already waiting: keeps their place
+    CHECK(holds.getQueue(dune) == queueOf(1, 2, 3));
+    CHECK(holds.getNextInLine(dune) == 1);
+
+    // Cancelling from the middle, then the front, keeps everyone else in order
+    CHECK(holds.cancel(dune, 2));
+    CHECK(!holds.cancel(dune, 2));
+    CHECK(holds.getQueue(dune) == queueOf(1, 3));
+    CHECK(holds.cancel(dune, 1));
+    CHECK(holds.getNextInLine(dune) == 3);
+
+    // A member who left joins again at the back (their freed hold is reused without reordering)
+    CHECK(holds.enqueue(dune, 1) == 2);
+    CHECK(holds.enqueue(dune, 4) == 3);
+    CHECK(holds.getQueue(dune) == queueOf(3, 1, 4));
+    CHECK(holds.cancel(dune, 4)); // From the back
+    CHECK(holds.enqueue(dune, 5) == 3);
+    CHECK(holds.getQueue(dune) == queueOf(3, 1, 5));
+
+    // Queues are per book, and members are tracked across them
+    CHECK(holds.enqueue(hobbit, 1) == 1);
+    CHECK(holds.hasHold(hobbit, 1) && holds.hasHold(dune, 1) && !holds.hasHold(hobbit, 3));
+    CHECK(holds.size() == 4);
+    vector<Isbn> held = holds.getHeldBooks();
+    CHECK(held.size() == 2 && held[0] == hobbit && held[1] == dune); // Sorted by ISBN
+    holds.cancelAll(dune);
+    CHECK(!holds.isHeld(dune) && holds.getQueue(dune).empty());
+    CHECK(!holds.hasHolds(3) && holds.hasHolds(1));
+    CHECK(holds.cancel(hobbit, 1));
+    CHECK(holds.size() == 0 && !holds.hasHolds(1) && holds.getHeldBooks().empty());
+
+    // Through the library: only the first member in line can borrow a returned book, and
+    // borrowing it serves their hold
+    TextPool text;
+    Library library;
+    {
+        QuietOutput quiet;
+        library.addBook(makeBook(text, "Dune", "Frank Herbert", dune, 1965));
+        for (int id = 1; id <= 4; ++id) {
+            library.registerMember(makeMember(text, id, "Member " + to_string(id)));
+        }
+        library.borrowBook(dune, 1);
+        library.reserveBook(dune, 2);
+        library.reserveBook(dune, 3);
+        library.reserveBook(dune, 4);
+        library.cancelReservation(dune, 2);
+        library.returnBook(dune, 1);
+        library.borrowBook(dune, 4); // Not their turn
+    }
+    CHECK(!library.findBook(dune)->getIsBorrowed());
+    CHECK(library.getHolds().getQueue(dune) == queueOf(3, 4));
+    {
+        QuietOutput quiet;
+        library.borrowBook(dune, 3);
+    }
+    CHECK(library.findBook(dune)->getIsBorrowed());
+    CHECK(library.getHolds().getQueue(dune) == queueOf(4));
+    {
+        QuietOutput quiet;
+        library.deleteMember(4); // Refused while they are waiting
+    }
+    CHECK(library.hasMember(4));
+
+    return checkResult("HoldTableTest");
+}
@@ -0,0 +1,175 @@
+/* Program name: IsbnTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test ISBN-10/13 normalization, legacy ISBNs and skipping unreadable or colliding ISBNs in data files
+*/
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "Check.h"
+#include "Isbn.h"
+#include "Library.h"
+
+using namespace std;
+
+namespace {
+    bool parses(const string &text, const string &expected) {
+        Isbn isbn;
+        return Isbn::parse(text, isbn) && isbn.toString() == expected;
+    }
+
+    bool parsesSaved(const string &text, const string &expected) {
+        Isbn isbn;
+        return Isbn::parseSaved(text.c_str(), isbn) && isbn.toString() == expected;
+    }
+
+    bool rejected(const string &text) {
+        Isbn isbn;
+        return !Isbn::parse(text, isbn);
+    }
+
+    bool rejectedSaved(const string &text) {
+        Isbn isbn;
+        return !Isbn::parseSaved(text.c_str(), isbn);
+    }
+
+    Isbn savedIsbn(const string &text) {
+        Isbn isbn;
+        Isbn::parseSaved(text.c_str(), isbn);
+        return isbn;
+    }
+
+    // A data file holding one book per ISBN (and nothing else)
+    string dataFile(const string &isbn1, const string &isbn2) {
+        ostringstream out;
+        out << "2\n"
+            << "Dune\nFrank Herbert\n" << isbn1 << "\n1965\nPS3558\nFiction\n0\nNone\n"
+            << "Emma\nJane Austen\n" << isbn2 << "\n1815\nPR4034\nRomance\n0\nNone\n"
+            << "0\n0\n0\n";
+        return out.str();
+    }
+
+    string readFile(const string &filename) {
+        ifstream in(filename.c_str(), ios::binary);
+        ostringstream contents;
+        contents << in.rdbuf();
+        return contents.str();
+    }
+}
+
+int main() {
+    // ISBN-10s become their 978 ISBN-13; hyphens and spaces are ignored
+    CHECK(parses("9780441172719", "9780441172719"));
+    CHECK(parses("0441172717", "9780441172719"));
+    CHECK(parses("0-441-17271-7", "9780441172719"));
+    CHECK(parses("978 0 441 17271 9", "9780441172719"));
+    CHECK(parses("080442957X", "9780804429573"));  // X check digit
+    CHECK(parses("080442957x", "9780804429573"));
+    CHECK(parses("9791032300824", "9791032300824")); // 979 prefix
+    Isbn ten, thirteen;
+    CHECK(Isbn::parse("0441172717", ten) && Isbn::parse("978-0441172719", thirteen) && ten == thirteen);
+    CHECK(Isbn().isNull() && !ten.isNull());
+
+    // Typed-in ISBNs must be real ones
+    CHECK(rejected("0441172710"));     // ISBN-10 check digit
+    CHECK(rejected("9780441172718"));  // ISBN-13 check digit
+    CHECK(rejected("1234567890128"));  // Neither 978 nor 979
+    CHECK(rejected("04411727X7"));     // X only ends an ISBN-10
+    CHECK(rejected("97804411727190")); // Too long
+    CHECK(rejected("12345"));
+    CHECK(rejected(""));
+    CHECK(rejected("0000000000000"));
+
+    // Saved ISBNs are read the same way when they are real ones...
+    CHECK(parsesSaved("0441172717", "9780441172719"));
+    CHECK(parsesSaved("978-0441172719", "9780441172719"));
+    CHECK(!savedIsbn("0441172717").isLegacy());
+
+    // ...but ones with a wrong check digit (older files were never checked) are kept as they
+    // were saved, rather than becoming the ISBN-13 of another book
+    CHECK(parsesSaved("0441172710", "0441172710") && savedIsbn("0441172710").isLegacy());
+    CHECK(parsesSaved("9780441172718", "9780441172718") && savedIsbn("9780441172718").isLegacy());
+    CHECK(savedIsbn("0441172710") != savedIsbn("0441172717"));
+
+    // Anything else a saved file holds is kept as a legacy ISBN, exactly as written
+    CHECK(parsesSaved("12345", "12345"));
+    CHECK(parsesSaved("00123", "00123"));
+    CHECK(savedIsbn("00123") != savedIsbn("123")); // Leading zeros are kept apart
+    CHECK(parsesSaved("12345678901234567", "12345678901234567")); // Longest digit string
+    CHECK(parsesSaved("AB-12", "AB-12"));
+    CHECK(parsesSaved("Xx-0123456", "Xx-0123456"));               // Longest text
+    CHECK(savedIsbn("ab-12") != savedIsbn("AB-12"));
+    CHECK(savedIsbn("12345").isLegacy() && savedIsbn("AB-12").isLegacy());
+    CHECK(!savedIsbn("9799999999990").isLegacy() && savedIsbn("9799999999990") < savedIsbn("1")); // Legacy ISBNs sort after real ones
+    CHECK(rejectedSaved("123456789012345678")); // Too long to pack
+    CHECK(rejectedSaved("ABCDEFGHIJK"));
+    CHECK(rejectedSaved("N/A"));
+    CHECK(rejectedSaved(""));
+
+    // ISBNs order and print as their 13 digits
+    CHECK(isbnOf("9780141439587") < isbnOf("9780441172719") && isbnOf("9780141439587") != isbnOf("9780441172719"));
+    ostringstream printed;
+    printed << isbnOf("9780141439587");
+    CHECK(printed.str() == "9780141439587");
+
+    string dir = makeTestDirectory();
+    string path = dir + "/library.txt";
+
+    // A file with legacy ISBNs loads, finds them, and saves them back unchanged
+    {
+        ofstream(path.c_str()) << dataFile("12345", "AB-12");
+    }
+    {
+        QuietOutput quiet;
+        Library library;
+        CHECK(library.loadFromFile(path));
+        CHECK(library.hasBook(savedIsbn("12345")) && library.hasBook(savedIsbn("AB-12")));
+        CHECK(library.saveToFile(dir + "/saved.txt"));
+    }
+    CHECK(readFile(dir + "/saved.txt") == dataFile("12345", "AB-12") + "0\n"); // Plus the journal position
+
+    // Two ISBN-10s that differ only in the check digit stay two books, and the unchecked one is
+    // saved back as it was
+    {
+        ofstream(path.c_str()) << dataFile("0441172717", "0441172710");
+    }
+    {
+        QuietOutput quiet;
+        Library library;
+        CHECK(library.loadFromFile(path));
+        CHECK(library.getBooks().size() == 2 && library.hasBook(isbnOf("9780441172719")));
+        CHECK(strcmp(library.findBook(savedIsbn("0441172710"))->getTitle(), "Emma") == 0);
+        CHECK(library.saveToFile(dir + "/saved.txt"));
+    }
+    CHECK(readFile(dir + "/saved.txt") == dataFile("9780441172719", "0441172710") + "0\n");
+
+    // Both forms of one ISBN would make one book hide the other, and an ISBN that cannot be read
+    // at all cannot be found: either book is reported and skipped, and the rest still loads
+    string reported[2];
+    const char* secondIsbns[2] = { "9780441172719", "N/A" };
+    for (int i = 0; i < 2; ++i) {
+        {
+            ofstream(path.c_str()) << dataFile("0441172717", secondIsbns[i]);
+        }
+        ostringstream errors;
+        Library library;
+        bool loaded;
+        {
+            QuietOutput quiet;
+            QuietOutput quietErrors(cerr);
+            cerr.rdbuf(errors.rdbuf());
+            loaded = library.loadFromFile(path);
+        }
+        reported[i] = errors.str();
+        CHECK(loaded && library.getBooks().size() == 1);
+        CHECK(strcmp(library.findBook(isbnOf("9780441172719"))->getTitle(), "Dune") == 0);
+    }
+    CHECK(reported[0] == path + ", line 12: ISBN 9780441172719 is also the ISBN of the book on line 4 (book skipped)\n");
+    CHECK(reported[1] == path + ", line 12: Invalid ISBN: N/A (book skipped)\n");
+
+    removeTestDirectory(dir);
+    return checkResult("IsbnTest");
+}
@@ -0,0 +1,180 @@
+/* Program name: JournalTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test journal recovery (torn and corrupt records, sequence numbers, skipping saved records)
+*/
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Check.h"
+#include "Journal.h"
+#include "Library.h"
+
+using namespace std;
+
+namespace {
+    off_t fileSize(const string &filename) {
+        struct stat info;
+        return stat(filename.c_str(), &info) == 0 ? info.st_size : -1;
+    }
+
+    void copyFile(const string &from, const string &to) {
+        ifstream in(from.c_str(), ios::binary);
+        ofstream out(to.c_str(), ios::binary | ios::trunc);
+        out << in.rdbuf();
+    }
+
+    void flipByte(const string &filename, off_t offset) {
+        fstream file(filename.c_str(), ios::in | ios::out | ios::binary);
+        file.seekg(offset);
+        char byte = static_cast<char>(file.get());
+        file.seekp(offset);
+        file.put(static_cast<char>(byte ^ 0x5A));
+    }
+
+    JournalEntry memberEntry(int id, const string &name) {
+        return JournalEntry(JOURNAL_DELETE_MEMBER).putInt(id).putString(name);
+    }
+
+    // Read back what memberEntry wrote
+    bool isMemberEntry(JournalEntry entry, int id, const string &name) {
+        return entry.getType() == JOURNAL_DELETE_MEMBER && entry.getInt() == id && entry.getString() == name;
+    }
+}
+
+int main() {
+    string dir = makeTestDirectory();
+    string path = dir + "/test.journal";
+
+    // Records come back in order, numbered from 1
+    {
+        Journal journal;
+        CHECK(journal.open(path).empty());
+        journal.append(memberEntry(1, "Alice"));
+        journal.append(memberEntry(2, "Bob"));
+        journal.append(memberEntry(-3, string("with\nnewline\0and NUL", 20)));
+        CHECK(journal.getLastSequence() == 3);
+    }
+    off_t threeRecords = fileSize(path);
+    {
+        Journal journal;
+        vector<JournalEntry> entries = journal.open(path);
+        CHECK(entries.size() == 3);
+        CHECK(isMemberEntry(entries[0], 1, "Alice"));
+        CHECK(isMemberEntry(entries[1], 2, "Bob"));
+        CHECK(isMemberEntry(entries[2], -3, string("with\nnewline\0and NUL", 20)));
+        CHECK(entries[0].getSequence() == 1 && entries[2].getSequence() == 3);
+        CHECK(journal.getLastSequence() == 3);
+        journal.append(memberEntry(4, "Dan"));
+    }
+
+    // A record torn by a crash (cut part way through) is dropped and cut off the file, and the
+    // next record is numbered after the last good one
+    CHECK(truncate(path.c_str(), fileSize(path) - 2) == 0);
+    {
+        Journal journal;
+        vector<JournalEntry> entries = journal.open(path);
+        CHECK(entries.size() == 3);
+        CHECK(fileSize(path) == threeRecords);
+        journal.append(memberEntry(5, "Eve"));
+        CHECK(journal.getLastSequence() == 4);
+    }
+    {
+        Journal journal;
+        vector<JournalEntry> entries = journal.open(path);
+        CHECK(entries.size() == 4);
+        CHECK(isMemberEntry(entries[3], 5, "Eve"));
+        CHECK(entries[3].getSequence() == 4);
+    }
+
+    // Only the frame header of a record made it: dropped too
+    CHECK(truncate(path.c_str(), threeRecords + 5) == 0);
+    {
+        Journal journal;
+        CHECK(journal.open(path).size() == 3);
+    }
+
+    // A corrupt record fails its checksum, and it and everything after it are dropped
+    flipByte(path, threeRecords - 3);
+    {
+        Journal journal;
+        vector<JournalEntry> entries = journal.open(path);
+        CHECK(entries.size() == 2);
+        CHECK(isMemberEntry(entries[1], 2, "Bob"));
+    }
+
+    // A file that is not a journal at all is started over
+    {
+        ofstream junk(path.c_str(), ios::trunc);
+        junk << "not a journal";
+    }
+    {
+        Journal journal;
+        CHECK(journal.open(path).empty());
+        journal.startAfter(100); // As if a saved file included records up to 100
+        journal.startAfter(50);  // Never goes back
+        journal.append(memberEntry(1, "Alice"));
+    }
+    {
+        Journal journal;
+        vector<JournalEntry> entries = journal.open(path);
+        CHECK(entries.size() == 1 && isMemberEntry(entries[0], 1, "Alice"));
+        CHECK(entries[0].getSequence() == 101);
+    }
+
+    // Changes made after the last save are replayed into the next library to open the journal,
+    // and a save empties it
+    string data = dir + "/library.txt";
+    string journalName = data + ".journal";
+    {
+        QuietOutput quiet;
+        TextPool text;
+        Library library;
+        library.openJournal(journalName);
+        library.addBook(makeBook(text, "Dune", "Frank Herbert", isbnOf("9780441172719")));
+        library.registerMember(makeMember(text, 1, "Alice"));
+        library.borrowBook(isbnOf("9780441172719"), 1);
+    }
+    {
+        QuietOutput quiet;
+        Library library;
+        library.openJournal(journalName);
+        CHECK(library.getBooks().size() == 1 && library.getMembers().size() == 1);
+        CHECK(library.getTransactions().size() == 1);
+        CHECK(library.findBook(isbnOf("9780441172719"))->getIsBorrowed());
+        copyFile(journalName, dir + "/saved.journal"); // The journal as it was before the save
+        CHECK(library.saveToFile(data));
+    }
+    CHECK(fileSize(journalName) < fileSize(dir + "/saved.journal"));
+
+    // A crash after a save replaced the data file but before it emptied the journal leaves
+    // records the file already holds; they are not replayed again
+    copyFile(dir + "/saved.journal", journalName);
+    {
+        QuietOutput quiet;
+        Library library;
+        CHECK(library.loadFromFile(data));
+        library.openJournal(journalName);
+        CHECK(library.getTransactions().size() == 1); // Not 2: the borrow was not replayed
+        CHECK(library.getBooks().size() == 1);
+
+        // Later changes are numbered after the saved ones, so they are replayed
+        library.returnBook(isbnOf("9780441172719"), 1);
+    }
+    {
+        QuietOutput quiet;
+        Library library;
+        CHECK(library.loadFromFile(data));
+        library.openJournal(journalName);
+        CHECK(library.getTransactions().size() == 2);
+        CHECK(!library.findBook(isbnOf("9780441172719"))->getIsBorrowed());
+    }
+
+    removeTestDirectory(dir);
+    return checkResult("JournalTest");
+}
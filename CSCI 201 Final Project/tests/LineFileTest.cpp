@@ -0,0 +1,173 @@
+/* Program name: LineFileTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test line splitting and that text data files (parsed a section per thread) load and
+* save back unchanged
+*/
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "Library.h"
+#include "LineFile.h"
+
+using namespace std;
+
+namespace {
+    void writeFile(const string &filename, const string &contents) {
+        ofstream out(filename.c_str(), ios::binary | ios::trunc);
+        out << contents;
+    }
+
+    string readFile(const string &filename) {
+        ifstream in(filename.c_str(), ios::binary);
+        ostringstream contents;
+        contents << in.rdbuf();
+        return contents.str();
+    }
+
+    // LineFile must find exactly the lines getline does
+    bool splitsLikeGetline(const string &filename, const string &contents) {
+        writeFile(filename, contents);
+        LineFile file(filename);
+        istringstream in(contents);
+        string expected;
+        size_t count = 0;
+        while (getline(in, expected)) {
+            if (count >= file.lineCount() || strcmp(file.line(count), expected.c_str()) != 0) {
+                return false;
+            }
+            ++count;
+        }
+        return count == file.lineCount();
+    }
+
+    // A data file as the original program wrote it: three books (one on loan), two members, a
+    // borrow, a return and the current loan, and one reservation
+    const char* BASELINE_FILE =
+        "3\n"
+        "Dune\nFrank Herbert\n9780441172719\n1965\nPS3558\nScience Fiction\n1\n2023-11-28\n"
+        "The Hobbit\nJ.R.R. Tolkien\n9780261103573\n1937\nPR6039\nFantasy\n0\nNone\n"
+        "Emma\nJane Austen\n9780141439587\n1815\nPR4034\nRomance\n0\nNone\n"
+        "2\n"
+        "Alice Smith\n1\n555-0100\nalice@example.com\n1 Main St\n"
+        "Bob Jones\n2\n555-0101\nbob@example.com\n2 Oak Ave\n"
+        "3\n"
+        "borrow\n9780261103573\n2\n1699000000\n2023-11-17\n"
+        "return\n9780261103573\n2\n1699500000\n"
+        "borrow\n9780441172719\n1\n1700000000\n2023-11-28\n"
+        "1\n"
+        "9780441172719\n2\n";
+}
+
+int main() {
+    string dir = makeTestDirectory();
+    string path = dir + "/lines.txt";
+
+    CHECK(splitsLikeGetline(path, ""));
+    CHECK(splitsLikeGetline(path, "one line, no newline"));
+    CHECK(splitsLikeGetline(path, "a\nb\n"));
+    CHECK(splitsLikeGetline(path, "a\nb"));
+    CHECK(splitsLikeGetline(path, "\n\n\nlast"));
+    CHECK(splitsLikeGetline(path, "carriage\r\nreturns\r\n")); // Kept, as getline keeps them
+
+    // Big enough to be split in chunks (across threads where there are several cores); lines
+    // that straddle a chunk boundary must come out whole
+    string big;
+    for (int i = 0; big.size() < (5u << 20); ++i) {
+        big += "line " + to_string(i) + string(i % 97, 'x') + "\n";
+        if (i % 1000 == 0) {
+            big += "\n";
+        }
+    }
+    CHECK(splitsLikeGetline(path, big));
+
+    {
+        LineFile file(path);
+        bool threw = false;
+        try {
+            file.line(file.lineCount());
+        } catch (const runtime_error&) {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+    bool threw = false;
+    try {
+        LineFile missing(dir + "/missing.txt");
+    } catch (const runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    // A data file written by the original program loads, and saves back byte for byte (whether
+    // or not members and history were left in the file until first used), plus the last journal
+    // record the save includes
+    string data = dir + "/library.txt";
+    writeFile(data, BASELINE_FILE);
+    for (int lazy = 0; lazy < 2; ++lazy) {
+        {
+            QuietOutput quiet;
+            Library library;
+            library.setLazyLoading(lazy == 1);
+            CHECK(library.loadFromFile(data));
+            CHECK(library.findBook(isbnOf("9780441172719"))->getIsBorrowed());
+            library.saveToFile(dir + "/saved.txt");
+            CHECK(library.getBooks().size() == 3 && library.getMembers().size() == 2);
+            CHECK(library.getTransactions().size() == 3 && library.getHolds().size() == 1);
+        }
+        CHECK(readFile(dir + "/saved.txt") == string(BASELINE_FILE) + "0\n");
+    }
+
+    // A large file (its sections parsed at the same time) round-trips too
+    ostringstream large;
+    large << "20000\n";
+    for (int i = 0; i < 20000; ++i) {
+        large << "Title " << i << "\nAuthor " << i % 300 << "\n" << 9780000000000LL + i << "\n" << 1900 + i % 120
+            << "\nQA" << i << "\nMystery\n0\nNone\n";
+    }
+    large << "5000\n";
+    for (int i = 0; i < 5000; ++i) {
+        large << "Member " << i << "\n" << i + 1 << "\n555-" << i << "\nm" << i << "@example.com\n" << i << " Elm St\n";
+    }
+    large << "10000\n";
+    for (int i = 0; i < 5000; ++i) {
+        large << "borrow\n" << 9780000000000LL + i << "\n" << i + 1 << "\n1700000000\n2023-11-28\n"
+            << "return\n" << 9780000000000LL + i << "\n" << i + 1 << "\n1700000100\n";
+    }
+    large << "0\n";
+    writeFile(data, large.str());
+    {
+        QuietOutput quiet;
+        Library library;
+        CHECK(library.loadFromFile(data));
+        CHECK(library.getBooks().size() == 20000 && library.getMembers().size() == 5000);
+        CHECK(library.getTransactionCount() == 10000); // Most of them archived
+        library.saveToFile(dir + "/saved.txt");
+    }
+    CHECK(readFile(dir + "/saved.txt") == large.str() + "0\n");
+
+    // A malformed file is rejected as a whole, and the error names the bad line
+    string malformed = BASELINE_FILE;
+    malformed.replace(malformed.find("Fantasy"), 7, "Poetry"); // Not a genre, on line 15
+    writeFile(data, malformed);
+    Library rejected;
+    bool loaded;
+    ostringstream errors;
+    {
+        QuietOutput quiet;
+        streambuf* original = cerr.rdbuf(errors.rdbuf());
+        loaded = rejected.loadFromFile(data);
+        cerr.rdbuf(original);
+    }
+    CHECK(!loaded && rejected.getBooks().empty() && rejected.getMembers().empty());
+    CHECK(errors.str().find("line 15: ") != string::npos);
+
+    removeTestDirectory(dir);
+    return checkResult("LineFileTest");
+}
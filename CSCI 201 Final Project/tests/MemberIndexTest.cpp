@@ -0,0 +1,80 @@
+/* Program name: MemberIndexTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/18/2026
+* Purpose: Test that members are found by ID and keep the order they registered in
+*/
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "Library.h"
+#include "TextPool.h"
+
+using namespace std;
+
+namespace {
+    // Member IDs in the order the library lists them
+    vector<int> memberOrder(const Library &library) {
+        vector<int> ids;
+        const vector<Member> &members = library.getMembers();
+        for (size_t i = 0; i < members.size(); ++i) {
+            ids.push_back(members[i].getMemberID());
+        }
+        return ids;
+    }
+
+    bool isOrder(const Library &library, const vector<int> &expected) {
+        if (memberOrder(library) != expected) {
+            return false;
+        }
+        for (size_t i = 0; i < expected.size(); ++i) {
+            const Member* member = library.findMember(expected[i]);
+            if (!member || member->getMemberID() != expected[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main() {
+    TextPool text;
+    Library library;
+    {
+        QuietOutput quiet;
+        library.registerMember(makeMember(text, 10, "Alice"));
+        library.registerMember(makeMember(text, 20, "Bob"));
+        library.registerMember(makeMember(text, 30, "Cy"));
+        library.registerMember(makeMember(text, 40, "Dee"));
+        library.registerMember(makeMember(text, 20, "Bob again")); // Refused: the ID is taken
+    }
+    CHECK(isOrder(library, vector<int>{ 10, 20, 30, 40 }));
+    CHECK(strcmp(library.findMember(20)->getName(), "Bob") == 0);
+    CHECK(library.findMember(50) == nullptr && !library.hasMember(50));
+
+    // Deleting from the middle or the front keeps everyone else in order, and still found by ID
+    {
+        QuietOutput quiet;
+        library.deleteMember(20);
+    }
+    CHECK(isOrder(library, vector<int>{ 10, 30, 40 }));
+    CHECK(!library.hasMember(20));
+    {
+        QuietOutput quiet;
+        library.deleteMember(10);
+        library.registerMember(makeMember(text, 20, "Bob"));
+    }
+    CHECK(isOrder(library, vector<int>{ 30, 40, 20 })); // Registering again joins the end
+
+    // Edits keep the member's place, and may change their ID
+    {
+        QuietOutput quiet;
+        library.editMember(40, makeMember(text, 45, "Dee Smith"));
+    }
+    CHECK(isOrder(library, vector<int>{ 30, 45, 20 }));
+    CHECK(!library.hasMember(40) && strcmp(library.findMember(45)->getName(), "Dee Smith") == 0);
+
+    return checkResult("MemberIndexTest");
+}
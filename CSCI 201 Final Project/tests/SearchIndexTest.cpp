@@ -0,0 +1,86 @@
+/* Program name: SearchIndexTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test word, prefix and typo-tolerant search through the search index
+*/
+
+#include <string>
+#include <vector>
+
+#include "BookStore.h"
+#include "Check.h"
+#include "SearchIndex.h"
+
+using namespace std;
+
+namespace {
+    bool found(const vector<SearchResult> &results, BookHandle book) {
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (results[i].book == book) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+int main() {
+    vector<string> words = SearchIndex::tokenize("J.R.R. Tolkien's  The-Hobbit");
+    CHECK(words.size() == 4 && words[0] == "jrr" && words[1] == "tolkiens" && words[2] == "the" && words[3] == "hobbit");
+    CHECK(SearchIndex::tokenize(" ,.! ").empty());
+
+    TextPool text;
+    BookStore books;
+    SearchIndex index;
+    BookHandle hobbit = books.insert(makeBook(text, "The Hobbit", "J.R.R. Tolkien", isbnOf("9780261103573")));
+    BookHandle rings = books.insert(makeBook(text, "The Fellowship of the Ring", "J.R.R. Tolkien", isbnOf("9780261103252")));
+    BookHandle dune = books.insert(makeBook(text, "Dune", "Frank Herbert", isbnOf("9780441172719")));
+    index.add(hobbit, *books.get(hobbit));
+    index.add(rings, *books.get(rings));
+    index.add(dune, *books.get(dune));
+
+    // Every query word must match, in any case, and a word may be a prefix
+    vector<SearchResult> results = index.search("tolkien", ALL_FIELDS, 10);
+    CHECK(results.size() == 2 && found(results, hobbit) && found(results, rings));
+    results = index.search("TOLKIEN hob", ALL_FIELDS, 10);
+    CHECK(results.size() == 1 && found(results, hobbit));
+    CHECK(index.search("tolkien dune", ALL_FIELDS, 10).empty());
+    CHECK(index.search("", ALL_FIELDS, 10).empty());
+    CHECK(index.search("tolkien", ALL_FIELDS, 1).size() == 1);
+
+    // Fields limit where words are looked for
+    CHECK(index.search("tolkien", TITLE_FIELD, 10).empty());
+    CHECK(index.search("dune", AUTHOR_FIELD, 10).empty());
+    CHECK(found(index.search("dune", TITLE_FIELD, 10), dune));
+
+    // An exact word outranks a prefix of a longer one
+    BookHandle hob = books.insert(makeBook(text, "Hob", "Anonymous", isbnOf("9780141439587")));
+    index.add(hob, *books.get(hob));
+    results = index.search("hob", TITLE_FIELD, 10);
+    CHECK(results.size() == 2 && results[0].book == hob && results[0].score > results[1].score);
+
+    // Typos are tolerated by the fuzzy search only
+    CHECK(index.search("tolkein", ALL_FIELDS, 10).empty());
+    results = index.fuzzySearch("tolkein", ALL_FIELDS, 10);
+    CHECK(results.size() == 2 && found(results, hobbit) && found(results, rings));
+    CHECK(found(index.fuzzySearch("herbet", AUTHOR_FIELD, 10), dune));
+    CHECK(index.fuzzySearch("zzzzzz", ALL_FIELDS, 10).empty());
+
+    // Completion offers the most common words first
+    vector<string> completions = index.complete("t", 10);
+    CHECK(!completions.empty() && (completions[0] == "the" || completions[0] == "tolkien"));
+    CHECK(index.complete("xyz", 10).empty());
+
+    // Removed books (and words nobody else has) stop matching
+    index.remove(hobbit, *books.get(hobbit));
+    results = index.search("tolkien", ALL_FIELDS, 10);
+    CHECK(results.size() == 1 && found(results, rings));
+    CHECK(index.search("hobbit", ALL_FIELDS, 10).empty());
+    results = index.fuzzySearch("hobit", ALL_FIELDS, 10);
+    CHECK(!found(results, hobbit) && found(results, hob)); // "hob" is still within two typos
+
+    index.clear();
+    CHECK(index.search("dune", ALL_FIELDS, 10).empty());
+
+    return checkResult("SearchIndexTest");
+}
@@ -0,0 +1,41 @@
+/* Program name: SearchQueryTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/18/2026
+* Purpose: Test the genre name and publication year range query parsers
+*/
+
+#include <string>
+
+#include "Check.h"
+#include "SearchQuery.h"
+
+using namespace std;
+
+namespace {
+    bool parsesRange(const string &query, int expectedFrom, int expectedTo) {
+        int fromYear = 0, toYear = 0;
+        return parseYearRange(query, fromYear, toYear) && fromYear == expectedFrom && toYear == expectedTo;
+    }
+}
+
+int main() {
+    // Genres are found by the exact name the genre menu shows
+    genreType genre = FICTION;
+    CHECK(parseGenreName("Fantasy", genre) && genre == FANTASY);
+    CHECK(parseGenreName("Science Fiction", genre) && genre == SCIENCE_FICTION);
+    CHECK(!parseGenreName("fantasy", genre) && !parseGenreName("", genre) && !parseGenreName("Cookbooks", genre));
+    CHECK(genre == SCIENCE_FICTION); // Left alone when nothing matches
+
+    // A year, or two years joined by a dash (spaces around either are allowed)
+    CHECK(parsesRange("1965", 1965, 1965));
+    CHECK(parsesRange("1960-1980", 1960, 1980));
+    CHECK(parsesRange(" 1960 - 1980 ", 1960, 1980));
+    int fromYear, toYear;
+    CHECK(!parseYearRange("", fromYear, toYear));
+    CHECK(!parseYearRange("nineteen", fromYear, toYear));
+    CHECK(!parseYearRange("1960-", fromYear, toYear));
+    CHECK(!parseYearRange("1960/1980", fromYear, toYear));
+    CHECK(!parseYearRange("1960-1980x", fromYear, toYear));
+
+    return checkResult("SearchQueryTest");
+}
@@ -0,0 +1,185 @@
+/* Program name: SnapshotTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test that a snapshot and the delta segments appended to it load back the saved library
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Check.h"
+#include "Library.h"
+#include "Snapshot.h"
+
+using namespace std;
+
+namespace {
+    off_t fileSize(const string &filename) {
+        struct stat info;
+        return stat(filename.c_str(), &info) == 0 ? info.st_size : -1;
+    }
+
+    // Everything a save should keep, in an order that does not depend on where books are stored
+    string describe(const Library &library) {
+        vector<string> lines;
+        library.forEachBook([&lines](const Book &book) {
+            ostringstream line;
+            line << "book " << book.getISBN() << " " << book.getTitle() << " " << book.getAuthor() << " " << book.getPubDate()
+                << " " << book.getCallNum() << " " << book.getGenre() << " " << book.getIsBorrowed() << " " << book.getDueDate();
+            lines.push_back(line.str());
+        });
+        library.forEachMember([&lines](const Member &member) {
+            ostringstream line;
+            line << "member " << member.getMemberID() << " " << member.getName() << " " << member.getEmail();
+            lines.push_back(line.str());
+        });
+        sort(lines.begin(), lines.end());
+
+        ostringstream out;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            out << lines[i] << "\n";
+        }
+        library.forEachTransaction([&out](const Transaction &transaction) { // History keeps its order
+            out << "transaction " << transaction.isBorrow() << " " << transaction.isbn << " " << transaction.memberID
+                << " " << transaction.transactionDate << " " << transaction.getDueDateText() << "\n";
+        });
+        const HoldTable &holds = library.getHolds();
+        vector<Isbn> held = holds.getHeldBooks();
+        for (size_t i = 0; i < held.size(); ++i) {
+            vector<int> queue = holds.getQueue(held[i]);
+            out << "holds " << held[i];
+            for (size_t j = 0; j < queue.size(); ++j) {
+                out << " " << queue[j];
+            }
+            out << "\n";
+        }
+        return out.str();
+    }
+
+    // Load the file fresh (both up front and lazily) and compare it with the library it came from
+    void checkLoadsAs(const string &filename, const Library &expected) {
+        for (int lazy = 0; lazy < 2; ++lazy) {
+            QuietOutput quiet;
+            Library loaded;
+            loaded.setLazyLoading(lazy == 1);
+            CHECK(loaded.loadFromFile(filename));
+            CHECK(describe(loaded) == describe(expected));
+        }
+    }
+}
+
+int main() {
+    string dir = makeTestDirectory();
+    string path = dir + "/library.snap";
+    const Isbn dune = isbnOf("9780441172719"), hobbit = isbnOf("9780261103573"), emma = isbnOf("9780141439587"),
+               carrie = isbnOf("9780307743664");
+
+    TextPool text;
+    Library library;
+    {
+        QuietOutput quiet;
+        library.addBook(makeBook(text, "Dune", "Frank Herbert", dune, 1965, FICTION));
+        library.addBook(makeBook(text, "The Hobbit", "J.R.R. Tolkien", hobbit, 1937, FANTASY));
+        library.addBook(makeBook(text, "Emma", "Jane Austen", emma, 1815, ROMANCE));
+        library.registerMember(makeMember(text, 1, "Alice"));
+        library.registerMember(makeMember(text, 2, "Bob"));
+        library.registerMember(makeMember(text, 3, "Cy"));
+        library.borrowBook(dune, 1);
+        library.reserveBook(dune, 2);
+        library.reserveBook(dune, 3);
+        CHECK(library.saveSnapshot(path)); // Full
+    }
+    CHECK(describe(library).find("holds 9780441172719 2 3") != string::npos);
+    off_t fullSize = fileSize(path);
+    CHECK(fullSize > 0);
+    checkLoadsAs(path, library);
+
+    // Nothing changed: nothing is appended
+    {
+        QuietOutput quiet;
+        CHECK(library.saveSnapshot(path));
+    }
+    CHECK(fileSize(path) == fullSize);
+    CHECK(MappedSnapshot(path).segmentCount() == 1);
+
+    // Changes since the save are appended as a delta segment, not a rewrite
+    {
+        QuietOutput quiet;
+        library.editBook(hobbit, makeBook(text, "The Hobbit, or There and Back Again", "J.R.R. Tolkien", hobbit, 1937, FANTASY));
+        library.deleteBook(emma);
+        library.addBook(makeBook(text, "Carrie", "Stephen King", carrie, 1974, HORROR));
+        library.returnBook(dune, 1);
+        library.cancelReservation(dune, 2); // Cy is now first in line
+        library.editMember(1, makeMember(text, 1, "Alice Smith"));
+        library.borrowBook(hobbit, 1);
+        CHECK(library.saveSnapshot(path));
+    }
+    CHECK(MappedSnapshot(path).segmentCount() == 2);
+    CHECK(fileSize(path) > fullSize && fileSize(path) - fullSize < fullSize); // Only the changed keys were appended
+    checkLoadsAs(path, library);
+
+    // A second delta on top of the first, including deletes of keys the first one wrote
+    {
+        QuietOutput quiet;
+        library.borrowBook(dune, 3); // Cy's turn: the hold is served
+        library.deleteBook(carrie);
+        library.deleteMember(2);
+        CHECK(library.saveSnapshot(path));
+    }
+    checkLoadsAs(path, library); // Appended, or compacted once the deltas grew past half the full segment
+
+    // Deleting the history is carried by a delta too
+    {
+        QuietOutput quiet;
+        library.deleteTransactionHistory();
+        library.returnBook(hobbit, 1);
+        CHECK(library.saveSnapshot(path));
+    }
+    checkLoadsAs(path, library);
+    CHECK(library.getTransactionCount() == 1);
+
+    // The library loaded from the deltas can carry on saving deltas of its own, and the text
+    // format round-trips the same library
+    {
+        QuietOutput quiet;
+        Library loaded;
+        CHECK(loaded.loadFromFile(path));
+        loaded.registerMember(makeMember(text, 4, "Dee"));
+        CHECK(loaded.saveSnapshot(path));
+        checkLoadsAs(path, loaded);
+        CHECK(loaded.saveToFile(dir + "/library.txt"));
+        checkLoadsAs(dir + "/library.txt", loaded);
+    }
+
+    // A file that is not a snapshot, has another format version, or is cut short, loads nothing
+    string otherVersion = dir + "/other.snap";
+    {
+        ifstream in(path.c_str(), ios::binary);
+        ofstream out(otherVersion.c_str(), ios::binary);
+        out << in.rdbuf();
+        uint32_t version = SNAPSHOT_VERSION + 1;
+        out.seekp(offsetof(SnapshotHeader, version));
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+    truncate(path.c_str(), 64);
+    Library notSnapshot, newer, truncated;
+    {
+        QuietOutput quiet;
+        QuietOutput quietErrors(cerr);
+        notSnapshot.loadSnapshot(dir + "/library.txt");
+        newer.loadSnapshot(otherVersion);
+        truncated.loadSnapshot(path);
+    }
+    CHECK(notSnapshot.getBooks().empty() && newer.getBooks().empty() && truncated.getBooks().empty());
+
+    removeTestDirectory(dir);
+    return checkResult("SnapshotTest");
+}
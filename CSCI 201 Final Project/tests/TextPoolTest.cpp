@@ -0,0 +1,96 @@
+/* Program name: TextPoolTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test the text pool's arena and interning, and that books share interned text
+*/
+
+#include <cstring>
+#include <string>
+
+#include <sys/mman.h>
+
+#include "Book.h"
+#include "Check.h"
+#include "Library.h"
+#include "TextPool.h"
+
+using namespace std;
+
+int main() {
+    TextPool pool;
+    CHECK(pool.bytesAllocated() == 0);
+
+    // Stored text is copied and NUL-terminated; every store is a new copy
+    string title = "The Hobbit";
+    const char* first = pool.store(title);
+    const char* second = pool.store(title);
+    title[0] = 'X';
+    CHECK(strcmp(first, "The Hobbit") == 0 && first != second);
+    CHECK(strcmp(pool.store(""), "") == 0);
+
+    // Interned text is shared by every copy of a value
+    const char* tolkien = pool.intern("J.R.R. Tolkien");
+    CHECK(pool.intern(string("J.R.R. ") + "Tolkien") == tolkien);
+    CHECK(pool.intern("Jane Austen") != tolkien);
+    CHECK(pool.internedCount() == 2);
+    CHECK(strcmp(tolkien, "J.R.R. Tolkien") == 0);
+
+    // Small strings share a block; text bigger than a block gets one of its own
+    size_t before = pool.bytesAllocated();
+    for (int i = 0; i < 1000; ++i) {
+        pool.store("short");
+    }
+    CHECK(pool.bytesAllocated() == before);
+    string big(200000, 'b');
+    const char* bigCopy = pool.store(big);
+    CHECK(pool.bytesAllocated() >= before + big.size() + 1 && bigCopy == big);
+    CHECK(strcmp(tolkien, "J.R.R. Tolkien") == 0); // Earlier text never moves
+    CHECK(pool.owns(tolkien) && pool.owns(bigCopy + big.size()));
+    CHECK(!pool.owns(big.c_str()) && !pool.owns("J.R.R. Tolkien"));
+
+    // Reset frees everything and forgets interned values
+    pool.reset();
+    CHECK(pool.bytesAllocated() == 0 && pool.internedCount() == 0);
+    CHECK(strcmp(pool.intern("Jane Austen"), "Jane Austen") == 0 && pool.internedCount() == 1);
+
+    // Text in an adopted mapping is used in place, and becomes the interned copy of its value
+    // unless the value was interned first
+    size_t length = 4096;
+    void* mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    CHECK(mapping != MAP_FAILED);
+    char* mapped = static_cast<char*>(mapping);
+    strcpy(mapped, "Frank Herbert");
+    strcpy(mapped + 32, "Jane Austen");
+    pool.adoptMapping(mapping, length);
+    CHECK(pool.bytesMapped() == length);
+    CHECK(pool.adopt(mapped) == mapped && pool.intern("Frank Herbert") == mapped);
+    CHECK(pool.adopt(mapped + 32) != mapped + 32); // Already interned above
+    CHECK(pool.owns(mapped + 32) && !pool.owns(mapped + length));
+    pool.reset();
+    CHECK(pool.bytesMapped() == 0); // Unmapped
+    CHECK(!pool.owns(tolkien));
+
+    // Books intern their authors in the pool they are built with, so copies of one author share a string
+    Book hobbit = makeBook(pool, "The Hobbit", "J.R.R. Tolkien", isbnOf("9780261103573"));
+    Book rings = makeBook(pool, "The Fellowship of the Ring", "J.R.R. Tolkien", isbnOf("9780261103252"));
+    CHECK(hobbit.getAuthor() == rings.getAuthor());
+    CHECK(pool.intern("J.R.R. Tolkien") == hobbit.getAuthor());
+    CHECK(strcmp(hobbit.getTitle(), "The Hobbit") == 0);
+
+    // Books and members a library makes keep their text when added, rather than copying it again
+    Library library;
+    Book dune = library.makeBook("Dune", "Frank Herbert", isbnOf("9780441172719"), 1965, "PS3558", FICTION);
+    Member alice = library.makeMember("Alice", 1, "555-0100", "alice@example.com", "1 Main St");
+    {
+        QuietOutput quiet;
+        library.addBook(dune);
+        library.registerMember(alice);
+        library.addBook(makeBook(pool, "Emma", "Jane Austen", isbnOf("9780141439587")));
+    }
+    CHECK(library.findBook(isbnOf("9780441172719"))->getTitle() == dune.getTitle());
+    CHECK(library.findMember(1)->getAddress() == alice.getAddress());
+    const Book* emma = library.findBook(isbnOf("9780141439587"));
+    CHECK(emma && !pool.owns(emma->getTitle()) && strcmp(emma->getTitle(), "Emma") == 0); // Copied from pool
+
+    return checkResult("TextPoolTest");
+}
@@ -0,0 +1,78 @@
+/* Program name: TransactionPoolTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/18/2026
+* Purpose: Test the transaction pool (order, dropping the oldest transactions, freeing blocks)
+*/
+
+#include <cstddef>
+
+#include "Check.h"
+#include "TransactionPool.h"
+
+using namespace std;
+
+namespace {
+    // Transaction i is made at time i by member i
+    Transaction numbered(int i) {
+        return i % 2 == 0 ? makeBorrow(isbnOf("9780441172719"), i, i) : makeReturn(isbnOf("9780441172719"), i, i);
+    }
+
+    // The pool holds transactions from..to - 1, in order, by index and by iterator
+    bool holdsRange(const TransactionPool &pool, int from, int to) {
+        if (pool.size() != static_cast<size_t>(to - from) || pool.empty() != (from == to)) {
+            return false;
+        }
+        int expected = from;
+        for (TransactionPool::const_iterator it = pool.begin(); it != pool.end(); ++it, ++expected) {
+            const Transaction &byIndex = pool[expected - from];
+            if (it->memberID != expected || byIndex.memberID != expected || it->isBorrow() != (expected % 2 == 0)) {
+                return false;
+            }
+        }
+        return expected == to;
+    }
+}
+
+int main() {
+    TransactionPool pool;
+    CHECK(holdsRange(pool, 0, 0) && pool.bytesAllocated() == 0);
+
+    // Blocks are added as they fill, and earlier transactions stay where they are
+    for (int i = 0; i < 3000; ++i) {
+        pool.push_back(numbered(i));
+    }
+    const Transaction* oldest = &pool[0];
+    for (int i = 3000; i < 5000; ++i) {
+        pool.push_back(numbered(i));
+    }
+    CHECK(holdsRange(pool, 0, 5000) && &pool[0] == oldest);
+    size_t fullSize = pool.bytesAllocated();
+    CHECK(fullSize >= 5000 * sizeof(Transaction));
+
+    // Dropping part of a block keeps it; dropping the rest of it frees it
+    pool.dropFront(10);
+    CHECK(holdsRange(pool, 10, 5000) && pool.bytesAllocated() == fullSize);
+    pool.dropFront(3000);
+    CHECK(holdsRange(pool, 3010, 5000) && pool.bytesAllocated() < fullSize);
+    pool.push_back(numbered(5000));
+    CHECK(holdsRange(pool, 3010, 5001));
+
+    // Copies are independent, swaps exchange everything
+    TransactionPool copy(pool), other;
+    other.push_back(numbered(7));
+    copy.dropFront(1);
+    CHECK(holdsRange(pool, 3010, 5001) && holdsRange(copy, 3011, 5001));
+    copy.swap(other);
+    CHECK(holdsRange(copy, 7, 8) && holdsRange(other, 3011, 5001));
+    other = copy;
+    CHECK(holdsRange(other, 7, 8));
+
+    // Dropping everything, or clearing, frees every block
+    pool.dropFront(pool.size() + 1);
+    CHECK(holdsRange(pool, 0, 0) && pool.bytesAllocated() == 0);
+    pool.push_back(numbered(4));
+    pool.clear();
+    CHECK(holdsRange(pool, 0, 0) && pool.bytesAllocated() == 0);
+
+    return checkResult("TransactionPoolTest");
+}
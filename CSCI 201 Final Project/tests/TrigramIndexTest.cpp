@@ -0,0 +1,104 @@
+/* Program name: TrigramIndexTest.cpp
+* Author: Joshua Yin
+* Date last updated: 10/17/2026
+* Purpose: Test the bounded edit distance and typo-tolerant word lookups of the trigram index
+*/
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Check.h"
+#include "TrigramIndex.h"
+
+using namespace std;
+
+namespace {
+    // Plain dynamic programming edit distance to compare the fast one against
+    int editDistance(const string &a, const string &b) {
+        vector<int> previous(b.size() + 1), current(b.size() + 1);
+        for (size_t j = 0; j <= b.size(); ++j) {
+            previous[j] = static_cast<int>(j);
+        }
+        for (size_t i = 1; i <= a.size(); ++i) {
+            current[0] = static_cast<int>(i);
+            for (size_t j = 1; j <= b.size(); ++j) {
+                int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+                current[j] = min(previous[j - 1] + cost, min(previous[j] + 1, current[j - 1] + 1));
+            }
+            previous.swap(current);
+        }
+        return previous[b.size()];
+    }
+
+    // The bounded distance is exact up to the bound and bound + 1 past it
+    bool boundedMatches(const string &a, const string &b, int bound) {
+        int exact = editDistance(a, b);
+        return TrigramIndex::boundedEditDistance(a, b, bound) == (exact <= bound ? exact : bound + 1);
+    }
+
+    bool hasWord(const vector<pair<string, int> > &matches, const string &word, int distance) {
+        for (size_t i = 0; i < matches.size(); ++i) {
+            if (matches[i].first == word) {
+                return matches[i].second == distance;
+            }
+        }
+        return false;
+    }
+}
+
+int main() {
+    CHECK(TrigramIndex::maxTypos(2) == 0 && TrigramIndex::maxTypos(4) == 1 && TrigramIndex::maxTypos(5) == 2);
+
+    CHECK(TrigramIndex::boundedEditDistance("kitten", "sitting", 3) == 3);
+    CHECK(TrigramIndex::boundedEditDistance("kitten", "sitting", 2) == 3); // Gives up past the bound
+    CHECK(TrigramIndex::boundedEditDistance("", "abc", 5) == 3);
+    CHECK(TrigramIndex::boundedEditDistance("same", "same", 0) == 0);
+    const char* pairs[][2] = {
+        { "tolkien", "tolkein" }, { "herbert", "herbet" }, { "austen", "austin" }, { "a", "b" },
+        { "abcdef", "fedcba" }, { "hobbit", "habit" }, { "x", "xxxxxxxx" }
+    };
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); ++i) {
+        for (int bound = 0; bound <= 4; ++bound) {
+            CHECK(boundedMatches(pairs[i][0], pairs[i][1], bound));
+        }
+    }
+    // Words longer than one machine word take the banded path
+    string longWord(70, 'a'), longTypo = longWord;
+    longTypo[10] = 'b';
+    longTypo.erase(40, 1);
+    CHECK(boundedMatches(longWord, longTypo, 2));
+    CHECK(boundedMatches(longWord, longTypo, 1));
+    CHECK(boundedMatches(longWord + "ccc", longWord, 2));
+
+    TrigramIndex index;
+    const char* words[] = { "tolkien", "tolkiens", "token", "herbert", "herbst", "austen" };
+    for (size_t i = 0; i < sizeof(words) / sizeof(words[0]); ++i) {
+        index.add(words[i]);
+    }
+    index.add("tolkien"); // Adding a word twice changes nothing
+
+    // Closest words first (ties in word order), within the distance asked for
+    vector<pair<string, int> > matches = index.similarWords("tolkein", 2, 10);
+    CHECK(matches.size() == 2 && matches[0].first == "token" && hasWord(matches, "tolkien", 2)); // "tolkiens" is 3 away
+    matches = index.similarWords("tolkien", 2, 10);
+    CHECK(!matches.empty() && matches[0] == make_pair(string("tolkien"), 0) && hasWord(matches, "tolkiens", 1));
+    CHECK(index.similarWords("tolkien", 2, 1).size() == 1);
+    matches = index.similarWords("herbet", 2, 10);
+    CHECK(matches.size() == 2 && matches[0].first == "herbert" && hasWord(matches, "herbst", 1));
+    CHECK(index.similarWords("herbet", 0, 10).empty());
+    CHECK(index.similarWords("zzzzzz", 2, 10).empty());
+
+    // Removed words are not found, and their IDs are reused
+    index.remove("tolkien");
+    index.remove("tolkien");
+    CHECK(!hasWord(index.similarWords("tolkien", 2, 10), "tolkien", 0));
+    index.add("tolkein");
+    CHECK(hasWord(index.similarWords("tolkien", 2, 10), "tolkein", 2));
+
+    index.clear();
+    CHECK(index.similarWords("austen", 2, 10).empty());
+
+    return checkResult("TrigramIndexTest");
+}